@@ -16,6 +16,9 @@ if ("${CMAKE_CONFIGURATION_TYPES}" MATCHES "Debug")
         ${wxWidgets_LIB_DIR}/zlibd.lib
         comctl32
         rpcrt4)
+    set (wxWidgets_BASE_LIBRARIES
+        ${wxWidgets_LIB_DIR}/wxbase31ud.lib
+        rpcrt4)
 
 elseif ("${CMAKE_CONFIGURATION_TYPES}" MATCHES "Release")
     message (STATUS "Setting configuration type for ${CMAKE_CONFIGURATION_TYPES}")
@@ -28,6 +31,9 @@ elseif ("${CMAKE_CONFIGURATION_TYPES}" MATCHES "Release")
         ${wxWidgets_LIB_DIR}/zlib.lib
         comctl32
         rpcrt4)
+    set (wxWidgets_BASE_LIBRARIES
+        ${wxWidgets_LIB_DIR}/wxbase31u.lib
+        rpcrt4)
 
 elseif ("${CMAKE_CONFIGURATION_TYPES}" MATCHES "RelWithDebInfo")
     message (STATUS "Setting configuration type for ${CMAKE_CONFIGURATION_TYPES}")
@@ -40,5 +46,8 @@ elseif ("${CMAKE_CONFIGURATION_TYPES}" MATCHES "RelWithDebInfo")
         ${wxWidgets_LIB_DIR}/zlib.lib
         comctl32
         rpcrt4)
+    set (wxWidgets_BASE_LIBRARIES
+        ${wxWidgets_LIB_DIR}/wxbase31u.lib
+        rpcrt4)
 
 endif()
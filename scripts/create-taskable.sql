@@ -1,3 +1,9 @@
+-- has to be set before the first table is created, see DatabaseMaintenance
+PRAGMA auto_vacuum = INCREMENTAL;
+
+-- raised by the application whenever the schema changes, see constants::SchemaVersion
+PRAGMA user_version = 1;
+
 CREATE TABLE employers
 (
     employer_id INTEGER PRIMARY KEY NOT NULL,
@@ -21,62 +21,102 @@
 
 #include <algorithm>
 
+#include <wx/filename.h>
 #include <wx/stdpaths.h>
 #include <wx/msw/registry.h>
 
 #include "common/common.h"
 #include "common/constants.h"
-#include "database/sqliteconnectionfactory.h"
+#include "common/logging.h"
+#include "common/startupprofiler.h"
 #include "database/sqliteconnection.h"
 #include "database/connectionprovider.h"
+#include "database/querystatistics.h"
 #include "frame/mainframe.h"
+#include "services/searchindex.h"
 #include "services/setupdatabase.h"
+#include "services/databasearchive.h"
 #include "services/databasebackup.h"
 #include "wizards/setupwizard.h"
 #include "wizards/databaserestorewizard.h"
 
 namespace app
 {
+static const std::size_t LogQueueSize = 8192;
+static const wxString StartupTraceSwitch = wxT("startup-trace");
+
 Application::Application()
     : pInstanceChecker(std::make_unique<wxSingleInstanceChecker>())
     , pConfig(nullptr)
+    , bStartupTrace(false)
 {
+    /* startup phases are measured from here */
+    common::StartupProfiler::Get();
 }
 
 bool Application::OnInit()
 {
-#ifndef TASKABLE_DEBUG
-    bool isInstanceAlreadyRunning = pInstanceChecker->IsAnotherRunning();
-    if (isInstanceAlreadyRunning) {
-        wxMessageBox(wxT("Another instance of the application is already running."),
-            common::GetProgramName(),
-            wxOK_DEFAULT | wxICON_WARNING);
+    if (!wxApp::OnInit()) {
         return false;
     }
+
+#ifndef TASKABLE_DEBUG
+    {
+        common::StartupProfiler::Phase phase("Instance check");
+        bool isInstanceAlreadyRunning = pInstanceChecker->IsAnotherRunning();
+        if (isInstanceAlreadyRunning) {
+            wxMessageBox(wxT("Another instance of the application is already running."),
+                common::GetProgramName(),
+                wxOK_DEFAULT | wxICON_WARNING);
+            return false;
+        }
+    }
 #endif // TASKABLE_DEBUG
 
-    if (!InitializeLogging()) {
-        return false;
+    {
+        common::StartupProfiler::Phase phase("Initialize logging");
+        if (!InitializeLogging()) {
+            return false;
+        }
     }
 
-    if (!ConfigurationFileExists()) {
-        return false;
+    if (bStartupTrace) {
+        common::StartupProfiler::Get().SetTraceFilePath(
+            wxFileName(common::GetLogsDirectory(), wxT("startup-trace.json")).GetFullPath());
+    }
+
+    {
+        common::StartupProfiler::Phase phase("Load configuration");
+        if (!ConfigurationFileExists()) {
+            return false;
+        }
     }
 
     if (IsSetup()) {
+        common::StartupProfiler::Phase phase("Startup initialization");
         if (!StartupInitialization()) {
             return false;
         }
     } else {
+        common::StartupProfiler::Phase phase("First startup initialization");
         if (!FirstStartupInitialization()) {
             return false;
         }
     }
 
-    auto frame = new frm::MainFrame(pConfig, pLogger);
-    frame->CreateFrame();
-    frame->Show(true);
-    SetTopWindow(frame);
+    /* the remaining phases are recorded by the frame once it has been painted */
+    frm::MainFrame* frame = nullptr;
+    {
+        common::StartupProfiler::Phase phase("Create main frame");
+        frame = new frm::MainFrame(pConfig, pLogger);
+        frame->CreateFrame();
+    }
+
+    {
+        common::StartupProfiler::Phase phase("Show main frame");
+        frame->Show(true);
+        SetTopWindow(frame);
+    }
 
     return true;
 }
@@ -89,7 +129,10 @@ bool Application::FirstStartupInitialization()
 
     InitializeDatabaseConnectionProvider();
 
+    /* the tables are rolled back on failure, the empty file is removed so the next start sets up afresh */
     if (!InitializeDatabaseTables()) {
+        db::ConnectionProvider::Get().PurgeConnectionPool();
+        DeleteDatabaseFile();
         return false;
     }
 
@@ -114,6 +157,9 @@ bool Application::StartupInitialization()
         InitializeDatabaseConnectionProvider();
     }
 
+    /* databases created before the search index existed get it on their first startup */
+    InitializeSearchIndex();
+
     return true;
 }
 
@@ -123,24 +169,30 @@ bool Application::InitializeLogging()
         return false;
     }
 
-    auto logDirectory =
-        wxString::Format(wxT("%s\\logs\\%s"), wxStandardPaths::Get().GetUserDataDir(), constants::LogsFilename)
-            .ToStdString();
+    auto logDirectory = wxFileName(common::GetLogsDirectory(), constants::LogsFilename).GetFullPath().ToStdString();
 
     try {
-        auto msvcSink = std::make_shared<spdlog::sinks::msvc_sink_st>();
-
-        auto msvcLogger = std::make_shared<spdlog::logger>("msvc", msvcSink);
-        msvcLogger->set_level(spdlog::level::debug);
-        spdlog::register_logger(msvcLogger);
-
-        auto dialySink = std::make_shared<spdlog::sinks::daily_file_sink_st>(logDirectory, 23, 59);
-        dialySink->set_level(spdlog::level::err);
-
-        auto combinedLoggers = std::make_shared<spdlog::sinks::dist_sink_st>();
-        combinedLoggers->add_sink(msvcSink);
-        combinedLoggers->add_sink(dialySink);
-        pLogger = std::make_shared<spdlog::logger>(constants::LoggerName, combinedLoggers);
+        /* each logger has its own queue and background thread. The trace logger drops its oldest messages
+           when its queue is full, which cannot reach the queue of the application logger, and the
+           application logger waits so errors are never lost */
+        spdlog::init_thread_pool(LogQueueSize, 1);
+        pTraceThreadPool = std::make_shared<spdlog::details::thread_pool>(LogQueueSize, 1);
+
+        auto debugOutputSink = common::CreateDebugOutputSink();
+
+        auto traceLogger = std::make_shared<spdlog::async_logger>(
+            "trace", debugOutputSink, pTraceThreadPool, spdlog::async_overflow_policy::overrun_oldest);
+        traceLogger->set_level(spdlog::level::debug);
+        common::SetTraceLogger(traceLogger);
+
+        auto dailySink = std::make_shared<spdlog::sinks::daily_file_sink_mt>(logDirectory, 23, 59);
+        dailySink->set_level(spdlog::level::err);
+
+        spdlog::sinks_init_list sinks = { debugOutputSink, dailySink };
+        pLogger = std::make_shared<spdlog::async_logger>(constants::LoggerName,
+            sinks,
+            spdlog::thread_pool(),
+            spdlog::async_overflow_policy::block);
     } catch (const spdlog::spdlog_ex& e) {
         wxMessageBox(wxString::Format(wxT("Error initializing logger: %s"), e.what()),
             common::GetProgramName(),
@@ -154,9 +206,37 @@ bool Application::InitializeLogging()
     return true;
 }
 
+int Application::OnExit()
+{
+    /* the frame has logged its exit backup by now, drain the queues before the thread pools go away */
+    common::SetTraceLogger(nullptr);
+    pTraceThreadPool.reset();
+    if (pLogger) {
+        pLogger->flush();
+        pLogger.reset();
+    }
+    spdlog::shutdown();
+
+    return wxApp::OnExit();
+}
+
+void Application::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    wxApp::OnInitCmdLine(parser);
+
+    parser.AddLongSwitch(StartupTraceSwitch, wxT("write the startup phases to logs\\startup-trace.json"));
+}
+
+bool Application::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    bStartupTrace = parser.FoundSwitch(StartupTraceSwitch) == wxCMD_SWITCH_ON;
+
+    return wxApp::OnCmdLineParsed(parser);
+}
+
 bool Application::CreateLogsDirectory()
 {
-    wxString logs = wxString::Format(wxT("%s\\logs"), wxStandardPaths::Get().GetUserDataDir());
+    wxString logs = common::GetLogsDirectory();
     bool logDirectoryExists = wxDirExists(logs);
     if (!logDirectoryExists) {
         bool success = wxMkDir(logs);
@@ -168,12 +248,22 @@ bool Application::CreateLogsDirectory()
 
 bool Application::InitializeDatabaseConnectionProvider()
 {
-    static int ConnectionPoolSize = 14;
+    /* debug builds always record statement statistics, release builds only when asked to in the settings */
+#ifdef TASKABLE_DEBUG
+    db::QueryStatistics::Get().SetEnabled(true);
+#else
+    db::QueryStatistics::Get().SetEnabled(pConfig->IsQueryStatisticsEnabled());
+#endif // TASKABLE_DEBUG
 
-    auto sqliteConnectionFactory = std::make_shared<db::SqliteConnectionFactory>(
-        common::GetDatabaseFilePath(pConfig->GetDatabasePath()).ToStdString());
-    auto connectionPool =
-        std::make_unique<db::ConnectionPool<db::SqliteConnection>>(sqliteConnectionFactory, ConnectionPoolSize);
+    /* without the archive the connections run on the live database alone */
+    std::string archiveFilePath;
+    if (svc::DatabaseArchive::CreateArchiveDatabase(pConfig, pLogger)) {
+        archiveFilePath = common::GetArchiveDatabaseFilePath(pConfig->GetDatabasePath()).ToStdString();
+    }
+
+    /* the rest of the pool is opened by the main frame after it has been painted */
+    auto connectionPool = db::ConnectionProvider::CreateConnectionPool(
+        common::GetDatabaseFilePath(pConfig->GetDatabasePath()).ToStdString(), archiveFilePath);
     db::ConnectionProvider::Get().InitializeConnectionPool(std::move(connectionPool));
 
     return true;
@@ -238,6 +328,9 @@ bool Application::ConfigurationFileExists()
     }
 
     pConfig = std::make_shared<cfg::Configuration>();
+    for (const auto& setting : pConfig->GetInvalidSettings()) {
+        pLogger->warn("Setting \"{0}\" is out of range, its default is used instead", setting.ToStdString());
+    }
 
     if (pConfig->GetDatabasePath().empty()) {
         pConfig->SetDatabasePath(wxStandardPaths::Get().GetAppDocumentsDir());
@@ -253,7 +346,7 @@ bool Application::CreateBackupsDirectory()
     if (IsSetup() && !pConfig->GetBackupPath().empty()) {
         backupsDirectory = pConfig->GetBackupPath();
     } else {
-        backupsDirectory = wxString::Format(wxT("%s\\backups"), wxStandardPaths::Get().GetUserDataDir());
+        backupsDirectory = wxFileName(wxStandardPaths::Get().GetUserDataDir(), wxT("backups")).GetFullPath();
     }
 
     if (!wxDirExists(backupsDirectory)) {
@@ -346,7 +439,13 @@ bool Application::DatabaseFileExists()
 bool Application::InitializeDatabaseTables()
 {
     svc::SetupTables tables(pLogger);
-    return tables.CreateTables();
+    return tables.CreateTables() && InitializeSearchIndex();
+}
+
+bool Application::InitializeSearchIndex()
+{
+    svc::SearchIndex searchIndex(pLogger);
+    return searchIndex.Initialize();
 }
 } // namespace app
 
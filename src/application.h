@@ -22,12 +22,12 @@
 #include <memory>
 
 #include <wx/wx.h>
+#include <wx/cmdline.h>
 #include <wx/snglinst.h>
 
 #include <spdlog/spdlog.h>
-#include <spdlog/sinks/dist_sink.h>
+#include <spdlog/async.h>
 #include <spdlog/sinks/daily_file_sink.h>
-#include <spdlog/sinks/msvc_sink.h>
 
 #include "config/configuration.h"
 
@@ -40,6 +40,10 @@ class Application : public wxApp
     virtual ~Application() = default;
 
     bool OnInit() override;
+    int OnExit() override;
+
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
 
 private:
     bool FirstStartupInitialization();
@@ -62,9 +66,13 @@ class Application : public wxApp
     bool DatabaseFileExists();
 
     bool InitializeDatabaseTables();
+    bool InitializeSearchIndex();
 
     std::shared_ptr<cfg::Configuration> pConfig;
     std::shared_ptr<spdlog::logger> pLogger;
+    /* async loggers only hold a weak reference to their thread pool */
+    std::shared_ptr<spdlog::details::thread_pool> pTraceThreadPool;
     std::unique_ptr<wxSingleInstanceChecker> pInstanceChecker;
+    bool bStartupTrace;
 };
 } // namespace app
@@ -0,0 +1,245 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "benchmarkdatabase.h"
+
+#include <algorithm>
+
+#include <wx/dir.h>
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+#include "../common/common.h"
+#include "../database/connectionpool.h"
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+#include "../database/sqliteconnectionfactory.h"
+#include "../services/searchindex.h"
+#include "../services/setupdatabase.h"
+
+namespace app::bench
+{
+BenchmarkDatabaseOptions::BenchmarkDatabaseOptions()
+    : mDays(365)
+    , mItemsPerDay(12)
+    , mProjects(8)
+    , mCategories(24)
+{
+}
+
+BenchmarkDatabase::BenchmarkDatabase(const BenchmarkDatabaseOptions& options, std::shared_ptr<spdlog::logger> logger)
+    : mOptions(options)
+    , pLogger(logger)
+    , pConfig(nullptr)
+    , mDirectory(wxGetEmptyString())
+    , mFirstDate(6, wxDateTime::Jan, 2020)
+    , mProjectIds()
+{
+}
+
+BenchmarkDatabase::~BenchmarkDatabase()
+{
+    db::ConnectionProvider::Get().PurgeConnectionPool();
+    pConfig.reset();
+
+    if (!mDirectory.empty() && wxDirExists(mDirectory)) {
+        wxFileName::Rmdir(mDirectory, wxPATH_RMDIR_RECURSIVE);
+    }
+}
+
+bool BenchmarkDatabase::Create()
+{
+    return CreateDirectories() && CreateConfiguration() && CreateConnectionPool() && Generate();
+}
+
+const BenchmarkDatabaseOptions& BenchmarkDatabase::GetOptions() const
+{
+    return mOptions;
+}
+
+std::shared_ptr<cfg::Configuration> BenchmarkDatabase::GetConfiguration() const
+{
+    return pConfig;
+}
+
+wxString BenchmarkDatabase::GetDatabaseFilePath() const
+{
+    return wxFileName(mDirectory, common::GetDatabaseFileName()).GetFullPath();
+}
+
+wxString BenchmarkDatabase::GetDate(int day) const
+{
+    return (mFirstDate + wxDateSpan::Days(day % mOptions.mDays)).FormatISODate();
+}
+
+wxString BenchmarkDatabase::GetWeekStartDate(int week) const
+{
+    return (mFirstDate + wxDateSpan::Weeks(week % GetWeekCount())).FormatISODate();
+}
+
+wxString BenchmarkDatabase::GetWeekEndDate(int week) const
+{
+    return (mFirstDate + wxDateSpan::Weeks(week % GetWeekCount()) + wxDateSpan::Days(6)).FormatISODate();
+}
+
+int BenchmarkDatabase::GetWeekCount() const
+{
+    return std::max(1, mOptions.mDays / 7);
+}
+
+int BenchmarkDatabase::GetProjectId(int project) const
+{
+    return mProjectIds[project % mProjectIds.size()];
+}
+
+bool BenchmarkDatabase::CreateDirectories()
+{
+    mDirectory = wxFileName(wxFileName::GetTempDir(), wxString::Format(wxT("taskable-bench-%lu"), wxGetProcessId()))
+                     .GetFullPath();
+
+    if (wxDirExists(mDirectory)) {
+        wxFileName::Rmdir(mDirectory, wxPATH_RMDIR_RECURSIVE);
+    }
+
+    auto backupDirectory = wxFileName(mDirectory, wxT("backups")).GetFullPath();
+    if (!wxFileName::Mkdir(backupDirectory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL)) {
+        pLogger->error("Unable to create benchmark directory {0}", backupDirectory.ToStdString());
+        return false;
+    }
+    return true;
+}
+
+bool BenchmarkDatabase::CreateConfiguration()
+{
+    pConfig = std::make_shared<cfg::Configuration>(wxFileName(mDirectory, common::GetConfigFileName()).GetFullPath());
+
+    pConfig->SetDatabasePath(mDirectory);
+    pConfig->SetBackupEnabled(true);
+    pConfig->SetBackupPath(wxFileName(mDirectory, wxT("backups")).GetFullPath());
+    pConfig->SetKeepDailyBackups(7);
+    pConfig->SetKeepWeeklyBackups(4);
+    pConfig->SetKeepMonthlyBackups(12);
+    pConfig->SetBackupSizeLimit(0);
+    pConfig->SetBackupCompression(false);
+    pConfig->SetDifferentialBackup(false);
+    pConfig->SetFullBackupInterval(7);
+    pConfig->Save();
+
+    return true;
+}
+
+bool BenchmarkDatabase::CreateConnectionPool()
+{
+    auto databaseFilePath = GetDatabaseFilePath();
+
+    wxFile file;
+    if (!file.Create(databaseFilePath, true)) {
+        pLogger->error("Unable to create benchmark database {0}", databaseFilePath.ToStdString());
+        return false;
+    }
+    file.Close();
+
+    try {
+        auto sqliteConnectionFactory =
+            std::make_shared<db::SqliteConnectionFactory>(databaseFilePath.ToStdString(), std::string());
+        auto connectionPool = std::make_unique<db::ConnectionPool<db::SqliteConnection>>(
+            sqliteConnectionFactory, BenchmarkDatabase::PoolSize);
+        db::ConnectionProvider::Get().InitializeConnectionPool(std::move(connectionPool));
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when opening benchmark database - {0:d} : {1}", e.get_code(), e.what());
+        return false;
+    }
+
+    svc::SetupTables setupTables(pLogger);
+    svc::SearchIndex searchIndex(pLogger);
+    return setupTables.CreateTables() && searchIndex.Initialize();
+}
+
+bool BenchmarkDatabase::Generate()
+{
+    auto connection = db::ConnectionProvider::Get().Handle()->Acquire();
+    auto database = connection->DatabaseExecutableHandle();
+    bool success = true;
+
+    try {
+        *database << BenchmarkDatabase::beginTransaction;
+        *database << BenchmarkDatabase::createEmployer;
+        *database << BenchmarkDatabase::createProject << mOptions.mProjects << 1;
+        *database << BenchmarkDatabase::createCategory << mOptions.mCategories << mOptions.mProjects;
+        *database << BenchmarkDatabase::createTask << mOptions.mDays << mFirstDate.FormatISODate().ToStdString();
+        *database << BenchmarkDatabase::createTaskItem << mOptions.mDays << mOptions.mItemsPerDay
+                  << mOptions.mCategories << mFirstDate.FormatISODate().ToStdString();
+        *database << BenchmarkDatabase::commitTransaction;
+
+        *database << "SELECT project_id FROM projects ORDER BY project_id" >>
+            [&](int projectId) { mProjectIds.push_back(projectId); };
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when generating benchmark data - {0:d} : {1}", e.get_code(), e.what());
+        success = false;
+    }
+
+    db::ConnectionProvider::Get().Handle()->Release(connection);
+    return success && !mProjectIds.empty();
+}
+
+const std::string BenchmarkDatabase::beginTransaction = "BEGIN TRANSACTION";
+
+const std::string BenchmarkDatabase::commitTransaction = "COMMIT";
+
+const std::string BenchmarkDatabase::createEmployer = "INSERT INTO employers (name, is_active) "
+                                                      "VALUES ('Benchmark Employer', 1)";
+
+/* rows are generated on a freshly created database, so the generated ids start at 1 */
+const std::string BenchmarkDatabase::createProject =
+    "WITH RECURSIVE generated(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM generated WHERE n < ?1) "
+    "INSERT INTO projects (name, display_name, billable, is_default, is_active, employer_id) "
+    "SELECT 'Project ' || n, 'Project ' || n, 0, 0, 1, ?2 FROM generated";
+
+const std::string BenchmarkDatabase::createCategory =
+    "WITH RECURSIVE generated(n) AS (SELECT 1 UNION ALL SELECT n + 1 FROM generated WHERE n < ?1) "
+    "INSERT INTO categories (name, color, is_active, project_id) "
+    "SELECT 'Category ' || n, (n * 2654435761) % 16777216, 1, ((n - 1) % ?2) + 1 FROM generated";
+
+const std::string BenchmarkDatabase::createTask =
+    "WITH RECURSIVE generated(n) AS (SELECT 0 UNION ALL SELECT n + 1 FROM generated WHERE n + 1 < ?1) "
+    "INSERT INTO tasks (task_date, is_active) "
+    "SELECT date(?2, '+' || n || ' days'), 1 FROM generated";
+
+/* the spread of durations, descriptions and categories is derived from the day and item number
+   so every run with the same options generates the same data */
+const std::string BenchmarkDatabase::createTaskItem =
+    "WITH RECURSIVE days(d) AS (SELECT 0 UNION ALL SELECT d + 1 FROM days WHERE d + 1 < ?1), "
+    "items(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM items WHERE i + 1 < ?2), "
+    "generated AS (SELECT d, i, ((d * 31 + i * 17) % ?3) + 1 AS c FROM days CROSS JOIN items) "
+    "INSERT INTO task_items "
+    "(start_time, end_time, duration, description, billable, is_active, "
+    "task_item_type_id, project_id, task_id, category_id) "
+    "SELECT NULL, NULL, "
+    "printf('%02d:%02d:00', (d + i) % 3, 5 + (d * 7 + i * 11) % 55), "
+    "CASE (d + i) % 4 "
+    "WHEN 0 THEN 'Code review of' WHEN 1 THEN 'Meeting about' "
+    "WHEN 2 THEN 'Bug fixing in' ELSE 'Documentation for' END "
+    "|| ' module ' || ((d * 3 + i) % 25), "
+    "0, 1, 2, categories.project_id, tasks.task_id, categories.category_id "
+    "FROM generated "
+    "INNER JOIN categories ON categories.category_id = generated.c "
+    "INNER JOIN tasks ON tasks.task_date = date(?4, '+' || generated.d || ' days')";
+} // namespace app::bench
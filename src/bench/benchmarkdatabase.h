@@ -0,0 +1,94 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <wx/datetime.h>
+#include <wx/string.h>
+
+#include "../config/configuration.h"
+
+namespace app::bench
+{
+struct BenchmarkDatabaseOptions {
+    BenchmarkDatabaseOptions();
+
+    int mDays;
+    int mItemsPerDay;
+    int mProjects;
+    int mCategories;
+};
+
+/*
+ Synthetic database for the benchmarks. The schema and reference data come from the same scripts
+ the application is set up with (create-taskable.sql and seed-taskable.sql next to the executable),
+ then the requested number of days, task items, projects and categories are generated from a fixed seed.
+ The database, its backups and the configuration live in a temporary directory that is removed again
+ */
+class BenchmarkDatabase final
+{
+public:
+    BenchmarkDatabase() = delete;
+    BenchmarkDatabase(const BenchmarkDatabaseOptions& options, std::shared_ptr<spdlog::logger> logger);
+    ~BenchmarkDatabase();
+
+    bool Create();
+
+    const BenchmarkDatabaseOptions& GetOptions() const;
+    std::shared_ptr<cfg::Configuration> GetConfiguration() const;
+    wxString GetDatabaseFilePath() const;
+
+    /* ISO date of the given day of the generated range, wrapping around */
+    wxString GetDate(int day) const;
+    /* ISO dates of the Monday and Sunday of the given week of the generated range, wrapping around */
+    wxString GetWeekStartDate(int week) const;
+    wxString GetWeekEndDate(int week) const;
+    int GetWeekCount() const;
+    /* project id of the given generated project, wrapping around */
+    int GetProjectId(int project) const;
+
+    static const std::size_t PoolSize = 4;
+
+private:
+    bool CreateDirectories();
+    bool CreateConfiguration();
+    bool CreateConnectionPool();
+    bool Generate();
+
+    BenchmarkDatabaseOptions mOptions;
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::shared_ptr<cfg::Configuration> pConfig;
+
+    wxString mDirectory;
+    wxDateTime mFirstDate;
+    std::vector<int> mProjectIds;
+
+    static const std::string beginTransaction;
+    static const std::string commitTransaction;
+    static const std::string createEmployer;
+    static const std::string createProject;
+    static const std::string createCategory;
+    static const std::string createTask;
+    static const std::string createTaskItem;
+};
+} // namespace app::bench
@@ -20,21 +20,16 @@
 #pragma once
 
 #include <memory>
-#include <tuple>
-#include <vector>
 
-#include "taskstateservice.h"
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
 
-namespace app::services
-{
-struct TaskStorage
-{
-    TaskStorage();
-    ~TaskStorage() = default;
+#include "benchmarkdatabase.h"
+#include "instrumentation.h"
 
-    void Store(std::shared_ptr<TaskStateService> taskState);
-    void Restore(std::shared_ptr<TaskStateService> taskState);
-
-    std::vector<std::tuple<wxDateTime, wxDateTime>> mTimes;
-};
-} // namespace app::services
+namespace app::bench
+{
+/* the generated database and the logger shared by the benchmarks, both are set up by main */
+BenchmarkDatabase& GetDatabase();
+std::shared_ptr<spdlog::logger> GetLogger();
+} // namespace app::bench
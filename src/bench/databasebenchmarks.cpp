@@ -0,0 +1,64 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include <utility>
+
+#include <wx/filename.h>
+
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+#include "../services/databasebackup.h"
+
+#include "benchmarks.h"
+
+namespace app::bench
+{
+static void ConnectionPool_AcquireRelease(benchmark::State& state)
+{
+    auto pool = db::ConnectionProvider::Get().Handle();
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        auto connection = pool->Acquire();
+        benchmark::DoNotOptimize(connection.get());
+        pool->Release(std::move(connection));
+    }
+}
+BENCHMARK(ConnectionPool_AcquireRelease);
+
+/* every iteration overwrites the backup of the day, the catalogue keeps growing meanwhile */
+static void DatabaseBackup_Execute(benchmark::State& state)
+{
+    auto databaseSize = wxFileName::GetSize(GetDatabase().GetDatabaseFilePath());
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        svc::DatabaseBackup databaseBackup(GetDatabase().GetConfiguration(), GetLogger());
+        if (!databaseBackup.Execute()) {
+            state.SkipWithError("DatabaseBackup::Execute failed");
+            break;
+        }
+    }
+
+    if (databaseSize != wxInvalidSize) {
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(databaseSize.GetValue()));
+    }
+}
+BENCHMARK(DatabaseBackup_Execute)->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace app::bench
@@ -0,0 +1,109 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "../data/projectdata.h"
+#include "../data/taskitemdata.h"
+
+#include "benchmarks.h"
+
+namespace app::bench
+{
+static std::vector<wxString> GetDates()
+{
+    std::vector<wxString> dates;
+    for (int day = 0; day < GetDatabase().GetOptions().mDays; day++) {
+        dates.push_back(GetDatabase().GetDate(day));
+    }
+    return dates;
+}
+
+static void TaskItemData_GetByDate(benchmark::State& state)
+{
+    auto dates = GetDates();
+    std::size_t day = 0;
+    std::int64_t taskItemCount = 0;
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        data::TaskItemData taskItemData;
+        auto taskItems = taskItemData.GetByDate(dates[day++ % dates.size()]);
+        taskItemCount += static_cast<std::int64_t>(taskItems.size());
+        benchmark::DoNotOptimize(taskItems.data());
+    }
+    state.SetItemsProcessed(taskItemCount);
+}
+BENCHMARK(TaskItemData_GetByDate);
+
+static void TaskItemData_GetByWeek(benchmark::State& state)
+{
+    std::vector<std::pair<wxString, wxString>> weeks;
+    for (int week = 0; week < GetDatabase().GetWeekCount(); week++) {
+        weeks.emplace_back(GetDatabase().GetWeekStartDate(week), GetDatabase().GetWeekEndDate(week));
+    }
+    std::size_t week = 0;
+    std::int64_t taskItemCount = 0;
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        const auto& [fromDate, toDate] = weeks[week++ % weeks.size()];
+        data::TaskItemData taskItemData;
+        auto taskItems = taskItemData.GetByWeek(fromDate, toDate);
+        taskItemCount += static_cast<std::int64_t>(taskItems.size());
+        benchmark::DoNotOptimize(taskItems.data());
+    }
+    state.SetItemsProcessed(taskItemCount);
+}
+BENCHMARK(TaskItemData_GetByWeek);
+
+static void TaskItemData_GetHours(benchmark::State& state)
+{
+    auto dates = GetDates();
+    std::size_t day = 0;
+    std::int64_t durationCount = 0;
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        data::TaskItemData taskItemData;
+        auto durations = taskItemData.GetHours(dates[day++ % dates.size()]);
+        durationCount += static_cast<std::int64_t>(durations.size());
+        benchmark::DoNotOptimize(durations.data());
+    }
+    state.SetItemsProcessed(durationCount);
+}
+BENCHMARK(TaskItemData_GetHours);
+
+static void ProjectData_GetById(benchmark::State& state)
+{
+    int project = 0;
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        data::ProjectData projectData;
+        auto projectModel = projectData.GetById(GetDatabase().GetProjectId(project++));
+        benchmark::DoNotOptimize(projectModel.get());
+    }
+}
+BENCHMARK(ProjectData_GetById);
+} // namespace app::bench
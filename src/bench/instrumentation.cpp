@@ -0,0 +1,79 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "instrumentation.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <wx/defs.h>
+
+#include "../database/querystatistics.h"
+
+namespace app::bench
+{
+static std::atomic<std::int64_t> AllocationCount(0);
+
+std::int64_t GetQueryCount()
+{
+    return db::QueryStatistics::Get().GetTotalCount();
+}
+
+std::int64_t GetAllocationCount()
+{
+    return AllocationCount.load(std::memory_order_relaxed);
+}
+
+CounterScope::CounterScope(benchmark::State& state)
+    : mState(state)
+    , mQueryCount(GetQueryCount())
+    , mAllocationCount(GetAllocationCount())
+{
+}
+
+CounterScope::~CounterScope()
+{
+    mState.counters["queries_per_call"] = benchmark::Counter(
+        static_cast<double>(GetQueryCount() - mQueryCount), benchmark::Counter::kAvgIterations);
+    mState.counters["allocs_per_call"] = benchmark::Counter(
+        static_cast<double>(GetAllocationCount() - mAllocationCount), benchmark::Counter::kAvgIterations);
+}
+} // namespace app::bench
+
+/* the replaced operator new counts the allocations, the array and sized forms forward to these */
+void* operator new(std::size_t size)
+{
+    app::bench::AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t size) noexcept
+{
+    wxUnusedVar(size);
+    std::free(memory);
+}
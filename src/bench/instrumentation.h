@@ -0,0 +1,50 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace app::bench
+{
+/* statements run on the pooled connections, as recorded by db::QueryStatistics */
+std::int64_t GetQueryCount();
+
+/* calls to the global operator new made by any thread */
+std::int64_t GetAllocationCount();
+
+/*
+ Samples the query and allocation counts around the timed loop of a benchmark and reports them
+ as queries_per_call and allocs_per_call next to the wall time. Create it right before the loop
+ */
+class CounterScope final
+{
+public:
+    CounterScope() = delete;
+    explicit CounterScope(benchmark::State& state);
+    ~CounterScope();
+
+private:
+    benchmark::State& mState;
+    std::int64_t mQueryCount;
+    std::int64_t mAllocationCount;
+};
+} // namespace app::bench
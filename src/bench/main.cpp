@@ -0,0 +1,138 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <spdlog/sinks/stdout_sinks.h>
+#include <wx/init.h>
+
+#include "../common/version.h"
+#include "../database/querystatistics.h"
+
+#include "benchmarks.h"
+
+namespace app::bench
+{
+static BenchmarkDatabase* pDatabase = nullptr;
+static std::shared_ptr<spdlog::logger> pLogger = nullptr;
+
+BenchmarkDatabase& GetDatabase()
+{
+    return *pDatabase;
+}
+
+std::shared_ptr<spdlog::logger> GetLogger()
+{
+    return pLogger;
+}
+
+/* parses a --taskable_<name>=<value> argument, the values are validated once all are parsed */
+static bool ParseOption(const std::string& argument, const std::string& option, int& value)
+{
+    if (argument.rfind(option, 0) != 0) {
+        return false;
+    }
+
+    value = std::atoi(argument.substr(option.size()).c_str());
+    return true;
+}
+
+/* the data classes' connection traces go to the default null trace logger and stay out of the measurements */
+static void CreateLoggers()
+{
+    pLogger = std::make_shared<spdlog::logger>("taskable-bench", std::make_shared<spdlog::sinks::stderr_sink_st>());
+    pLogger->set_level(spdlog::level::warn);
+}
+} // namespace app::bench
+
+/*
+ Runs the benchmarks against a generated database. Besides the benchmark library's own arguments it takes
+   --taskable_days=<n> --taskable_items_per_day=<n> --taskable_projects=<n> --taskable_categories=<n>
+ to size the database. Results are reported as JSON unless another --benchmark_format is given
+ */
+int main(int argc, char** argv)
+{
+    wxInitializer initializer;
+    if (!initializer.IsOk()) {
+        return EXIT_FAILURE;
+    }
+
+    app::bench::BenchmarkDatabaseOptions options;
+    std::vector<char*> arguments;
+    bool hasFormat = false;
+
+    for (int i = 0; i < argc; i++) {
+        std::string argument(argv[i]);
+        if (i > 0 && (app::bench::ParseOption(argument, "--taskable_days=", options.mDays) ||
+                         app::bench::ParseOption(argument, "--taskable_items_per_day=", options.mItemsPerDay) ||
+                         app::bench::ParseOption(argument, "--taskable_projects=", options.mProjects) ||
+                         app::bench::ParseOption(argument, "--taskable_categories=", options.mCategories))) {
+            continue;
+        }
+        hasFormat = hasFormat || argument.rfind("--benchmark_format=", 0) == 0;
+        arguments.push_back(argv[i]);
+    }
+
+    static char jsonFormat[] = "--benchmark_format=json";
+    if (!hasFormat) {
+        arguments.push_back(jsonFormat);
+    }
+
+    int argumentCount = static_cast<int>(arguments.size());
+    benchmark::Initialize(&argumentCount, arguments.data());
+    if (benchmark::ReportUnrecognizedArguments(argumentCount, arguments.data())) {
+        return EXIT_FAILURE;
+    }
+
+    app::bench::CreateLoggers();
+    auto logger = app::bench::GetLogger();
+
+    if (options.mDays <= 0 || options.mItemsPerDay <= 0 || options.mProjects <= 0 || options.mCategories <= 0) {
+        logger->error("The --taskable_ options have to be positive numbers");
+        return EXIT_FAILURE;
+    }
+
+    int exitCode = EXIT_SUCCESS;
+    {
+        app::bench::BenchmarkDatabase database(options, logger);
+        if (database.Create()) {
+            app::bench::pDatabase = &database;
+            app::db::QueryStatistics::Get().SetEnabled(true);
+
+            /* recorded in the context of the JSON report so results can be compared across releases */
+            benchmark::AddCustomContext("taskable_version", PRODUCT_VERSION_STR);
+            benchmark::AddCustomContext("taskable_days", std::to_string(options.mDays));
+            benchmark::AddCustomContext("taskable_items_per_day", std::to_string(options.mItemsPerDay));
+            benchmark::AddCustomContext("taskable_projects", std::to_string(options.mProjects));
+            benchmark::AddCustomContext("taskable_categories", std::to_string(options.mCategories));
+
+            benchmark::RunSpecifiedBenchmarks();
+            app::bench::pDatabase = nullptr;
+        } else {
+            logger->error("Unable to create the benchmark database");
+            exitCode = EXIT_FAILURE;
+        }
+    }
+
+    benchmark::Shutdown();
+    spdlog::drop_all();
+    return exitCode;
+}
@@ -0,0 +1,76 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include <vector>
+
+#include <wx/dataview.h>
+#include <wx/datetime.h>
+
+#include "../common/datetraverser.h"
+#include "../data/taskitemdata.h"
+#include "../dataview/weeklymodel.h"
+
+#include "benchmarks.h"
+
+namespace app::bench
+{
+/*
+ Switches the weekly tree model between the given number of weeks the way WeeklyTaskViewDialog does:
+ recently viewed weeks are swapped back in from the week cache, other weeks are loaded again.
+ Only built where wxWidgets core is available
+ */
+static void WeeklyTreeModel_SwitchWeek(benchmark::State& state)
+{
+    auto weekCount = static_cast<std::size_t>(state.range(0));
+
+    std::vector<DateTraverser> dateTraversers(weekCount);
+    for (std::size_t week = 0; week < weekCount; week++) {
+        wxDateTime mondayDate;
+        mondayDate.ParseISODate(GetDatabase().GetWeekStartDate(static_cast<int>(week)));
+        dateTraversers[week].Recalculate(mondayDate);
+    }
+
+    wxObjectDataPtr<dv::WeeklyTreeModel> weeklyTreeModel(new dv::WeeklyTreeModel(dateTraversers[0]));
+    {
+        data::TaskItemData taskItemData;
+        auto taskItems = taskItemData.GetByWeek(GetDatabase().GetWeekStartDate(0), GetDatabase().GetWeekEndDate(0));
+        weeklyTreeModel->AddToWeek(taskItems);
+    }
+
+    std::size_t week = 1;
+    std::int64_t cacheHits = 0;
+
+    CounterScope counters(state);
+    for (auto _ : state) {
+        auto& dateTraverser = dateTraversers[week++ % weekCount];
+        if (weeklyTreeModel->SwitchWeek(dateTraverser)) {
+            cacheHits++;
+            continue;
+        }
+
+        data::TaskItemData taskItemData;
+        auto taskItems = taskItemData.GetByWeek(dateTraverser.GetDayISODate(constants::Days::Monday),
+            dateTraverser.GetDayISODate(constants::Days::Sunday));
+        weeklyTreeModel->AddToWeek(taskItems);
+    }
+    state.counters["cache_hits_per_call"] =
+        benchmark::Counter(static_cast<double>(cacheHits), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(WeeklyTreeModel_SwitchWeek)->Arg(2)->Arg(5)->Arg(16);
+} // namespace app::bench
@@ -19,82 +19,8 @@
 
 #include "common.h"
 
+#include <wx/filename.h>
 #include <wx/stdpaths.h>
-#include <wx/richtooltip.h>
-
-#include "constants.h"
-#include "../../res/taskable.xpm"
-#include "../../res/about.xpm"
-#include "../../res/checkforupdate.xpm"
-#include "../../res/entry-task.xpm"
-#include "../../res/timed-task.xpm"
-#include "../../res/stopwatch.xpm"
-#include "../../res/database-restore.xpm"
-#include "../../res/database-backup.xpm"
-#include "../../res/taskable-64.xpm"
-#include "../../res/settings.xpm"
-#include "../../res/quit.xpm"
-#include "../../res/feedback.xpm"
-
-const char** app::common::GetProgramIcon()
-{
-    return taskablexpm;
-}
-
-const char** app::common::GetAboutIcon()
-{
-    return aboutxpm;
-}
-
-const char** app::common::GetCheckForUpdateIcon()
-{
-    return checkforupdatexpm;
-}
-
-const char** app::common::GetEntryTaskIcon()
-{
-    return entrytaskxpm;
-}
-
-const char** app::common::GetTimedTaskIcon()
-{
-    return timedtaskxpm;
-}
-
-const char** app::common::GetStopwatchIcon()
-{
-    return stopwatchxpm;
-}
-
-const char** app::common::GetDatabaseRestoreIcon()
-{
-    return database_restore;
-}
-
-const char** app::common::GetDatabaseBackupIcon()
-{
-    return database_backup_xpm;
-}
-
-const char** app::common::GetProgramIcon64()
-{
-    return taskable_64_xpm;
-}
-
-const char** app::common::GetSettingsIcon()
-{
-    return settings_xpm;
-}
-
-const char** app::common::GetQuitIcon()
-{
-    return quit_xpm;
-}
-
-const char** app::common::GetFeedbackIcon()
-{
-    return feedback_xpm;
-}
 
 std::string app::common::GetLicense()
 {
@@ -139,79 +65,58 @@ wxString app::common::GetDatabaseFileName()
 
 wxString app::common::GetDatabaseFilePath(const wxString& databasePath)
 {
-    return wxString::Format(wxT("%s\\%s"), databasePath, common::GetDatabaseFileName());
+    return wxFileName(databasePath, common::GetDatabaseFileName()).GetFullPath();
 }
 
-wxString app::common::GetConfigFilePath()
+wxString app::common::GetArchiveDatabaseFileName()
 {
-    return wxString::Format(wxT("%s\\%s"), wxStandardPaths::Get().GetUserDataDir(), common::GetConfigFileName());
+#ifdef TASKABLE_DEBUG
+    return wxT("taskable-archive-d.db");
+#else
+    return wxT("taskable-archive.db");
+#endif // TASKABLE_DEBUG
 }
 
-wxString app::common::GetConfigFileName()
+wxString app::common::GetArchiveDatabaseFilePath(const wxString& databasePath)
 {
-    return wxT("taskable.ini");
+    return wxFileName(databasePath, common::GetArchiveDatabaseFileName()).GetFullPath();
 }
 
-wxString app::common::GetAppId()
+wxString app::common::GetConfigFilePath()
 {
-    return wxT("ifexception.Taskable");
+    return wxFileName(wxStandardPaths::Get().GetUserDataDir(), common::GetConfigFileName()).GetFullPath();
 }
 
-void app::common::validations::ForRequiredChoiceSelection(wxWindow* window, wxString label)
+wxString app::common::GetConfigFileName()
 {
-    const wxString errorHeader = wxT("Invalid selection");
-    const wxString errorMessage = wxString::Format(wxT("A %s selection is required"), label);
-
-    wxRichToolTip tooltip(errorHeader, errorMessage);
-    tooltip.SetIcon(wxICON_WARNING);
-    tooltip.ShowFor(window);
+    return wxT("taskable.ini");
 }
 
-void app::common::validations::ForRequiredText(wxWindow* window, wxString label)
+wxString app::common::GetLogsDirectory()
 {
-    const wxString errorHeader = wxT("Invalid input");
-    const wxString errorMessage =
-        wxString::Format(wxT("A %s is required \nand must be within %d to %d characters long"),
-            label,
-            constants::MinLength,
-            constants::MaxLength);
-
-    wxRichToolTip tooltip(errorHeader, errorMessage);
-    tooltip.SetIcon(wxICON_WARNING);
-    tooltip.ShowFor(window);
+    return wxFileName(wxStandardPaths::Get().GetUserDataDir(), wxT("logs")).GetFullPath();
 }
 
-void app::common::validations::ForRequiredLongText(wxWindow* window, wxString label)
+wxString app::common::GetStopwatchJournalFilePath(int stopwatchId)
 {
-    const wxString errorHeader = wxT("Invalid input");
-    const wxString errorMessage =
-        wxString::Format(wxT("A %s is required \nand must be within %d to %d characters long"),
-            label,
-            constants::MinLength2,
-            constants::MaxLength2);
-
-    wxRichToolTip tooltip(errorHeader, errorMessage);
-    tooltip.SetIcon(wxICON_WARNING);
-    tooltip.ShowFor(window);
+#ifdef TASKABLE_DEBUG
+    auto fileName = wxString::Format(wxT("stopwatchd-%d.journal"), stopwatchId);
+#else
+    auto fileName = wxString::Format(wxT("stopwatch-%d.journal"), stopwatchId);
+#endif // TASKABLE_DEBUG
+    return wxFileName(wxStandardPaths::Get().GetUserDataDir(), fileName).GetFullPath();
 }
 
-void app::common::validations::ForRequiredNumber(wxWindow* window, wxString label)
+wxString app::common::GetStopwatchJournalFileSpec()
 {
-    const wxString errorHeader = wxT("Invalid amount");
-    const wxString errorMessage = wxString::Format(
-        wxT("%s is required \nand must be greater than %d"), label, constants::MinLength, constants::MaxLength);
-
-    wxRichToolTip tooltip(errorHeader, errorMessage);
-    tooltip.SetIcon(wxICON_WARNING);
-    tooltip.ShowFor(window);
+#ifdef TASKABLE_DEBUG
+    return wxT("stopwatchd-*.journal");
+#else
+    return wxT("stopwatch-*.journal");
+#endif // TASKABLE_DEBUG
 }
 
-void app::common::validations::ForInvalidTime(wxWindow* window, wxString message)
+wxString app::common::GetAppId()
 {
-    const wxString errorHeader = wxT("Invalid time");
-    const wxString errorMessage = message;
-
-    wxRichToolTip tooltip(errorHeader, errorMessage);
-    tooltip.SetIcon(wxICON_WARNING);
-    tooltip.ShowFor(window);
+    return wxT("ifexception.Taskable");
 }
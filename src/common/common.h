@@ -19,47 +19,18 @@
 
 #pragma once
 
-#include <wx/wx.h>
+#include <string>
+
+#include <wx/string.h>
 
 #include "version.h"
 
+#if wxUSE_GUI
+#include "ui.h"
+#endif // wxUSE_GUI
+
 namespace app::common
 {
-namespace sizers
-{
-const wxSizerFlags ControlDefault = wxSizerFlags().Border(wxALL, 5);
-const wxSizerFlags ControlCenter = wxSizerFlags(ControlDefault).Center();
-const wxSizerFlags ControlCenterHorizontal = wxSizerFlags(ControlDefault).CenterHorizontal();
-const wxSizerFlags ControlCenterVertical = wxSizerFlags(ControlDefault).CenterVertical();
-const wxSizerFlags ControlRight = wxSizerFlags(ControlDefault).Right();
-const wxSizerFlags ControlLeft = wxSizerFlags(ControlDefault).Left();
-const wxSizerFlags ControlExpand = wxSizerFlags(ControlDefault).Expand();
-const wxSizerFlags ControlExpandProp = wxSizerFlags(ControlDefault).Align(wxEXPAND).Proportion(1);
-} // namespace sizers
-
-namespace validations
-{
-void ForRequiredChoiceSelection(wxWindow* window, wxString label);
-void ForRequiredText(wxWindow* window, wxString label);
-void ForRequiredLongText(wxWindow* window, wxString label);
-void ForRequiredNumber(wxWindow* window, wxString label);
-void ForInvalidTime(wxWindow* window, wxString message);
-} // namespace validations
-
-// TODO Check licensing https://icons8.com/icon/pack/time-and-date/cute-clipart
-extern const char** GetProgramIcon();
-extern const char** GetAboutIcon();
-extern const char** GetCheckForUpdateIcon();
-extern const char** GetEntryTaskIcon();
-extern const char** GetTimedTaskIcon();
-extern const char** GetStopwatchIcon();
-extern const char** GetDatabaseRestoreIcon();
-extern const char** GetDatabaseBackupIcon();
-extern const char** GetProgramIcon64();
-extern const char** GetSettingsIcon();
-extern const char** GetQuitIcon();
-extern const char** GetFeedbackIcon();
-
 std::string GetLicense();
 
 wxString GetVersion();
@@ -70,9 +41,19 @@ wxString GetDatabaseFileName();
 
 wxString GetDatabaseFilePath(const wxString& databasePath);
 
+wxString GetArchiveDatabaseFileName();
+
+wxString GetArchiveDatabaseFilePath(const wxString& databasePath);
+
 wxString GetConfigFilePath();
 
 wxString GetConfigFileName();
 
+wxString GetLogsDirectory();
+
+wxString GetStopwatchJournalFilePath(int stopwatchId);
+
+wxString GetStopwatchJournalFileSpec();
+
 wxString GetAppId();
 } // namespace app::common
@@ -46,6 +46,14 @@ enum class TaskItemTypes : int {
     TimedTask = 2,
 };
 
+/* PRAGMA user_version of the database, raised by the feature that changes the schema and never lowered */
+enum class SchemaVersion : int {
+    Tables = 1,
+    SearchIndex = 2,
+    Archive = 3,
+    Current = Archive,
+};
+
 enum Days { Monday = 0, Tuesday, Wednesday, Thursday, Friday, Saturday, Sunday };
 
 Days MapIndexToEnum(int index);
@@ -38,6 +38,8 @@ enum class MenuIds : int {
     Help_CheckForUpdateId,
     Tools_RestoreDatabaseId,
     Tools_BackupDatabaseId,
+    File_View_PeriodView,
+    Tools_QueryStatisticsId,
 
     Unp_ReturnToCurrentDate = 32,
 };
@@ -50,6 +52,7 @@ static const int ID_NEW_PROJECT = static_cast<int>(ids::MenuIds::File_NewProject
 static const int ID_NEW_CATEGORY = static_cast<int>(ids::MenuIds::File_NewCategoryId);
 static const int ID_STOPWATCH_TASK = static_cast<int>(ids::MenuIds::File_StopwatchTaskId);
 static const int ID_WEEKLY_VIEW = static_cast<int>(ids::MenuIds::File_View_WeeklyView);
+static const int ID_PERIOD_VIEW = static_cast<int>(ids::MenuIds::File_View_PeriodView);
 
 static const int ID_EDIT_EMPLOYER = static_cast<int>(MenuIds::Edit_EditEmployerId);
 static const int ID_EDIT_CLIENT = static_cast<int>(MenuIds::Edit_EditClientId);
@@ -62,6 +65,7 @@ static const int ID_CHECK_FOR_UPDATE = static_cast<int>(MenuIds::Help_CheckForUp
 
 static const int ID_RESTORE_DATABASE = static_cast<int>(MenuIds::Tools_RestoreDatabaseId);
 static const int ID_BACKUP_DATABASE = static_cast<int>(MenuIds::Tools_BackupDatabaseId);
+static const int ID_QUERY_STATISTICS = static_cast<int>(MenuIds::Tools_QueryStatisticsId);
 
 static const int ID_RETURN_TO_CURRENT_DATE = static_cast<int>(MenuIds::Unp_ReturnToCurrentDate);
 
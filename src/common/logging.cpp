@@ -0,0 +1,65 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "logging.h"
+
+#include <atomic>
+
+#include <spdlog/sinks/null_sink.h>
+#ifdef _WIN32
+#include <spdlog/sinks/msvc_sink.h>
+#else
+#include <spdlog/sinks/stdout_color_sinks.h>
+#endif // _WIN32
+
+namespace app::common
+{
+static std::shared_ptr<spdlog::logger> CreateNullLogger()
+{
+    return std::make_shared<spdlog::logger>("trace", std::make_shared<spdlog::sinks::null_sink_mt>());
+}
+
+/* the owning pointer is only swapped during startup, readers go through the atomic */
+static std::shared_ptr<spdlog::logger> TraceLoggerOwner = CreateNullLogger();
+static std::atomic<spdlog::logger*> TraceLogger(TraceLoggerOwner.get());
+
+spdlog::logger* GetTraceLogger()
+{
+    return TraceLogger.load(std::memory_order_acquire);
+}
+
+void SetTraceLogger(std::shared_ptr<spdlog::logger> logger)
+{
+    if (logger == nullptr) {
+        logger = CreateNullLogger();
+    }
+
+    TraceLogger.store(logger.get(), std::memory_order_release);
+    TraceLoggerOwner = logger;
+}
+
+spdlog::sink_ptr CreateDebugOutputSink()
+{
+#ifdef _WIN32
+    return std::make_shared<spdlog::sinks::msvc_sink_mt>();
+#else
+    return std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+#endif // _WIN32
+}
+} // namespace app::common
@@ -21,25 +21,19 @@
 
 #include <memory>
 
-#include <wx/arrstr.h>
-#include <wx/string.h>
+#include <spdlog/spdlog.h>
 
-#include "../config/configuration.h"
-
-namespace app::svc
-{
-class DatabaseBackupDeleter final
+namespace app::common
 {
-public:
-    DatabaseBackupDeleter(std::shared_ptr<cfg::Configuration> config);
-    ~DatabaseBackupDeleter() = default;
-
-    bool Execute();
-
-private:
-    wxArrayString GetFilesForDeletion();
-    bool DeleteFilesAfterSpecifiedDate(const wxArrayString& filesToDelete);
-
-    std::shared_ptr<cfg::Configuration> pConfig;
-};
-} // namespace app::svc
+/*
+ The trace logger receives the connection and data-access traces of the data classes. It is held here
+ so hot paths do not look it up in the spdlog registry, and it is a null logger until one is set.
+ Traces are written with the SPDLOG_LOGGER_DEBUG/TRACE macros, which are compiled out of release builds
+ through SPDLOG_ACTIVE_LEVEL
+ */
+spdlog::logger* GetTraceLogger();
+void SetTraceLogger(std::shared_ptr<spdlog::logger> logger);
+
+/* sink for the platform's debug output: the debugger output window on Windows, stderr elsewhere */
+spdlog::sink_ptr CreateDebugOutputSink();
+} // namespace app::common
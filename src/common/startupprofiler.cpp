@@ -0,0 +1,133 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "startupprofiler.h"
+
+#include <wx/ffile.h>
+
+namespace app::common
+{
+StartupProfiler::Phase::Phase(const char* name)
+    : pName(name)
+    , mStart(Clock::now())
+{
+}
+
+StartupProfiler::Phase::~Phase()
+{
+    StartupProfiler::Get().Record(pName, mStart, Clock::now());
+}
+
+StartupProfiler& StartupProfiler::Get()
+{
+    static StartupProfiler instance;
+    return instance;
+}
+
+void StartupProfiler::SetTraceFilePath(const wxString& filePath)
+{
+    mTraceFilePath = filePath;
+}
+
+void StartupProfiler::Mark(const char* name)
+{
+    auto now = Clock::now();
+    Record(name, now, now);
+}
+
+void StartupProfiler::Record(const char* name, Clock::time_point start, Clock::time_point end)
+{
+    if (!bFinished) {
+        mEntries.push_back(Entry{ name, start, end });
+    }
+}
+
+void StartupProfiler::Finish(std::shared_ptr<spdlog::logger> logger)
+{
+    if (bFinished) {
+        return;
+    }
+    bFinished = true;
+
+    for (const auto& entry : mEntries) {
+        if (entry.mStart == entry.mEnd) {
+            logger->info("Startup: {0} at {1:.1f} ms", entry.pName, ToMilliseconds(entry.mStart));
+        } else {
+            logger->info("Startup: {0} took {1:.1f} ms, from {2:.1f} ms",
+                entry.pName,
+                ToMilliseconds(entry.mEnd) - ToMilliseconds(entry.mStart),
+                ToMilliseconds(entry.mStart));
+        }
+    }
+    logger->info("Startup finished after {0:.1f} ms", ToMilliseconds(Clock::now()));
+
+    if (!mTraceFilePath.empty() && !WriteTrace()) {
+        logger->error("Unable to write the startup trace to {0}", mTraceFilePath.ToStdString());
+    }
+}
+
+bool StartupProfiler::IsFinished() const
+{
+    return bFinished;
+}
+
+StartupProfiler::StartupProfiler()
+    : mStart(Clock::now())
+    , mEntries()
+    , mTraceFilePath(wxGetEmptyString())
+    , bFinished(false)
+{
+}
+
+double StartupProfiler::ToMilliseconds(Clock::time_point timePoint) const
+{
+    return std::chrono::duration<double, std::milli>(timePoint - mStart).count();
+}
+
+bool StartupProfiler::WriteTrace() const
+{
+    wxFFile file(mTraceFilePath, wxT("w"));
+    if (!file.IsOpened()) {
+        return false;
+    }
+
+    /* complete ("X") events for phases and global instant ("i") events for marks, timestamps in microseconds */
+    wxString trace = wxT("{\"traceEvents\":[\n");
+    for (std::size_t i = 0; i < mEntries.size(); i++) {
+        const auto& entry = mEntries[i];
+        auto timestamp = ToMilliseconds(entry.mStart) * 1000.0;
+        if (entry.mStart == entry.mEnd) {
+            trace += wxString::Format(wxT("{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.0f,\"pid\":1,\"tid\":1}"),
+                entry.pName,
+                timestamp);
+        } else {
+            auto duration = (ToMilliseconds(entry.mEnd) - ToMilliseconds(entry.mStart)) * 1000.0;
+            trace += wxString::Format(
+                wxT("{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.0f,\"dur\":%.0f,\"pid\":1,\"tid\":1}"),
+                entry.pName,
+                timestamp,
+                duration);
+        }
+        trace += i + 1 < mEntries.size() ? wxT(",\n") : wxT("\n");
+    }
+    trace += wxT("]}\n");
+
+    return file.Write(trace) && file.Close();
+}
+} // namespace app::common
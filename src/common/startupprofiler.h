@@ -0,0 +1,87 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <wx/string.h>
+
+namespace app::common
+{
+/*
+ Times the phases of application startup, from the construction of the application object until the
+ work deferred past the first paint of the main window has run. The phases are logged once startup
+ finishes and, when a trace file is set (--startup-trace), also written in the Chrome trace event format
+ so they can be viewed in chrome://tracing. Startup runs on the UI thread, so the profiler is not locked
+ */
+class StartupProfiler final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /* times a phase from construction until destruction */
+    class Phase final
+    {
+    public:
+        Phase() = delete;
+        explicit Phase(const char* name);
+        ~Phase();
+
+    private:
+        const char* pName;
+        Clock::time_point mStart;
+    };
+
+    static StartupProfiler& Get();
+
+    StartupProfiler(const StartupProfiler&) = delete;
+    StartupProfiler& operator=(const StartupProfiler&) = delete;
+
+    void SetTraceFilePath(const wxString& filePath);
+
+    /* records a point in time, such as the first paint of the main window */
+    void Mark(const char* name);
+    void Record(const char* name, Clock::time_point start, Clock::time_point end);
+
+    /* logs the phases, writes the trace file if one is set and stops recording */
+    void Finish(std::shared_ptr<spdlog::logger> logger);
+    bool IsFinished() const;
+
+private:
+    struct Entry {
+        const char* pName;
+        Clock::time_point mStart;
+        Clock::time_point mEnd;
+    };
+
+    StartupProfiler();
+
+    double ToMilliseconds(Clock::time_point timePoint) const;
+    bool WriteTrace() const;
+
+    Clock::time_point mStart;
+    std::vector<Entry> mEntries;
+    wxString mTraceFilePath;
+    bool bFinished;
+};
+} // namespace app::common
@@ -0,0 +1,165 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "ui.h"
+
+#include <wx/richtooltip.h>
+
+#include "constants.h"
+#include "../../res/taskable.xpm"
+#include "../../res/about.xpm"
+#include "../../res/checkforupdate.xpm"
+#include "../../res/entry-task.xpm"
+#include "../../res/timed-task.xpm"
+#include "../../res/stopwatch.xpm"
+#include "../../res/database-restore.xpm"
+#include "../../res/database-backup.xpm"
+#include "../../res/taskable-64.xpm"
+#include "../../res/settings.xpm"
+#include "../../res/quit.xpm"
+#include "../../res/feedback.xpm"
+
+const char** app::common::GetProgramIcon()
+{
+    return taskablexpm;
+}
+
+const char** app::common::GetAboutIcon()
+{
+    return aboutxpm;
+}
+
+const char** app::common::GetCheckForUpdateIcon()
+{
+    return checkforupdatexpm;
+}
+
+const char** app::common::GetEntryTaskIcon()
+{
+    return entrytaskxpm;
+}
+
+const char** app::common::GetTimedTaskIcon()
+{
+    return timedtaskxpm;
+}
+
+const char** app::common::GetStopwatchIcon()
+{
+    return stopwatchxpm;
+}
+
+const char** app::common::GetDatabaseRestoreIcon()
+{
+    return database_restore;
+}
+
+const char** app::common::GetDatabaseBackupIcon()
+{
+    return database_backup_xpm;
+}
+
+const char** app::common::GetProgramIcon64()
+{
+    return taskable_64_xpm;
+}
+
+const char** app::common::GetSettingsIcon()
+{
+    return settings_xpm;
+}
+
+const char** app::common::GetQuitIcon()
+{
+    return quit_xpm;
+}
+
+const char** app::common::GetFeedbackIcon()
+{
+    return feedback_xpm;
+}
+
+void app::common::validations::ForRequiredChoiceSelection(wxWindow* window, wxString label)
+{
+    const wxString errorHeader = wxT("Invalid selection");
+    const wxString errorMessage = wxString::Format(wxT("A %s selection is required"), label);
+
+    wxRichToolTip tooltip(errorHeader, errorMessage);
+    tooltip.SetIcon(wxICON_WARNING);
+    tooltip.ShowFor(window);
+}
+
+void app::common::validations::ForRequiredText(wxWindow* window, wxString label)
+{
+    const wxString errorHeader = wxT("Invalid input");
+    const wxString errorMessage =
+        wxString::Format(wxT("A %s is required \nand must be within %d to %d characters long"),
+            label,
+            constants::MinLength,
+            constants::MaxLength);
+
+    wxRichToolTip tooltip(errorHeader, errorMessage);
+    tooltip.SetIcon(wxICON_WARNING);
+    tooltip.ShowFor(window);
+}
+
+void app::common::validations::ForRequiredLongText(wxWindow* window, wxString label)
+{
+    const wxString errorHeader = wxT("Invalid input");
+    const wxString errorMessage =
+        wxString::Format(wxT("A %s is required \nand must be within %d to %d characters long"),
+            label,
+            constants::MinLength2,
+            constants::MaxLength2);
+
+    wxRichToolTip tooltip(errorHeader, errorMessage);
+    tooltip.SetIcon(wxICON_WARNING);
+    tooltip.ShowFor(window);
+}
+
+void app::common::validations::ForRequiredNumber(wxWindow* window, wxString label)
+{
+    const wxString errorHeader = wxT("Invalid amount");
+    const wxString errorMessage = wxString::Format(
+        wxT("%s is required \nand must be greater than %d"), label, constants::MinLength, constants::MaxLength);
+
+    wxRichToolTip tooltip(errorHeader, errorMessage);
+    tooltip.SetIcon(wxICON_WARNING);
+    tooltip.ShowFor(window);
+}
+
+void app::common::validations::ForInvalidTime(wxWindow* window, wxString message)
+{
+    const wxString errorHeader = wxT("Invalid time");
+    const wxString errorMessage = message;
+
+    wxRichToolTip tooltip(errorHeader, errorMessage);
+    tooltip.SetIcon(wxICON_WARNING);
+    tooltip.ShowFor(window);
+}
+
+bool app::common::IsWindowVisible(wxWindow* window)
+{
+    if (!window->IsShownOnScreen()) {
+        return false;
+    }
+
+    auto topLevelWindow = dynamic_cast<wxTopLevelWindow*>(wxGetTopLevelParent(window));
+    return topLevelWindow == nullptr || !topLevelWindow->IsIconized();
+}
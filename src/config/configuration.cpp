@@ -22,214 +22,443 @@
 #include <wx/file.h>
 
 #include "../common/common.h"
-#include "../common/util.h"
 
 namespace app::cfg
 {
 Configuration::Configuration()
+    : mNextSubscriptionId(1)
 {
-    wxString configFile =
-        wxString::Format(wxT("%s\\%s"), wxStandardPaths::Get().GetUserDataDir(), common::GetConfigFileName());
+    wxString configFile = common::GetConfigFilePath();
 
     pConfig = new wxFileConfig(wxEmptyString, wxEmptyString, configFile);
     pConfig->SetPath("/");
+    Load();
+}
+
+Configuration::Configuration(const wxString& configFilePath)
+    : mNextSubscriptionId(1)
+{
+    pConfig = new wxFileConfig(wxEmptyString, wxEmptyString, configFilePath);
+    pConfig->SetPath("/");
+    Load();
 }
 
 Configuration::~Configuration()
 {
+    Save();
     delete pConfig;
 }
 
 void Configuration::Save()
 {
+    std::scoped_lock lock(mMutex);
+    auto settings = std::atomic_load(&pSettings);
+    if (settings == pPersistedSettings) {
+        return;
+    }
+
+    WriteChanges(*pPersistedSettings, *settings);
+
+    /* wxFileConfig writes the whole file to a temporary file and renames it over the configuration file */
     pConfig->Flush();
+    pPersistedSettings = settings;
+}
+
+std::shared_ptr<const Settings> Configuration::GetSettings() const
+{
+    return std::atomic_load(&pSettings);
+}
+
+const std::vector<wxString>& Configuration::GetInvalidSettings() const
+{
+    return mInvalidSettings;
+}
+
+int Configuration::Subscribe(Setting setting, Listener listener)
+{
+    std::scoped_lock lock(mSubscriptionsMutex);
+    int subscriptionId = mNextSubscriptionId++;
+    mSubscriptions[subscriptionId] = Subscription{ setting, std::move(listener) };
+
+    return subscriptionId;
+}
+
+void Configuration::Unsubscribe(int subscriptionId)
+{
+    std::scoped_lock lock(mSubscriptionsMutex);
+    mSubscriptions.erase(subscriptionId);
 }
 
 bool Configuration::IsConfirmOnExit() const
 {
-    return Get<bool>(wxT("settings"), wxT("confirmOnExit"));
+    return Get<Setting::ConfirmOnExit>();
 }
 
 void Configuration::SetConfirmOnExit(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("confirmOnExit"), value);
+    Set<Setting::ConfirmOnExit>(value);
 }
 
 bool Configuration::IsStartOnBoot() const
 {
-    return Get<bool>(wxT("settings"), wxT("startOnBoot"));
+    return Get<Setting::StartOnBoot>();
 }
 
 void Configuration::SetStartOnBoot(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("startOnBoot"), value);
+    Set<Setting::StartOnBoot>(value);
 }
 
 bool Configuration::IsShowInTray() const
 {
-    return Get<bool>(wxT("settings"), wxT("showInTray"));
+    return Get<Setting::ShowInTray>();
 }
 
 void Configuration::SetShowInTray(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("showInTray"), value);
+    Set<Setting::ShowInTray>(value);
 }
 
 bool Configuration::IsMinimizeToTray() const
 {
-    return Get<bool>(wxT("settings"), wxT("minimizeToTray"));
+    return Get<Setting::MinimizeToTray>();
 }
 
 void Configuration::SetMinimizeToTray(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("minimizeToTray"), value);
+    Set<Setting::MinimizeToTray>(value);
 }
 
 bool Configuration::IsCloseToTray() const
 {
-    return Get<bool>(wxT("settings"), wxT("closeToTray"));
+    return Get<Setting::CloseToTray>();
 }
 
 void Configuration::SetCloseToTray(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("closeToTray"), value);
+    Set<Setting::CloseToTray>(value);
 }
 
 wxString Configuration::GetDatabasePath() const
 {
-    return Get<wxString>(wxT("settings"), wxT("databasePath"));
+    return Get<Setting::DatabasePath>();
 }
 
 void Configuration::SetDatabasePath(const wxString& value)
 {
-    Set<wxString>(wxT("settings"), wxT("databasePath"), value);
+    Set<Setting::DatabasePath>(value);
 }
 
 bool Configuration::IsBackupEnabled() const
 {
-    return Get<bool>(wxT("settings"), wxT("backupEnabled"));
+    return Get<Setting::BackupEnabled>();
 }
 
 void Configuration::SetBackupEnabled(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("backupEnabled"), value);
+    Set<Setting::BackupEnabled>(value);
 }
 
 wxString Configuration::GetBackupPath() const
 {
-    return Get<wxString>(wxT("settings"), wxT("backupPath"));
+    return Get<Setting::BackupPath>();
 }
 
 void Configuration::SetBackupPath(const wxString& value)
 {
-    Set<wxString>(wxT("settings"), wxT("backupPath"), value);
+    Set<Setting::BackupPath>(value);
+}
+
+int Configuration::GetKeepDailyBackups() const
+{
+    return Get<Setting::KeepDailyBackups>();
+}
+
+void Configuration::SetKeepDailyBackups(int value)
+{
+    Set<Setting::KeepDailyBackups>(value);
+}
+
+int Configuration::GetKeepWeeklyBackups() const
+{
+    return Get<Setting::KeepWeeklyBackups>();
+}
+
+void Configuration::SetKeepWeeklyBackups(int value)
+{
+    Set<Setting::KeepWeeklyBackups>(value);
+}
+
+int Configuration::GetKeepMonthlyBackups() const
+{
+    return Get<Setting::KeepMonthlyBackups>();
 }
 
-int Configuration::GetDeleteBackupsAfter() const
+void Configuration::SetKeepMonthlyBackups(int value)
 {
-    return Get<int>(wxT("settings"), wxT("deleteBackupsAfter"));
+    Set<Setting::KeepMonthlyBackups>(value);
 }
 
-void Configuration::SetDeleteBackupsAfter(int value)
+int Configuration::GetBackupSizeLimit() const
 {
-    Set<int>(wxT("settings"), wxT("deleteBackupsAfter"), value);
+    return Get<Setting::BackupSizeLimit>();
+}
+
+void Configuration::SetBackupSizeLimit(int value)
+{
+    Set<Setting::BackupSizeLimit>(value);
+}
+
+bool Configuration::IsBackupCompressionEnabled() const
+{
+    return Get<Setting::CompressBackups>();
+}
+
+void Configuration::SetBackupCompression(bool value)
+{
+    Set<Setting::CompressBackups>(value);
+}
+
+bool Configuration::IsDifferentialBackupEnabled() const
+{
+    return Get<Setting::DifferentialBackups>();
+}
+
+void Configuration::SetDifferentialBackup(bool value)
+{
+    Set<Setting::DifferentialBackups>(value);
+}
+
+int Configuration::GetFullBackupInterval() const
+{
+    return Get<Setting::FullBackupInterval>();
+}
+
+void Configuration::SetFullBackupInterval(int value)
+{
+    Set<Setting::FullBackupInterval>(value);
+}
+
+int Configuration::GetArchiveAfterMonths() const
+{
+    return Get<Setting::ArchiveAfterMonths>();
+}
+
+void Configuration::SetArchiveAfterMonths(int value)
+{
+    Set<Setting::ArchiveAfterMonths>(value);
 }
 
 bool Configuration::IsMinimizeStopwatchWindow() const
 {
-    return Get<bool>(wxT("settings"), wxT("minimizeStopwatchWindow"));
+    return Get<Setting::MinimizeStopwatchWindow>();
 }
 
 void Configuration::SetMinimizeStopwatchWindow(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("minimizeStopwatchWindow"), value);
+    Set<Setting::MinimizeStopwatchWindow>(value);
 }
 
 int Configuration::GetHideWindowTimerInterval() const
 {
-    return Get<int>(wxT("settings"), wxT("hideWindowTimer"));
+    return Get<Setting::HideWindowTimer>();
 }
 
 void Configuration::SetHideWindowTimerInterval(int value)
 {
-    Set<int>(wxT("settings"), wxT("hideWindowTimer"), value);
+    Set<Setting::HideWindowTimer>(value);
 }
 
 int Configuration::GetNotificationTimerInterval() const
 {
-    return Get<int>(wxT("settings"), wxT("notificationTimer"));
+    return Get<Setting::NotificationTimer>();
 }
 
 void Configuration::SetNotificationTimerInterval(int value)
 {
-    Set<int>(wxT("settings"), wxT("notificationTimer"), value);
+    Set<Setting::NotificationTimer>(value);
 }
 
 int Configuration::GetPausedTaskReminderInterval() const
 {
-    return Get<int>(wxT("settings"), wxT("pausedTaskReminder"));
+    return Get<Setting::PausedTaskReminder>();
 }
 
 void Configuration::SetPausedTaskReminderInterval(int value)
 {
-    Set<int>(wxT("settings"), wxT("pausedTaskReminder"), value);
+    Set<Setting::PausedTaskReminder>(value);
+}
+
+bool Configuration::IsIdleDetectionEnabled() const
+{
+    return Get<Setting::IdleDetection>();
+}
+
+void Configuration::SetIdleDetection(bool value)
+{
+    Set<Setting::IdleDetection>(value);
+}
+
+int Configuration::GetIdleThreshold() const
+{
+    return Get<Setting::IdleThreshold>();
+}
+
+void Configuration::SetIdleThreshold(int value)
+{
+    Set<Setting::IdleThreshold>(value);
 }
 
 bool Configuration::IsStartStopwatchOnLaunch() const
 {
-    return Get<bool>(wxT("settings"), wxT("startStopwatchOnLaunch"));
+    return Get<Setting::StartStopwatchOnLaunch>();
 }
 
 void Configuration::SetStartStopwatchOnLaunch(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("startStopwatchOnLaunch"), value);
+    Set<Setting::StartStopwatchOnLaunch>(value);
 }
 
 bool Configuration::IsStartStopwatchOnResume() const
 {
-    return Get<bool>(wxT("settings"), wxT("startStopwatchOnResume"));
+    return Get<Setting::StartStopwatchOnResume>();
 }
 
 void Configuration::SetStartStopwatchOnResume(bool value)
 {
-    Set<bool>(wxT("settings"), wxT("startStopwatchOnResume"), value);
+    Set<Setting::StartStopwatchOnResume>(value);
 }
 
-wxSize Configuration::GetFrameSize() const
+std::tuple<int, int> Configuration::GetFrameSize() const
 {
-    auto dimensions = Get<wxString>(wxT("persistence"), wxT("dimensions"));
-    auto dimensionsSplit = util::lib::split(dimensions.ToStdString(), ',');
-    int w = std::stoi(dimensionsSplit[0]);
-    int h = std::stoi(dimensionsSplit[1]);
-    return wxSize(w, h);
+    auto settings = GetSettings();
+    return std::make_tuple(settings->mFrameWidth, settings->mFrameHeight);
 }
 
-void Configuration::SetFrameSize(const wxSize value)
+void Configuration::SetFrameSize(const int width, const int height)
 {
-    int w = value.GetWidth();
-    int h = value.GetHeight();
-    auto newSize = wxString::Format(wxT("%s,%s"), std::to_string(w), std::to_string(h));
-    Set<wxString>(wxT("persistence"), wxT("dimensions"), newSize);
+    Update(Setting::FrameSize, [&](Settings& settings) {
+        settings.mFrameWidth = width;
+        settings.mFrameHeight = height;
+    });
+}
+
+int Configuration::GetLastDatabaseMaintenance() const
+{
+    return Get<Setting::LastDatabaseMaintenance>();
+}
+
+void Configuration::SetLastDatabaseMaintenance(int value)
+{
+    Set<Setting::LastDatabaseMaintenance>(value);
+}
+
+int Configuration::GetLastDatabaseAnalyze() const
+{
+    return Get<Setting::LastDatabaseAnalyze>();
+}
+
+void Configuration::SetLastDatabaseAnalyze(int value)
+{
+    Set<Setting::LastDatabaseAnalyze>(value);
 }
 
 bool Configuration::IsTimeRoundingEnabled() const
 {
-    return Get<bool>(wxT("settings"), wxT("timeRounding"));
+    return Get<Setting::TimeRounding>();
 }
 
 void Configuration::SetTimeRounding(const bool value)
 {
-    Set<bool>(wxT("settings"), wxT("timeRounding"), value);
+    Set<Setting::TimeRounding>(value);
 }
 
 int Configuration::GetTimeToRoundTo() const
 {
-    return Get<int>(wxT("settings"), wxT("timeToRoundTo"));
+    return Get<Setting::TimeToRoundTo>();
 }
 
 void Configuration::SetTimeToRoundTo(const int value)
 {
-    Set<int>(wxT("settings"), wxT("timeToRoundTo"), value);
+    Set<Setting::TimeToRoundTo>(value);
+}
+
+bool Configuration::IsQueryStatisticsEnabled() const
+{
+    return Get<Setting::QueryStatistics>();
+}
+
+void Configuration::SetQueryStatistics(const bool value)
+{
+    Set<Setting::QueryStatistics>(value);
+}
+
+void Configuration::Load()
+{
+    auto settings = std::make_shared<Settings>();
+
+    schema::ForEach([&](const auto& field) {
+        using T = typename std::decay_t<decltype(field)>::ValueType;
+
+        T value(field.mDefault);
+        Read(field.pGroup, field.pKey, value);
+        if (!schema::IsValid(field, value)) {
+            mInvalidSettings.push_back(wxString::Format(wxT("%s/%s"), field.pGroup, field.pKey));
+            value = T(field.mDefault);
+        }
+
+        (*settings).*field.pMember = value;
+    });
+
+    settings->mFrameWidth = schema::DefaultFrameWidth;
+    settings->mFrameHeight = schema::DefaultFrameHeight;
+
+    wxString dimensions;
+    Read(wxT("persistence"), wxT("dimensions"), dimensions);
+    long width = 0;
+    long height = 0;
+    if (dimensions.BeforeFirst(',').ToLong(&width) && dimensions.AfterFirst(',').ToLong(&height) && width > 0 &&
+        height > 0) {
+        settings->mFrameWidth = width;
+        settings->mFrameHeight = height;
+    } else if (!dimensions.empty()) {
+        mInvalidSettings.push_back(wxT("persistence/dimensions"));
+    }
+
+    pSettings = settings;
+    pPersistedSettings = settings;
 }
 
+void Configuration::WriteChanges(const Settings& persisted, const Settings& current)
+{
+    schema::ForEach([&](const auto& field) {
+        if (persisted.*field.pMember != current.*field.pMember) {
+            Write(field.pGroup, field.pKey, current.*field.pMember);
+        }
+    });
+
+    if (persisted.mFrameWidth != current.mFrameWidth || persisted.mFrameHeight != current.mFrameHeight) {
+        Write(wxT("persistence"),
+            wxT("dimensions"),
+            wxString::Format(wxT("%d,%d"), current.mFrameWidth, current.mFrameHeight));
+    }
+}
+
+void Configuration::Notify(Setting setting, const Settings& settings)
+{
+    /* a listener may unsubscribe itself, so walk a copy */
+    std::vector<Listener> listeners;
+    {
+        std::scoped_lock lock(mSubscriptionsMutex);
+        for (const auto& [subscriptionId, subscription] : mSubscriptions) {
+            if (subscription.mSetting == setting) {
+                listeners.push_back(subscription.mListener);
+            }
+        }
+    }
+
+    for (const auto& listener : listeners) {
+        listener(settings);
+    }
+}
 } // namespace app::cfg
@@ -19,21 +19,57 @@
 
 #pragma once
 
-#include <wx/sizer.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
 #include <wx/string.h>
 #include <wx/stdpaths.h>
 #include <wx/fileconf.h>
 
+#include "schema.h"
+#include "settings.h"
+
 namespace app::cfg
 {
+/*
+ The configuration file is read once into a Settings snapshot and validated against the schema. Getters read
+ the current snapshot and setters publish a modified copy of it, so settings can be read from any thread
+ without locking. Changes are only written to the file by Save(), which is also called on destruction
+ */
 class Configuration
 {
 public:
+    using Listener = std::function<void(const Settings& settings)>;
+
     Configuration();
+    /* reads and writes the given configuration file instead of the one in the user data directory */
+    explicit Configuration(const wxString& configFilePath);
     ~Configuration();
 
+    /* writes the settings changed since the last save to the file in a single replace of the file */
     void Save();
 
+    /* readers of several settings should read them from one snapshot */
+    std::shared_ptr<const Settings> GetSettings() const;
+
+    /* the group and key of each setting in the file that was out of range and replaced by its default */
+    const std::vector<wxString>& GetInvalidSettings() const;
+
+    template<Setting S>
+    auto Get() const;
+
+    /* values outside the range of the setting are clamped to it */
+    template<Setting S, class T>
+    void Set(const T& value);
+
+    /* listeners are called on the thread that changed the setting, once the new snapshot is published */
+    int Subscribe(Setting setting, Listener listener);
+    void Unsubscribe(int subscriptionId);
+
     bool IsConfirmOnExit() const;
     void SetConfirmOnExit(bool value);
 
@@ -58,8 +94,29 @@ class Configuration
     wxString GetBackupPath() const;
     void SetBackupPath(const wxString& value);
 
-    int GetDeleteBackupsAfter() const;
-    void SetDeleteBackupsAfter(int value);
+    int GetKeepDailyBackups() const;
+    void SetKeepDailyBackups(int value);
+
+    int GetKeepWeeklyBackups() const;
+    void SetKeepWeeklyBackups(int value);
+
+    int GetKeepMonthlyBackups() const;
+    void SetKeepMonthlyBackups(int value);
+
+    int GetBackupSizeLimit() const;
+    void SetBackupSizeLimit(int value);
+
+    bool IsBackupCompressionEnabled() const;
+    void SetBackupCompression(bool value);
+
+    bool IsDifferentialBackupEnabled() const;
+    void SetDifferentialBackup(bool value);
+
+    int GetFullBackupInterval() const;
+    void SetFullBackupInterval(int value);
+
+    int GetArchiveAfterMonths() const;
+    void SetArchiveAfterMonths(int value);
 
     bool IsMinimizeStopwatchWindow() const;
     void SetMinimizeStopwatchWindow(bool value);
@@ -73,14 +130,27 @@ class Configuration
     int GetPausedTaskReminderInterval() const;
     void SetPausedTaskReminderInterval(int value);
 
+    bool IsIdleDetectionEnabled() const;
+    void SetIdleDetection(bool value);
+
+    int GetIdleThreshold() const;
+    void SetIdleThreshold(int value);
+
     bool IsStartStopwatchOnLaunch() const;
     void SetStartStopwatchOnLaunch(bool value);
 
     bool IsStartStopwatchOnResume() const;
     void SetStartStopwatchOnResume(bool value);
 
-    wxSize GetFrameSize() const;
-    void SetFrameSize(const wxSize value);
+    /* width and height of the main frame */
+    std::tuple<int, int> GetFrameSize() const;
+    void SetFrameSize(const int width, const int height);
+
+    int GetLastDatabaseMaintenance() const;
+    void SetLastDatabaseMaintenance(int value);
+
+    int GetLastDatabaseAnalyze() const;
+    void SetLastDatabaseAnalyze(int value);
 
     bool IsTimeRoundingEnabled() const;
     void SetTimeRounding(const bool value);
@@ -88,28 +158,87 @@ class Configuration
     int GetTimeToRoundTo() const;
     void SetTimeToRoundTo(const int value);
 
+    bool IsQueryStatisticsEnabled() const;
+    void SetQueryStatistics(const bool value);
+
 private:
+    struct Subscription {
+        Setting mSetting;
+        Listener mListener;
+    };
+
+    void Load();
+    void WriteChanges(const Settings& persisted, const Settings& current);
+
+    template<class Function>
+    void Update(Setting setting, Function update);
+    void Notify(Setting setting, const Settings& settings);
+
     template<class T>
-    T Get(const wxString& group, const wxString& key) const;
+    void Read(const wxString& group, const wxString& key, T& value) const;
 
     template<class T>
-    void Set(const wxString& group, const wxString& key, T value);
+    void Write(const wxString& group, const wxString& key, const T& value);
 
     wxFileConfig* pConfig;
+    std::shared_ptr<const Settings> pSettings;
+    /* the snapshot last read from or written to the file */
+    std::shared_ptr<const Settings> pPersistedSettings;
+    /* serializes setters and the file */
+    std::mutex mMutex;
+    std::vector<wxString> mInvalidSettings;
+
+    std::map<int, Subscription> mSubscriptions;
+    int mNextSubscriptionId;
+    std::mutex mSubscriptionsMutex;
 };
 
+template<Setting S>
+auto Configuration::Get() const
+{
+    return (*GetSettings()).*schema::Find<S>().pMember;
+}
+
+template<Setting S, class T>
+void Configuration::Set(const T& value)
+{
+    constexpr const auto& field = schema::Find<S>();
+    auto constrained = schema::Constrain(field, value);
+
+    /* applying a dialog sets every setting again, only actual changes are published */
+    if ((*GetSettings()).*field.pMember == constrained) {
+        return;
+    }
+
+    Update(S, [&](Settings& settings) { settings.*field.pMember = constrained; });
+}
+
+template<class Function>
+void Configuration::Update(Setting setting, Function update)
+{
+    std::shared_ptr<const Settings> published;
+    {
+        std::scoped_lock lock(mMutex);
+        auto settings = std::make_shared<Settings>(*std::atomic_load(&pSettings));
+        update(*settings);
+        published = std::move(settings);
+        std::atomic_store(&pSettings, published);
+    }
+
+    Notify(setting, *published);
+}
+
+/* a key missing from the file leaves the value as it is */
 template<class T>
-T Configuration::Get(const wxString& group, const wxString& key) const
+void Configuration::Read(const wxString& group, const wxString& key, T& value) const
 {
     pConfig->SetPath(group);
-    T value;
     pConfig->Read(key, &value);
     pConfig->SetPath("/");
-    return value;
 }
 
 template<class T>
-void Configuration::Set(const wxString& group, const wxString& key, T value)
+void Configuration::Write(const wxString& group, const wxString& key, const T& value)
 {
     pConfig->SetPath(group);
     pConfig->Write(key, value);
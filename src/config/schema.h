@@ -0,0 +1,314 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <tuple>
+
+#include <wx/string.h>
+
+#include "settings.h"
+
+namespace app::cfg
+{
+/* identifies a setting, in the order of the schema */
+enum class Setting : int {
+    ConfirmOnExit = 0,
+    StartOnBoot,
+    ShowInTray,
+    MinimizeToTray,
+    CloseToTray,
+    DatabasePath,
+    BackupEnabled,
+    BackupPath,
+    KeepDailyBackups,
+    KeepWeeklyBackups,
+    KeepMonthlyBackups,
+    BackupSizeLimit,
+    CompressBackups,
+    DifferentialBackups,
+    FullBackupInterval,
+    ArchiveAfterMonths,
+    MinimizeStopwatchWindow,
+    HideWindowTimer,
+    NotificationTimer,
+    PausedTaskReminder,
+    IdleDetection,
+    IdleThreshold,
+    StartStopwatchOnLaunch,
+    StartStopwatchOnResume,
+    TimeRounding,
+    TimeToRoundTo,
+    QueryStatistics,
+    LastDatabaseMaintenance,
+    LastDatabaseAnalyze,
+    /* stored as "width,height" under a single key, so it is handled apart from the schema */
+    FrameSize
+};
+
+namespace schema
+{
+/* the type a default or bound is written as in the constexpr table */
+template<class T>
+struct Literal {
+    using Type = T;
+};
+
+template<>
+struct Literal<wxString> {
+    using Type = const wxChar*;
+};
+
+/* where a setting is stored, its default and the inclusive range its values are valid in */
+template<class T>
+struct Field {
+    using ValueType = T;
+
+    Setting mSetting;
+    const wxChar* pGroup;
+    const wxChar* pKey;
+    T Settings::*pMember;
+    typename Literal<T>::Type mDefault;
+    typename Literal<T>::Type mMinimum;
+    typename Literal<T>::Type mMaximum;
+};
+
+constexpr Field<bool> Flag(Setting setting,
+    const wxChar* group,
+    const wxChar* key,
+    bool Settings::*member,
+    bool defaultValue)
+{
+    return Field<bool>{ setting, group, key, member, defaultValue, false, true };
+}
+
+constexpr Field<int> Number(Setting setting,
+    const wxChar* group,
+    const wxChar* key,
+    int Settings::*member,
+    int defaultValue,
+    int minimum,
+    int maximum)
+{
+    return Field<int>{ setting, group, key, member, defaultValue, minimum, maximum };
+}
+
+constexpr Field<wxString> Text(Setting setting,
+    const wxChar* group,
+    const wxChar* key,
+    wxString Settings::*member,
+    const wxChar* defaultValue)
+{
+    return Field<wxString>{ setting, group, key, member, defaultValue, nullptr, nullptr };
+}
+
+/* the defaults match the taskable.ini shipped with the application */
+inline constexpr auto Fields = std::make_tuple(
+    Flag(Setting::ConfirmOnExit, wxT("settings"), wxT("confirmOnExit"), &Settings::bConfirmOnExit, false),
+    Flag(Setting::StartOnBoot, wxT("settings"), wxT("startOnBoot"), &Settings::bStartOnBoot, false),
+    Flag(Setting::ShowInTray, wxT("settings"), wxT("showInTray"), &Settings::bShowInTray, false),
+    Flag(Setting::MinimizeToTray, wxT("settings"), wxT("minimizeToTray"), &Settings::bMinimizeToTray, false),
+    Flag(Setting::CloseToTray, wxT("settings"), wxT("closeToTray"), &Settings::bCloseToTray, false),
+    Text(Setting::DatabasePath, wxT("settings"), wxT("databasePath"), &Settings::mDatabasePath, wxT("")),
+    Flag(Setting::BackupEnabled, wxT("settings"), wxT("backupEnabled"), &Settings::bBackupEnabled, false),
+    Text(Setting::BackupPath, wxT("settings"), wxT("backupPath"), &Settings::mBackupPath, wxT("")),
+    Number(Setting::KeepDailyBackups,
+        wxT("settings"),
+        wxT("keepDailyBackups"),
+        &Settings::mKeepDailyBackups,
+        7,
+        0,
+        99),
+    Number(Setting::KeepWeeklyBackups,
+        wxT("settings"),
+        wxT("keepWeeklyBackups"),
+        &Settings::mKeepWeeklyBackups,
+        4,
+        0,
+        99),
+    Number(Setting::KeepMonthlyBackups,
+        wxT("settings"),
+        wxT("keepMonthlyBackups"),
+        &Settings::mKeepMonthlyBackups,
+        6,
+        0,
+        99),
+    Number(
+        Setting::BackupSizeLimit, wxT("settings"), wxT("backupSizeLimit"), &Settings::mBackupSizeLimit, 0, 0, 1000000),
+    Flag(Setting::CompressBackups, wxT("settings"), wxT("compressBackups"), &Settings::bCompressBackups, true),
+    Flag(Setting::DifferentialBackups,
+        wxT("settings"),
+        wxT("differentialBackups"),
+        &Settings::bDifferentialBackups,
+        false),
+    Number(Setting::FullBackupInterval,
+        wxT("settings"),
+        wxT("fullBackupInterval"),
+        &Settings::mFullBackupInterval,
+        7,
+        1,
+        30),
+    Number(Setting::ArchiveAfterMonths,
+        wxT("settings"),
+        wxT("archiveAfterMonths"),
+        &Settings::mArchiveAfterMonths,
+        0,
+        0,
+        120),
+    Flag(Setting::MinimizeStopwatchWindow,
+        wxT("settings"),
+        wxT("minimizeStopwatchWindow"),
+        &Settings::bMinimizeStopwatchWindow,
+        false),
+    Number(Setting::HideWindowTimer,
+        wxT("settings"),
+        wxT("hideWindowTimer"),
+        &Settings::mHideWindowTimerInterval,
+        1,
+        1,
+        5),
+    Number(Setting::NotificationTimer,
+        wxT("settings"),
+        wxT("notificationTimer"),
+        &Settings::mNotificationTimerInterval,
+        15,
+        5,
+        60),
+    Number(Setting::PausedTaskReminder,
+        wxT("settings"),
+        wxT("pausedTaskReminder"),
+        &Settings::mPausedTaskReminderInterval,
+        1,
+        1,
+        15),
+    Flag(Setting::IdleDetection, wxT("settings"), wxT("idleDetection"), &Settings::bIdleDetection, false),
+    Number(Setting::IdleThreshold, wxT("settings"), wxT("idleThreshold"), &Settings::mIdleThreshold, 5, 3, 30),
+    Flag(Setting::StartStopwatchOnLaunch,
+        wxT("settings"),
+        wxT("startStopwatchOnLaunch"),
+        &Settings::bStartStopwatchOnLaunch,
+        false),
+    Flag(Setting::StartStopwatchOnResume,
+        wxT("settings"),
+        wxT("startStopwatchOnResume"),
+        &Settings::bStartStopwatchOnResume,
+        false),
+    Flag(Setting::TimeRounding, wxT("settings"), wxT("timeRounding"), &Settings::bTimeRounding, false),
+    Number(Setting::TimeToRoundTo, wxT("settings"), wxT("timeToRoundTo"), &Settings::mTimeToRoundTo, 5, 5, 15),
+    Flag(Setting::QueryStatistics, wxT("settings"), wxT("queryStatistics"), &Settings::bQueryStatistics, false),
+    Number(Setting::LastDatabaseMaintenance,
+        wxT("persistence"),
+        wxT("lastDatabaseMaintenance"),
+        &Settings::mLastDatabaseMaintenance,
+        0,
+        0,
+        INT_MAX),
+    Number(Setting::LastDatabaseAnalyze,
+        wxT("persistence"),
+        wxT("lastDatabaseAnalyze"),
+        &Settings::mLastDatabaseAnalyze,
+        0,
+        0,
+        INT_MAX));
+
+inline constexpr int DefaultFrameWidth = 600;
+inline constexpr int DefaultFrameHeight = 500;
+
+template<class Visitor>
+void ForEach(Visitor visit)
+{
+    std::apply([&](const auto&... field) { (visit(field), ...); }, Fields);
+}
+
+/* the field of a setting, looked up at compile time */
+template<Setting S>
+constexpr const auto& Find()
+{
+    constexpr auto index = static_cast<std::size_t>(S);
+    static_assert(index < std::tuple_size_v<decltype(Fields)>, "the setting is not in the schema");
+    return std::get<index>(Fields);
+}
+
+constexpr bool IsDefaultValid(const Field<bool>&)
+{
+    return true;
+}
+
+constexpr bool IsDefaultValid(const Field<int>& field)
+{
+    return field.mMinimum <= field.mDefault && field.mDefault <= field.mMaximum;
+}
+
+constexpr bool IsDefaultValid(const Field<wxString>& field)
+{
+    return field.mDefault != nullptr;
+}
+
+/* Find() relies on the fields being in the order of the Setting enumeration */
+constexpr bool IsInSettingOrder()
+{
+    return std::apply(
+        [](const auto&... field) {
+            int index = 0;
+            return ((static_cast<int>(field.mSetting) == index++) && ...);
+        },
+        Fields);
+}
+
+static_assert(IsInSettingOrder(), "the schema fields must follow the order of the Setting enumeration");
+static_assert(std::tuple_size_v<decltype(Fields)> == static_cast<std::size_t>(Setting::FrameSize),
+    "every setting but the frame size needs a field in the schema");
+static_assert(std::apply([](const auto&... field) { return (IsDefaultValid(field) && ...); }, Fields),
+    "every default must be inside the range of its setting");
+
+inline bool IsValid(const Field<bool>&, bool)
+{
+    return true;
+}
+
+inline bool IsValid(const Field<int>& field, int value)
+{
+    return field.mMinimum <= value && value <= field.mMaximum;
+}
+
+inline bool IsValid(const Field<wxString>&, const wxString&)
+{
+    return true;
+}
+
+/* brings a value that is about to be set into the range of its setting */
+inline bool Constrain(const Field<bool>&, bool value)
+{
+    return value;
+}
+
+inline int Constrain(const Field<int>& field, int value)
+{
+    return std::clamp(value, field.mMinimum, field.mMaximum);
+}
+
+inline wxString Constrain(const Field<wxString>&, const wxString& value)
+{
+    return value;
+}
+} // namespace schema
+} // namespace app::cfg
@@ -0,0 +1,66 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <wx/string.h>
+
+namespace app::cfg
+{
+/*
+ An immutable snapshot of every setting in the configuration file. A new snapshot is published each time a
+ setting changes, so a snapshot that has been handed out never changes underneath its reader
+ */
+struct Settings {
+    /* settings */
+    bool bConfirmOnExit = false;
+    bool bStartOnBoot = false;
+    bool bShowInTray = false;
+    bool bMinimizeToTray = false;
+    bool bCloseToTray = false;
+    wxString mDatabasePath;
+    bool bBackupEnabled = false;
+    wxString mBackupPath;
+    int mKeepDailyBackups = 0;
+    int mKeepWeeklyBackups = 0;
+    int mKeepMonthlyBackups = 0;
+    int mBackupSizeLimit = 0;
+    bool bCompressBackups = false;
+    bool bDifferentialBackups = false;
+    int mFullBackupInterval = 0;
+    int mArchiveAfterMonths = 0;
+    bool bMinimizeStopwatchWindow = false;
+    int mHideWindowTimerInterval = 0;
+    int mNotificationTimerInterval = 0;
+    int mPausedTaskReminderInterval = 0;
+    bool bIdleDetection = false;
+    int mIdleThreshold = 0;
+    bool bStartStopwatchOnLaunch = false;
+    bool bStartStopwatchOnResume = false;
+    bool bTimeRounding = false;
+    int mTimeToRoundTo = 0;
+    bool bQueryStatistics = false;
+
+    /* persistence */
+    int mFrameWidth = 0;
+    int mFrameHeight = 0;
+    int mLastDatabaseMaintenance = 0;
+    int mLastDatabaseAnalyze = 0;
+};
+} // namespace app::cfg
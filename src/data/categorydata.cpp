@@ -21,6 +21,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/logging.h"
 #include "projectdata.h"
 
 #include "../common/util.h"
@@ -31,7 +32,7 @@ CategoryData::CategoryData()
     : bBorrowedConnection(false)
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in CategoryData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in CategoryData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -39,7 +40,7 @@ CategoryData::CategoryData(std::shared_ptr<db::SqliteConnection> connection)
     : bBorrowedConnection(true)
 {
     pConnection = connection;
-    spdlog::get("msvc")->debug("BORROW connection in CategoryData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "BORROW connection in CategoryData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -47,14 +48,14 @@ CategoryData::~CategoryData()
 {
     if (!bBorrowedConnection) {
         db::ConnectionProvider::Get().Handle()->Release(pConnection);
-        spdlog::get("msvc")->debug("RELEASE connection in CategoryData|ConnectionTally: {0:d}",
+        SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in CategoryData|ConnectionTally: {0:d}",
             db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
     }
 }
 
 int64_t CategoryData::Create(std::unique_ptr<model::CategoryModel> category)
 {
-    unsigned int color = static_cast<unsigned int>(category->GetColor().GetRGB());
+    unsigned int color = category->GetColor();
 
     *pConnection->DatabaseExecutableHandle()
         << CategoryData::createCategory << category->GetName().ToStdString() << color << category->GetProjectId();
@@ -84,7 +85,7 @@ std::unique_ptr<model::CategoryModel> CategoryData::GetById(const int id)
 
 void CategoryData::Update(std::unique_ptr<model::CategoryModel> category)
 {
-    unsigned int color = static_cast<unsigned int>(category->GetColor().GetRGB());
+    unsigned int color = category->GetColor();
 
     *pConnection->DatabaseExecutableHandle()
         << CategoryData::updateCategory << category->GetName().ToStdString() << color << category->GetProjectId()
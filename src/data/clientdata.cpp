@@ -21,6 +21,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/logging.h"
 #include "../common/util.h"
 #include "employerdata.h"
 
@@ -30,7 +31,7 @@ ClientData::ClientData()
     : bBorrowedConnection(false)
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in ClientData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in ClientData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -38,7 +39,7 @@ ClientData::ClientData(std::shared_ptr<db::SqliteConnection> connection)
     : bBorrowedConnection(true)
 {
     pConnection = connection;
-    spdlog::get("msvc")->debug("BORROW connection in ClientData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "BORROW connection in ClientData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -46,7 +47,7 @@ ClientData::~ClientData()
 {
     if (!bBorrowedConnection) {
         db::ConnectionProvider::Get().Handle()->Release(pConnection);
-        spdlog::get("msvc")->debug("RELEASE connection in ClientData|ConnectionTally: {0:d}",
+        SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in ClientData|ConnectionTally: {0:d}",
             db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
     }
 }
@@ -21,13 +21,15 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/logging.h"
+
 namespace app::data
 {
 CurrencyData::CurrencyData()
     : bBorrowedConnection(false)
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in CurrencyData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in CurrencyData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -35,7 +37,7 @@ CurrencyData::CurrencyData(std::shared_ptr<db::SqliteConnection> connection)
     : bBorrowedConnection(true)
 {
     pConnection = connection;
-    spdlog::get("msvc")->debug("BORROW connection in CurrencyData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "BORROW connection in CurrencyData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -43,7 +45,7 @@ CurrencyData::~CurrencyData()
 {
     if (!bBorrowedConnection) {
         db::ConnectionProvider::Get().Handle()->Release(pConnection);
-        spdlog::get("msvc")->debug("RELEASE connection in CurrencyData|ConnectionTally: {0:d}",
+        SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in CurrencyData|ConnectionTally: {0:d}",
             db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
     }
 }
@@ -21,6 +21,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/logging.h"
 #include "../common/util.h"
 
 namespace app::data
@@ -29,7 +30,7 @@ EmployerData::EmployerData()
     : bBorrowedConnection(false)
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in EmployerData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in EmployerData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -37,7 +38,7 @@ EmployerData::EmployerData(std::shared_ptr<db::SqliteConnection> connection)
     : bBorrowedConnection(true)
 {
     pConnection = connection;
-    spdlog::get("msvc")->debug("BORROW connection in EmployerData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "BORROW connection in EmployerData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -45,7 +46,7 @@ EmployerData::~EmployerData()
 {
     if (!bBorrowedConnection) {
         db::ConnectionProvider::Get().Handle()->Release(pConnection);
-        spdlog::get("msvc")->debug("RELEASE connection in EmployerData|ConnectionTally: {0:d}",
+        SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in EmployerData|ConnectionTally: {0:d}",
             db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
     }
 }
@@ -21,6 +21,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/logging.h"
 #include "../common/util.h"
 #include "employerdata.h"
 #include "clientdata.h"
@@ -33,7 +34,7 @@ ProjectData::ProjectData()
     : bBorrowedConnection(false)
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in ProjectData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in ProjectData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -41,7 +42,7 @@ ProjectData::ProjectData(std::shared_ptr<db::SqliteConnection> connection)
     : bBorrowedConnection(true)
 {
     pConnection = connection;
-    spdlog::get("msvc")->debug("BORROW connection in ProjectData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "BORROW connection in ProjectData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
@@ -49,7 +50,7 @@ ProjectData::~ProjectData()
 {
     if (!bBorrowedConnection) {
         db::ConnectionProvider::Get().Handle()->Release(pConnection);
-        spdlog::get("msvc")->debug("RELEASE connection in ProjectData|ConnectionTally: {0:d}",
+        SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in ProjectData|ConnectionTally: {0:d}",
             db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
     }
 }
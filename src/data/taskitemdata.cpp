@@ -21,6 +21,7 @@
 
 #include <spdlog/spdlog.h>
 
+#include "../common/logging.h"
 #include "../common/util.h"
 
 #include "projectdata.h"
@@ -33,18 +34,76 @@ namespace app::data
 TaskItemData::TaskItemData()
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in TaskItemData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in TaskItemData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
 TaskItemData::~TaskItemData()
 {
     db::ConnectionProvider::Get().Handle()->Release(pConnection);
-    spdlog::get("msvc")->debug("RELEASE connection in TaskItemData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in TaskItemData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
 int64_t TaskItemData::Create(std::unique_ptr<model::TaskItemModel> taskItem)
+{
+    return Insert(taskItem.get());
+}
+
+std::vector<int64_t> TaskItemData::Create(std::unique_ptr<model::TaskItemModel> taskItem,
+    const std::vector<std::tuple<wxDateTime, wxDateTime>>& intervals)
+{
+    /* task items only store the time of day, so an interval running past midnight is split per day.
+       A piece ending at midnight shows 23:59:59 as its end time but keeps the full duration */
+    std::vector<std::tuple<wxDateTime, wxDateTime, wxTimeSpan>> pieces;
+    for (const auto& [startTime, endTime] : intervals) {
+        auto pieceStart = startTime;
+        while (pieceStart.IsEarlierThan(endTime)) {
+            auto nextDay = pieceStart.GetDateOnly() + wxDateSpan::Day();
+            if (endTime.IsEarlierThan(nextDay)) {
+                pieces.push_back(std::make_tuple(pieceStart, endTime, endTime - pieceStart));
+            } else {
+                pieces.push_back(std::make_tuple(pieceStart, nextDay - wxTimeSpan::Second(), nextDay - pieceStart));
+            }
+            pieceStart = nextDay;
+        }
+    }
+
+    /* the calculated rate covers the whole stopwatch task, each task item gets its share of it */
+    double totalSeconds = 0.0;
+    for (const auto& [startTime, endTime, pieceTime] : pieces) {
+        totalSeconds += pieceTime.GetSeconds().ToDouble();
+    }
+    double totalRate = taskItem->GetCalculatedRate() != nullptr ? *taskItem->GetCalculatedRate() : 0.0;
+
+    std::vector<int64_t> taskItemIds;
+    *pConnection->DatabaseExecutableHandle() << TaskItemData::beginTransaction;
+
+    try {
+        data::TaskData taskData(pConnection);
+        for (const auto& [startTime, endTime, pieceTime] : pieces) {
+            taskItem->SetTaskId(taskData.GetByDate(startTime)->GetTaskId());
+            taskItem->SetStartTime(std::make_unique<wxDateTime>(startTime));
+            taskItem->SetEndTime(std::make_unique<wxDateTime>(endTime));
+            taskItem->SetDuration(pieceTime.Format(wxT("%H:%M:%S")));
+            if (taskItem->GetCalculatedRate() != nullptr && totalSeconds > 0.0) {
+                taskItem->SetCalculatedRate(
+                    std::make_unique<double>(totalRate * pieceTime.GetSeconds().ToDouble() / totalSeconds));
+            }
+
+            taskItemIds.push_back(Insert(taskItem.get()));
+        }
+
+        *pConnection->DatabaseExecutableHandle() << TaskItemData::commitTransaction;
+    } catch (const sqlite::sqlite_exception&) {
+        *pConnection->DatabaseExecutableHandle() << TaskItemData::rollbackTransaction;
+        throw;
+    }
+
+    return taskItemIds;
+}
+
+int64_t TaskItemData::Insert(model::TaskItemModel* taskItem)
 {
     auto ps = *pConnection->DatabaseExecutableHandle() << TaskItemData::createTaskItem;
 
@@ -187,10 +246,21 @@ void TaskItemData::Delete(int taskItemId)
 }
 
 std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetByDate(const wxString& date)
+{
+    return SelectByDate(TaskItemData::getTaskItemsByDate, date);
+}
+
+std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::GetAllByDate(const wxString& date)
+{
+    return SelectByDate(TaskItemData::getAllTaskItemsByDate, date);
+}
+
+std::vector<std::unique_ptr<model::TaskItemModel>> TaskItemData::SelectByDate(const std::string& statement,
+    const wxString& date)
 {
     std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
 
-    *pConnection->DatabaseExecutableHandle() << TaskItemData::getTaskItemsByDate << date >>
+    *pConnection->DatabaseExecutableHandle() << statement << date >>
         [&](int taskItemId,
             std::string taskDate,
             std::unique_ptr<std::string> startTime,
@@ -258,6 +328,11 @@ std::vector<wxString> TaskItemData::GetHours(const wxString& date)
     return taskDurations;
 }
 
+std::vector<wxString> TaskItemData::GetAllHours(const wxString& date)
+{
+    return SelectHours(TaskItemData::getAllTaskHoursByTaskId, date, date);
+}
+
 int TaskItemData::GetTaskItemTypeIdByTaskItemId(const int taskItemId)
 {
     int taskItemTypeId = 0;
@@ -293,16 +368,79 @@ wxString TaskItemData::GetDescriptionById(const int taskItemId)
 }
 
 std::vector<wxString> TaskItemData::GetHoursByWeek(const wxString& fromDate, const wxString& toDate)
+{
+    return SelectHours(TaskItemData::getTaskHoursByWeek, fromDate, toDate);
+}
+
+std::vector<wxString> TaskItemData::GetAllHoursByWeek(const wxString& fromDate, const wxString& toDate)
+{
+    return SelectHours(TaskItemData::getAllTaskHoursByWeek, fromDate, toDate);
+}
+
+std::vector<wxString> TaskItemData::SelectHours(const std::string& statement,
+    const wxString& fromDate,
+    const wxString& toDate)
 {
     std::vector<wxString> taskDurations;
 
-    *pConnection->DatabaseExecutableHandle()
-            << TaskItemData::getTaskHoursByWeek << fromDate.ToStdString() << toDate.ToStdString() >>
+    *pConnection->DatabaseExecutableHandle() << statement << fromDate.ToStdString() << toDate.ToStdString() >>
         [&](std::string duration) { taskDurations.push_back(wxString(duration)); };
 
     return taskDurations;
 }
 
+std::vector<std::tuple<wxString, int>> TaskItemData::GetDurationTotalsByYear()
+{
+    std::vector<std::tuple<wxString, int>> totals;
+
+    *pConnection->DatabaseExecutableHandle() << TaskItemData::getDurationTotalsByYear >>
+        [&](std::string period, int seconds) { totals.push_back(std::make_tuple(wxString(period), seconds)); };
+
+    return totals;
+}
+
+std::vector<std::tuple<wxString, int>> TaskItemData::GetDurationTotalsByMonth(const wxString& fromDate,
+    const wxString& toDate)
+{
+    std::vector<std::tuple<wxString, int>> totals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << TaskItemData::getDurationTotalsByMonth << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](std::string period, int seconds) { totals.push_back(std::make_tuple(wxString(period), seconds)); };
+
+    return totals;
+}
+
+std::vector<std::tuple<wxString, int>> TaskItemData::GetDurationTotalsByWeek(const wxString& fromDate,
+    const wxString& toDate)
+{
+    std::vector<std::tuple<wxString, int>> totals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << TaskItemData::getDurationTotalsByWeek << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](std::string period, int seconds) { totals.push_back(std::make_tuple(wxString(period), seconds)); };
+
+    return totals;
+}
+
+std::vector<std::tuple<wxString, int>> TaskItemData::GetDurationTotalsByDay(const wxString& fromDate,
+    const wxString& toDate)
+{
+    std::vector<std::tuple<wxString, int>> totals;
+
+    *pConnection->DatabaseExecutableHandle()
+            << TaskItemData::getDurationTotalsByDay << fromDate.ToStdString() << toDate.ToStdString() >>
+        [&](std::string period, int seconds) { totals.push_back(std::make_tuple(wxString(period), seconds)); };
+
+    return totals;
+}
+
+const std::string TaskItemData::beginTransaction = "BEGIN TRANSACTION";
+
+const std::string TaskItemData::commitTransaction = "COMMIT";
+
+const std::string TaskItemData::rollbackTransaction = "ROLLBACK";
+
 const std::string TaskItemData::createTaskItem = "INSERT INTO task_items "
                                                  "(start_time, end_time, duration, description, "
                                                  "billable, calculated_rate, is_active, "
@@ -361,11 +499,43 @@ const std::string TaskItemData::getTaskItemsByDate =
     "WHERE task_date = ? "
     "AND task_items.is_active = 1";
 
+const std::string TaskItemData::getAllTaskItemsByDate =
+    "SELECT task_items.task_item_id, "
+    "tasks.task_date, "
+    "task_items.start_time, "
+    "task_items.end_time, "
+    "task_items.duration, "
+    "task_items.description as description, "
+    "task_items.billable, "
+    "task_items.calculated_rate, "
+    "task_items.date_created, "
+    "task_items.date_modified, "
+    "task_items.is_active, "
+    "task_items.task_item_type_id, "
+    "task_items.project_id, "
+    "task_items.category_id,"
+    "task_items.task_id "
+    "FROM all_task_items AS task_items "
+    "INNER JOIN tasks ON task_items.task_id = tasks.task_id "
+    "INNER JOIN categories ON task_items.category_id = categories.category_id "
+    "INNER JOIN projects ON task_items.project_id = projects.project_id "
+    "INNER JOIN task_item_types ON task_items.task_item_type_id = task_item_types.task_item_type_id "
+    "WHERE task_date = ? "
+    "AND task_items.is_active = 1";
+
 const std::string TaskItemData::getTaskHoursByTaskId = "SELECT task_items.duration "
                                                        "FROM task_items "
                                                        "INNER JOIN tasks ON task_items.task_id = tasks.task_id "
                                                        "WHERE task_date = ?";
 
+/* archived task items include soft deleted ones, so unlike the live query this one checks is_active */
+const std::string TaskItemData::getAllTaskHoursByTaskId = "SELECT task_items.duration "
+                                                          "FROM all_task_items AS task_items "
+                                                          "INNER JOIN tasks ON task_items.task_id = tasks.task_id "
+                                                          "WHERE tasks.task_date >= ? "
+                                                          "AND tasks.task_date <= ? "
+                                                          "AND task_items.is_active = 1";
+
 const std::string TaskItemData::getTaskItemTypeIdByTaskItemId = "SELECT task_items.task_item_type_id "
                                                                 "FROM task_items "
                                                                 "WHERE task_item_id = ?";
@@ -389,4 +559,63 @@ const std::string TaskItemData::getTaskHoursByWeek = "SELECT task_items.duration
                                                      "WHERE tasks.task_date >= ? "
                                                      "AND tasks.task_date <= ? "
                                                      "AND task_items.is_active = 1";
+
+const std::string TaskItemData::getAllTaskHoursByWeek = "SELECT task_items.duration "
+                                                        "FROM all_task_items AS task_items "
+                                                        "INNER JOIN tasks "
+                                                        "ON task_items.task_id = tasks.task_id "
+                                                        "WHERE tasks.task_date >= ? "
+                                                        "AND tasks.task_date <= ? "
+                                                        "AND task_items.is_active = 1";
+
+/* durations are stored as HH:MM:SS, so they are summed up as seconds in the aggregate queries.
+   The period totals are historical reports and include archived task items */
+static const std::string SumOfDurationInSeconds = "SUM(CAST(substr(task_items.duration, 1, 2) AS INTEGER) * 3600 "
+                                                  "+ CAST(substr(task_items.duration, 4, 2) AS INTEGER) * 60 "
+                                                  "+ CAST(substr(task_items.duration, 7, 2) AS INTEGER)) ";
+
+const std::string TaskItemData::getDurationTotalsByYear = "SELECT strftime('%Y', tasks.task_date) AS period, " +
+                                                          SumOfDurationInSeconds +
+                                                          "FROM all_task_items AS task_items "
+                                                          "INNER JOIN tasks "
+                                                          "ON task_items.task_id = tasks.task_id "
+                                                          "WHERE task_items.is_active = 1 "
+                                                          "GROUP BY period "
+                                                          "ORDER BY period";
+
+const std::string TaskItemData::getDurationTotalsByMonth = "SELECT strftime('%Y-%m', tasks.task_date) AS period, " +
+                                                           SumOfDurationInSeconds +
+                                                           "FROM all_task_items AS task_items "
+                                                           "INNER JOIN tasks "
+                                                           "ON task_items.task_id = tasks.task_id "
+                                                           "WHERE tasks.task_date >= ? "
+                                                           "AND tasks.task_date <= ? "
+                                                           "AND task_items.is_active = 1 "
+                                                           "GROUP BY period "
+                                                           "ORDER BY period";
+
+/* weeks are keyed by the ISO date of their monday */
+const std::string TaskItemData::getDurationTotalsByWeek =
+    "SELECT date(tasks.task_date, '-' || ((CAST(strftime('%w', tasks.task_date) AS INTEGER) + 6) % 7) || ' days') "
+    "AS period, " +
+    SumOfDurationInSeconds +
+    "FROM all_task_items AS task_items "
+    "INNER JOIN tasks "
+    "ON task_items.task_id = tasks.task_id "
+    "WHERE tasks.task_date >= ? "
+    "AND tasks.task_date <= ? "
+    "AND task_items.is_active = 1 "
+    "GROUP BY period "
+    "ORDER BY period";
+
+const std::string TaskItemData::getDurationTotalsByDay = "SELECT tasks.task_date AS period, " +
+                                                         SumOfDurationInSeconds +
+                                                         "FROM all_task_items AS task_items "
+                                                         "INNER JOIN tasks "
+                                                         "ON task_items.task_id = tasks.task_id "
+                                                         "WHERE tasks.task_date >= ? "
+                                                         "AND tasks.task_date <= ? "
+                                                         "AND task_items.is_active = 1 "
+                                                         "GROUP BY period "
+                                                         "ORDER BY period";
 } // namespace app::data
@@ -20,12 +20,15 @@
 #pragma once
 
 #include <cstdint>
+#include <tuple>
+#include <vector>
 
+#include <wx/datetime.h>
 #include <wx/string.h>
 
 #include "../database/connectionprovider.h"
 #include "../database/sqliteconnection.h"
-#include "../models/TaskItemModel.h"
+#include "../models/taskitemmodel.h"
 
 namespace app::data
 {
@@ -36,29 +39,62 @@ class TaskItemData final
     ~TaskItemData();
 
     int64_t Create(std::unique_ptr<model::TaskItemModel> taskItem);
+    /*
+     Inserts one timed task item per stopwatch interval, all sharing the details of the given task item,
+     in one transaction. Each interval is filed under the task of its own day. Returns the new ids
+     */
+    std::vector<int64_t> Create(std::unique_ptr<model::TaskItemModel> taskItem,
+        const std::vector<std::tuple<wxDateTime, wxDateTime>>& intervals);
     std::unique_ptr<model::TaskItemModel> GetById(const int taskItemId);
     void Update(std::unique_ptr<model::TaskItemModel> taskItem);
     void Delete(std::unique_ptr<model::TaskItemModel> taskItem);
     void Delete(int taskItemId);
     std::vector<std::unique_ptr<model::TaskItemModel>> GetByDate(const wxString& date);
+    /* same as GetByDate() but includes archived task items, for the read-only historical views */
+    std::vector<std::unique_ptr<model::TaskItemModel>> GetAllByDate(const wxString& date);
     std::vector<wxString> GetHours(const wxString& date);
+    /* same as GetHours() but includes archived task items */
+    std::vector<wxString> GetAllHours(const wxString& date);
     int GetTaskItemTypeIdByTaskItemId(const int taskItemId);
     std::vector<std::unique_ptr<model::TaskItemModel>> GetByWeek(const wxString& fromDate, const wxString& toDate);
     wxString GetDescriptionById(const int taskItemId);
     std::vector<wxString> GetHoursByWeek(const wxString& fromDate, const wxString& toDate);
+    /* same as GetHoursByWeek() but includes archived task items */
+    std::vector<wxString> GetAllHoursByWeek(const wxString& fromDate, const wxString& toDate);
+
+    /* Period totals are returned as (period key, total seconds) pairs ordered by period key */
+    std::vector<std::tuple<wxString, int>> GetDurationTotalsByYear();
+    std::vector<std::tuple<wxString, int>> GetDurationTotalsByMonth(const wxString& fromDate, const wxString& toDate);
+    std::vector<std::tuple<wxString, int>> GetDurationTotalsByWeek(const wxString& fromDate, const wxString& toDate);
+    std::vector<std::tuple<wxString, int>> GetDurationTotalsByDay(const wxString& fromDate, const wxString& toDate);
 
 private:
+    int64_t Insert(model::TaskItemModel* taskItem);
+    std::vector<std::unique_ptr<model::TaskItemModel>> SelectByDate(const std::string& statement,
+        const wxString& date);
+    std::vector<wxString> SelectHours(const std::string& statement, const wxString& fromDate, const wxString& toDate);
+
     std::shared_ptr<db::SqliteConnection> pConnection;
 
+    static const std::string beginTransaction;
+    static const std::string commitTransaction;
+    static const std::string rollbackTransaction;
     static const std::string createTaskItem;
     static const std::string getTaskItemsByDate;
+    static const std::string getAllTaskItemsByDate;
     static const std::string getTaskItemById;
     static const std::string updateTaskItem;
     static const std::string deleteTaskItem;
     static const std::string getTaskHoursByTaskId;
+    static const std::string getAllTaskHoursByTaskId;
     static const std::string getTaskItemTypeIdByTaskItemId;
     static const std::string getTaskItemsByWeek;
     static const std::string getDescriptionById;
     static const std::string getTaskHoursByWeek;
+    static const std::string getAllTaskHoursByWeek;
+    static const std::string getDurationTotalsByYear;
+    static const std::string getDurationTotalsByMonth;
+    static const std::string getDurationTotalsByWeek;
+    static const std::string getDurationTotalsByDay;
 };
 }
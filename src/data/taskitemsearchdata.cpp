@@ -0,0 +1,195 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "taskitemsearchdata.h"
+
+#include <spdlog/spdlog.h>
+#include <wx/tokenzr.h>
+
+#include "../common/logging.h"
+
+namespace app::data
+{
+TaskItemSearchData::TaskItemSearchData()
+{
+    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in TaskItemSearchData|ConnectionTally: {0:d}",
+        db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
+}
+
+TaskItemSearchData::~TaskItemSearchData()
+{
+    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in TaskItemSearchData|ConnectionTally: {0:d}",
+        db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
+}
+
+std::vector<TaskItemSearchResult> TaskItemSearchData::Search(const TaskItemSearchQuery& query)
+{
+    std::vector<TaskItemSearchResult> results;
+
+    auto matchExpression = CreateMatchExpression(query.mText);
+    if (matchExpression.empty()) {
+        return results;
+    }
+
+    /* without the archive attached only the live index can be queried */
+    const auto& statement =
+        pConnection->HasArchive() ? TaskItemSearchData::searchAllTaskItems : TaskItemSearchData::searchTaskItems;
+
+    *pConnection->DatabaseExecutableHandle()
+            << statement << matchExpression << query.mFromDate.ToStdString()
+            << query.mToDate.ToStdString() << query.mProjectId << query.mLimit << query.mOffset >>
+        [&](int taskItemId,
+            std::string taskDate,
+            std::string project,
+            std::string category,
+            std::string duration,
+            std::string snippet,
+            double rank) {
+            results.push_back(TaskItemSearchResult{ taskItemId,
+                wxString(taskDate),
+                wxString(project),
+                wxString(category),
+                wxString(duration),
+                wxString(snippet),
+                rank });
+        };
+
+    return results;
+}
+
+int TaskItemSearchData::Count(const TaskItemSearchQuery& query)
+{
+    int count = 0;
+
+    auto matchExpression = CreateMatchExpression(query.mText);
+    if (matchExpression.empty()) {
+        return count;
+    }
+
+    const auto& statement =
+        pConnection->HasArchive() ? TaskItemSearchData::countAllTaskItems : TaskItemSearchData::countTaskItems;
+
+    *pConnection->DatabaseExecutableHandle() << statement << matchExpression << query.mFromDate.ToStdString()
+                                             << query.mToDate.ToStdString() << query.mProjectId >>
+        count;
+
+    return count;
+}
+
+std::string TaskItemSearchData::CreateMatchExpression(const wxString& text)
+{
+    /* every word is quoted so punctuation typed by the user is never read as FTS5 query syntax */
+    wxString expression;
+    wxStringTokenizer tokenizer(text, wxT(" \t\r\n"), wxTOKEN_STRTOK);
+    while (tokenizer.HasMoreTokens()) {
+        auto word = tokenizer.GetNextToken();
+        word.Replace(wxT("\""), wxT("\"\""));
+
+        if (!expression.empty()) {
+            expression += wxT(" ");
+        }
+        expression += wxString::Format(wxT("\"%s\""), word);
+        if (!tokenizer.HasMoreTokens()) {
+            expression += wxT("*");
+        }
+    }
+    return expression.ToStdString();
+}
+
+const std::string TaskItemSearchData::searchTaskItems =
+    "SELECT task_items.task_item_id, "
+    "tasks.task_date, "
+    "projects.display_name, "
+    "categories.name, "
+    "task_items.duration, "
+    "snippet(task_items_search, -1, '[', ']', '...', 12), "
+    "bm25(task_items_search, 4.0, 1.0, 1.0) AS rank "
+    "FROM task_items_search "
+    "INNER JOIN task_items ON task_items_search.rowid = task_items.task_item_id "
+    "INNER JOIN tasks ON task_items.task_id = tasks.task_id "
+    "INNER JOIN projects ON task_items.project_id = projects.project_id "
+    "INNER JOIN categories ON task_items.category_id = categories.category_id "
+    "WHERE task_items_search MATCH ?1 "
+    "AND (?2 = '' OR tasks.task_date >= ?2) "
+    "AND (?3 = '' OR tasks.task_date <= ?3) "
+    "AND (?4 = 0 OR task_items.project_id = ?4) "
+    "AND task_items.is_active = 1 "
+    "ORDER BY rank, tasks.task_date DESC "
+    "LIMIT ?5 OFFSET ?6";
+
+const std::string TaskItemSearchData::countTaskItems =
+    "SELECT COUNT(*) "
+    "FROM task_items_search "
+    "INNER JOIN task_items ON task_items_search.rowid = task_items.task_item_id "
+    "INNER JOIN tasks ON task_items.task_id = tasks.task_id "
+    "WHERE task_items_search MATCH ?1 "
+    "AND (?2 = '' OR tasks.task_date >= ?2) "
+    "AND (?3 = '' OR tasks.task_date <= ?3) "
+    "AND (?4 = 0 OR task_items.project_id = ?4) "
+    "AND task_items.is_active = 1";
+
+/* archived task items are matched in the index of the archive database. Both indexes rank with bm25 on their own
+   statistics, which is close enough to interleave the two result sets */
+static const std::string AllTaskItemsMatches =
+    "(SELECT rowid AS task_item_id, "
+    "snippet(task_items_search, -1, '[', ']', '...', 12) AS snippet, "
+    "bm25(task_items_search, 4.0, 1.0, 1.0) AS rank "
+    "FROM main.task_items_search "
+    "WHERE task_items_search MATCH ?1 "
+    "UNION ALL "
+    "SELECT rowid AS task_item_id, "
+    "snippet(archived_task_items_search, -1, '[', ']', '...', 12) AS snippet, "
+    "bm25(archived_task_items_search, 4.0, 1.0, 1.0) AS rank "
+    "FROM archive.archived_task_items_search "
+    "WHERE archived_task_items_search MATCH ?1) AS matches ";
+
+const std::string TaskItemSearchData::searchAllTaskItems =
+    "SELECT all_task_items.task_item_id, "
+    "tasks.task_date, "
+    "projects.display_name, "
+    "categories.name, "
+    "all_task_items.duration, "
+    "matches.snippet, "
+    "matches.rank "
+    "FROM " +
+    AllTaskItemsMatches +
+    "INNER JOIN all_task_items ON matches.task_item_id = all_task_items.task_item_id "
+    "INNER JOIN tasks ON all_task_items.task_id = tasks.task_id "
+    "INNER JOIN projects ON all_task_items.project_id = projects.project_id "
+    "INNER JOIN categories ON all_task_items.category_id = categories.category_id "
+    "WHERE (?2 = '' OR tasks.task_date >= ?2) "
+    "AND (?3 = '' OR tasks.task_date <= ?3) "
+    "AND (?4 = 0 OR all_task_items.project_id = ?4) "
+    "AND all_task_items.is_active = 1 "
+    "ORDER BY matches.rank, tasks.task_date DESC "
+    "LIMIT ?5 OFFSET ?6";
+
+const std::string TaskItemSearchData::countAllTaskItems =
+    "SELECT COUNT(*) "
+    "FROM " +
+    AllTaskItemsMatches +
+    "INNER JOIN all_task_items ON matches.task_item_id = all_task_items.task_item_id "
+    "INNER JOIN tasks ON all_task_items.task_id = tasks.task_id "
+    "WHERE (?2 = '' OR tasks.task_date >= ?2) "
+    "AND (?3 = '' OR tasks.task_date <= ?3) "
+    "AND (?4 = 0 OR all_task_items.project_id = ?4) "
+    "AND all_task_items.is_active = 1";
+} // namespace app::data
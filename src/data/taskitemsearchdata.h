@@ -0,0 +1,82 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+
+namespace app::data
+{
+struct TaskItemSearchQuery {
+    /* words to look for, the last one is matched as a prefix */
+    wxString mText;
+    /* ISO dates bounding the task date, empty for no bound */
+    wxString mFromDate;
+    wxString mToDate;
+    /* 0 for all projects */
+    int mProjectId;
+    int mOffset;
+    int mLimit;
+};
+
+struct TaskItemSearchResult {
+    int mTaskItemId;
+    wxString mTaskDate;
+    wxString mProject;
+    wxString mCategory;
+    wxString mDuration;
+    /* matching text with the matched words in [brackets] */
+    wxString mSnippet;
+    /* bm25 score, lower is a better match */
+    double mRank;
+};
+
+/*
+ Queries the full-text index kept by SearchIndex. Results are ranked by relevance with matches in the
+ description weighted above matches in the project or category name, most recent first between equals,
+ and only active task items are returned. Archived task items are searched through the index the archive
+ step keeps in the archive database
+ */
+class TaskItemSearchData final
+{
+public:
+    TaskItemSearchData();
+    ~TaskItemSearchData();
+
+    std::vector<TaskItemSearchResult> Search(const TaskItemSearchQuery& query);
+    int Count(const TaskItemSearchQuery& query);
+
+    static std::string CreateMatchExpression(const wxString& text);
+
+private:
+    std::shared_ptr<db::SqliteConnection> pConnection;
+
+    static const std::string searchTaskItems;
+    static const std::string countTaskItems;
+    static const std::string searchAllTaskItems;
+    static const std::string countAllTaskItems;
+};
+} // namespace app::data
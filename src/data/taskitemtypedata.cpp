@@ -23,19 +23,21 @@
 
 #include <wx/string.h>
 
+#include "../common/logging.h"
+
 namespace app::data
 {
 TaskItemTypeData::TaskItemTypeData()
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
-    spdlog::get("msvc")->debug("ACQUIRE connection in TaskItemTypeData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "ACQUIRE connection in TaskItemTypeData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
 TaskItemTypeData::~TaskItemTypeData()
 {
     db::ConnectionProvider::Get().Handle()->Release(pConnection);
-    spdlog::get("msvc")->debug("RELEASE connection in TaskItemTypeData|ConnectionTally: {0:d}",
+    SPDLOG_LOGGER_DEBUG(common::GetTraceLogger(), "RELEASE connection in TaskItemTypeData|ConnectionTally: {0:d}",
         db::ConnectionProvider::Get().Handle()->ConnectionsInUse());
 }
 
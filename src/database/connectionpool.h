@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <deque>
 #include <memory>
@@ -36,11 +37,16 @@ class ConnectionPool final
 public:
     ConnectionPool() = delete;
     ConnectionPool(std::shared_ptr<IConnectionFactory> factory, std::size_t poolSize);
+    /* opens only initialSize connections up front, the rest are opened on demand or by WarmUp() */
+    ConnectionPool(std::shared_ptr<IConnectionFactory> factory, std::size_t poolSize, std::size_t initialSize);
     ~ConnectionPool();
 
     std::shared_ptr<T> Acquire();
     void Release(std::shared_ptr<T> connection);
 
+    /* opens connections until the pool holds its full size */
+    void WarmUp();
+
     const std::size_t ConnectionsInUse() const;
 
 private:
@@ -52,12 +58,20 @@ class ConnectionPool final
 
 template<class T>
 inline ConnectionPool<T>::ConnectionPool(std::shared_ptr<IConnectionFactory> factory, std::size_t poolSize)
+    : ConnectionPool(factory, poolSize, poolSize)
+{
+}
+
+template<class T>
+inline ConnectionPool<T>::ConnectionPool(std::shared_ptr<IConnectionFactory> factory,
+    std::size_t poolSize,
+    std::size_t initialSize)
     : pFactory(factory)
     , mPoolSize(poolSize)
     , mPool()
     , mConnectionsInUse(0)
 {
-    while (mPool.size() < mPoolSize) {
+    while (mPool.size() < std::min(initialSize, mPoolSize)) {
         mPool.push_back(pFactory->Create());
     }
 }
@@ -92,6 +106,15 @@ inline void ConnectionPool<T>::Release(std::shared_ptr<T> connection)
     mPool.push_back(std::dynamic_pointer_cast<IConnection>(connection));
     mConnectionsInUse--;
 }
+
+template<class T>
+inline void ConnectionPool<T>::WarmUp()
+{
+    while (mPool.size() + mConnectionsInUse < mPoolSize) {
+        mPool.push_back(pFactory->Create());
+    }
+}
+
 template<class T>
 inline const std::size_t ConnectionPool<T>::ConnectionsInUse() const
 {
@@ -19,14 +19,29 @@
 
 #include "connectionprovider.h"
 
+#include "sqliteconnectionfactory.h"
+
 namespace app::db
 {
+static const std::size_t ConnectionPoolSize = 14;
+static const std::size_t InitialConnectionCount = 2;
+
 ConnectionProvider& ConnectionProvider::Get()
 {
     static ConnectionProvider instance;
     return instance;
 }
 
+/* only a few connections are opened up front, the rest on demand or by ConnectionPool::WarmUp() */
+std::unique_ptr<ConnectionPool<SqliteConnection>> ConnectionProvider::CreateConnectionPool(
+    const std::string& databaseFilePath,
+    const std::string& archiveFilePath)
+{
+    auto sqliteConnectionFactory = std::make_shared<SqliteConnectionFactory>(databaseFilePath, archiveFilePath);
+    return std::make_unique<ConnectionPool<SqliteConnection>>(
+        sqliteConnectionFactory, ConnectionPoolSize, InitialConnectionCount);
+}
+
 /*
  This function should only ever be called once as the connection pool cannot be re-initialized once the
  connection pool is set
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include "sqliteconnection.h"
 #include "connectionpool.h"
@@ -34,6 +35,10 @@ class ConnectionProvider
     ConnectionProvider(const ConnectionProvider&) = delete;
     ConnectionProvider& operator=(const ConnectionProvider&) = delete;
 
+    /* an empty archive file path opens the connections on the live database alone */
+    static std::unique_ptr<ConnectionPool<SqliteConnection>> CreateConnectionPool(const std::string& databaseFilePath,
+        const std::string& archiveFilePath);
+
     void InitializeConnectionPool(std::unique_ptr<ConnectionPool<SqliteConnection>> connectionPool);
     void ReInitializeConnectionPool(std::unique_ptr<ConnectionPool<SqliteConnection>> newConnectionPool);
     void PurgeConnectionPool();
@@ -0,0 +1,174 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "querystatistics.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+namespace app::db
+{
+static const std::array<std::int64_t, QueryLatencyBucketCount - 1> BucketUpperBounds = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000
+};
+static const std::size_t StatementSummaryLength = 100;
+
+/* collapses the whitespace of a statement and shortens it to fit on one log line */
+static std::string SummarizeStatement(const std::string& statement)
+{
+    std::string summary;
+    for (char character : statement) {
+        bool isSpace = std::isspace(static_cast<unsigned char>(character)) != 0;
+        if (isSpace && (summary.empty() || summary.back() == ' ')) {
+            continue;
+        }
+        summary.push_back(isSpace ? ' ' : character);
+    }
+
+    if (summary.size() > StatementSummaryLength) {
+        summary = summary.substr(0, StatementSummaryLength - 3) + "...";
+    }
+    return summary;
+}
+
+QueryStatisticsEntry::QueryStatisticsEntry()
+    : mStatement()
+    , mCount(0)
+    , mRows(0)
+    , mTotalNanoseconds(0)
+    , mMaxNanoseconds(0)
+    , mHistogram()
+{
+}
+
+std::int64_t QueryStatisticsEntry::GetPercentileMicroseconds(double percentile) const
+{
+    auto target = static_cast<std::int64_t>(percentile * mCount);
+    std::int64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < BucketUpperBounds.size(); bucket++) {
+        seen += mHistogram[bucket];
+        if (seen > target) {
+            return BucketUpperBounds[bucket];
+        }
+    }
+    return mMaxNanoseconds / 1000;
+}
+
+QueryStatistics& QueryStatistics::Get()
+{
+    static QueryStatistics instance;
+    return instance;
+}
+
+void QueryStatistics::SetEnabled(bool enabled)
+{
+    bEnabled = enabled;
+}
+
+bool QueryStatistics::IsEnabled() const
+{
+    return bEnabled;
+}
+
+void QueryStatistics::Record(const char* statement, std::int64_t rows, std::int64_t nanoseconds)
+{
+    if (!bEnabled || statement == nullptr) {
+        return;
+    }
+
+    auto microseconds = nanoseconds / 1000;
+    auto bucket = static_cast<std::size_t>(
+        std::lower_bound(BucketUpperBounds.begin(), BucketUpperBounds.end(), microseconds) - BucketUpperBounds.begin());
+
+    mTotalCount++;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto found = mEntries.find(std::string_view(statement));
+    if (found == mEntries.end()) {
+        found = mEntries.emplace(statement, QueryStatisticsEntry()).first;
+        found->second.mStatement = statement;
+    }
+
+    auto& entry = found->second;
+    entry.mCount++;
+    entry.mRows += rows;
+    entry.mTotalNanoseconds += nanoseconds;
+    entry.mMaxNanoseconds = std::max(entry.mMaxNanoseconds, nanoseconds);
+    entry.mHistogram[bucket]++;
+}
+
+void QueryStatistics::Reset()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mEntries.clear();
+    mTotalCount = 0;
+}
+
+std::int64_t QueryStatistics::GetTotalCount() const
+{
+    return mTotalCount;
+}
+
+std::vector<QueryStatisticsEntry> QueryStatistics::GetEntries() const
+{
+    std::vector<QueryStatisticsEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        entries.reserve(mEntries.size());
+        for (const auto& [statement, entry] : mEntries) {
+            entries.push_back(entry);
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const QueryStatisticsEntry& lhs, const QueryStatisticsEntry& rhs) {
+        return lhs.mTotalNanoseconds > rhs.mTotalNanoseconds;
+    });
+    return entries;
+}
+
+void QueryStatistics::LogSummary(std::shared_ptr<spdlog::logger> logger, std::size_t limit) const
+{
+    auto entries = GetEntries();
+    logger->info("Query statistics: {0:d} statements recorded, {1:d} distinct", GetTotalCount(), entries.size());
+
+    if (limit > 0 && entries.size() > limit) {
+        entries.resize(limit);
+    }
+    for (const auto& entry : entries) {
+        logger->info("{0:>8d} calls {1:>9d} rows {2:>10.2f} ms total {3:>8d} us p50 {4:>8d} us p95 "
+                     "{5:>8.2f} ms max | {6}",
+            entry.mCount,
+            entry.mRows,
+            entry.mTotalNanoseconds / 1000000.0,
+            entry.GetPercentileMicroseconds(0.5),
+            entry.GetPercentileMicroseconds(0.95),
+            entry.mMaxNanoseconds / 1000000.0,
+            SummarizeStatement(entry.mStatement));
+    }
+}
+
+QueryStatistics::QueryStatistics()
+    : bEnabled(false)
+    , mTotalCount(0)
+    , mMutex()
+    , mEntries()
+{
+}
+} // namespace app::db
@@ -0,0 +1,90 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace app::db
+{
+/* latency buckets from 50us to 100ms, the last bucket holds everything slower */
+const std::size_t QueryLatencyBucketCount = 12;
+
+struct QueryStatisticsEntry {
+    QueryStatisticsEntry();
+
+    std::string mStatement;
+    std::int64_t mCount;
+    std::int64_t mRows;
+    std::int64_t mTotalNanoseconds;
+    std::int64_t mMaxNanoseconds;
+    std::array<std::int64_t, QueryLatencyBucketCount> mHistogram;
+
+    /* upper bound in microseconds of the bucket the given percentile (0-1) falls in */
+    std::int64_t GetPercentileMicroseconds(double percentile) const;
+};
+
+/*
+ Execution count, rows returned and a latency histogram per SQL statement run on a pooled connection.
+ Statements are keyed by their SQL text, which for the data classes is one of their static query strings.
+ SqliteConnection feeds it from its sqlite3_trace_v2 callback; recording is off unless enabled
+ */
+class QueryStatistics final
+{
+public:
+    static QueryStatistics& Get();
+
+    QueryStatistics(const QueryStatistics&) = delete;
+    QueryStatistics& operator=(const QueryStatistics&) = delete;
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    void Record(const char* statement, std::int64_t rows, std::int64_t nanoseconds);
+    void Reset();
+
+    /* statements recorded since the last reset */
+    std::int64_t GetTotalCount() const;
+    /* entries ordered by total time spent, most expensive first */
+    std::vector<QueryStatisticsEntry> GetEntries() const;
+
+    /* logs the most expensive statements at info level, limit 0 logs all of them */
+    void LogSummary(std::shared_ptr<spdlog::logger> logger, std::size_t limit) const;
+
+private:
+    QueryStatistics();
+
+    std::atomic<bool> bEnabled;
+    std::atomic<std::int64_t> mTotalCount;
+
+    mutable std::mutex mMutex;
+    /* transparent comparison so recording a known statement does not allocate */
+    std::map<std::string, QueryStatisticsEntry, std::less<>> mEntries;
+};
+} // namespace app::db
@@ -19,11 +19,17 @@
 
 #include "sqliteconnection.h"
 
+#include <algorithm>
+
+#include "querystatistics.h"
+
 namespace app::db
 {
-SqliteConnection::SqliteConnection(std::string connectionString)
+SqliteConnection::SqliteConnection(std::string connectionString, std::string archiveConnectionString)
     : mConnectionString(connectionString)
+    , mArchiveConnectionString(archiveConnectionString)
     , pDatabase(nullptr)
+    , mRowCounts()
 {
 }
 
@@ -36,10 +42,116 @@ void SqliteConnection::Connect()
 {
     auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READWRITE, nullptr, sqlite::Encoding::UTF8 };
     pDatabase = new sqlite::database(mConnectionString, config);
+
+    /* the trace stays installed, QueryStatistics can be switched on and off at any time */
+    sqlite3_trace_v2(
+        pDatabase->connection().get(), SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, &SqliteConnection::Trace, this);
+
+    /* attachments and temp views are per connection, so every pooled connection sees the archive */
+    if (!mArchiveConnectionString.empty()) {
+        *pDatabase << SqliteConnection::attachArchive << mArchiveConnectionString;
+        *pDatabase << SqliteConnection::createAllTaskItemsView;
+        for (const auto& statement : SqliteConnection::createArchiveSearchTriggers) {
+            *pDatabase << statement;
+        }
+    } else {
+        *pDatabase << SqliteConnection::createLiveTaskItemsView;
+    }
 }
 
 sqlite::database* SqliteConnection::DatabaseExecutableHandle()
 {
     return pDatabase;
 }
+
+bool SqliteConnection::HasArchive() const
+{
+    return !mArchiveConnectionString.empty();
+}
+
+int SqliteConnection::GetSchemaVersion()
+{
+    int schemaVersion = 0;
+    *pDatabase << "PRAGMA main.user_version;" >> schemaVersion;
+    return schemaVersion;
+}
+
+/* PRAGMA does not take bound parameters, the version is an integer so it is formatted into the statement */
+void SqliteConnection::RaiseSchemaVersion(int schemaVersion)
+{
+    if (GetSchemaVersion() < schemaVersion) {
+        *pDatabase << "PRAGMA main.user_version = " + std::to_string(schemaVersion) + ";";
+    }
+}
+
+int SqliteConnection::Trace(unsigned int type, void* context, void* statement, void* data)
+{
+    auto connection = static_cast<SqliteConnection*>(context);
+    auto preparedStatement = static_cast<sqlite3_stmt*>(statement);
+
+    if (!QueryStatistics::Get().IsEnabled()) {
+        if (!connection->mRowCounts.empty()) {
+            connection->mRowCounts.clear();
+        }
+        return 0;
+    }
+
+    auto& rowCounts = connection->mRowCounts;
+    auto rowCount = std::find_if(rowCounts.begin(), rowCounts.end(), [&](const auto& running) {
+        return running.first == preparedStatement;
+    });
+
+    if (type == SQLITE_TRACE_ROW) {
+        if (rowCount == rowCounts.end()) {
+            rowCounts.emplace_back(preparedStatement, 1);
+        } else {
+            rowCount->second++;
+        }
+    } else if (type == SQLITE_TRACE_PROFILE) {
+        std::int64_t rows = 0;
+        if (rowCount != rowCounts.end()) {
+            rows = rowCount->second;
+            rowCounts.erase(rowCount);
+        }
+
+        auto nanoseconds = *static_cast<sqlite3_int64*>(data);
+        QueryStatistics::Get().Record(sqlite3_sql(preparedStatement), rows, nanoseconds);
+    }
+    return 0;
+}
+
+const std::string SqliteConnection::attachArchive = "ATTACH DATABASE ? AS archive";
+
+/* a view in the main schema cannot reference an attached database, hence TEMP */
+const std::string SqliteConnection::createAllTaskItemsView =
+    "CREATE TEMP VIEW all_task_items AS "
+    "SELECT task_item_id, start_time, end_time, duration, description, billable, calculated_rate, "
+    "date_created, date_modified, is_active, task_item_type_id, project_id, task_id, category_id "
+    "FROM main.task_items "
+    "UNION ALL "
+    "SELECT task_item_id, start_time, end_time, duration, description, billable, calculated_rate, "
+    "date_created, date_modified, is_active, task_item_type_id, project_id, task_id, category_id "
+    "FROM archive.task_items";
+
+const std::string SqliteConnection::createLiveTaskItemsView =
+    "CREATE TEMP VIEW all_task_items AS "
+    "SELECT task_item_id, start_time, end_time, duration, description, billable, calculated_rate, "
+    "date_created, date_modified, is_active, task_item_type_id, project_id, task_id, category_id "
+    "FROM main.task_items";
+
+/* the archive search index stores the project and category names of archived task items, a trigger in the main
+   schema cannot reach it so renames are applied by TEMP triggers on every connection */
+const std::vector<std::string> SqliteConnection::createArchiveSearchTriggers = {
+    "CREATE TEMP TRIGGER archive_search_project_update AFTER UPDATE OF display_name ON main.projects "
+    "WHEN old.display_name <> new.display_name BEGIN "
+    "UPDATE archived_task_items_search SET project = new.display_name "
+    "WHERE rowid IN (SELECT task_item_id FROM archive.task_items WHERE project_id = new.project_id); "
+    "END",
+
+    "CREATE TEMP TRIGGER archive_search_category_update AFTER UPDATE OF name ON main.categories "
+    "WHEN old.name <> new.name BEGIN "
+    "UPDATE archived_task_items_search SET category = new.name "
+    "WHERE rowid IN (SELECT task_item_id FROM archive.task_items WHERE category_id = new.category_id); "
+    "END"
+};
 } // namespace app::db
@@ -19,7 +19,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <sqlite_modern_cpp.h>
 
@@ -30,16 +33,35 @@ namespace app::db
 class SqliteConnection final : public IConnection
 {
 public:
-    SqliteConnection(std::string connectionString);
+    SqliteConnection(std::string connectionString, std::string archiveConnectionString);
     virtual ~SqliteConnection();
 
     void Connect();
 
     sqlite::database* DatabaseExecutableHandle();
 
+    /* whether the archive database is attached as "archive" */
+    bool HasArchive() const;
+
+    int GetSchemaVersion();
+    void RaiseSchemaVersion(int schemaVersion);
+
 private:
+    /* sqlite3_trace_v2 callback that feeds QueryStatistics */
+    static int Trace(unsigned int type, void* context, void* statement, void* data);
+
     std::string mConnectionString;
+    std::string mArchiveConnectionString;
 
     sqlite::database* pDatabase;
+
+    /* rows stepped so far per running statement, recorded once the statement finishes.
+       Only a few statements run at once on a connection and the vector keeps its capacity */
+    std::vector<std::pair<sqlite3_stmt*, std::int64_t>> mRowCounts;
+
+    static const std::string attachArchive;
+    static const std::string createAllTaskItemsView;
+    static const std::string createLiveTaskItemsView;
+    static const std::vector<std::string> createArchiveSearchTriggers;
 };
 } // namespace app::db
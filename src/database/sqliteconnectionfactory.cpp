@@ -23,14 +23,15 @@
 
 namespace app::db
 {
-SqliteConnectionFactory::SqliteConnectionFactory(std::string connectionString)
+SqliteConnectionFactory::SqliteConnectionFactory(std::string connectionString, std::string archiveConnectionString)
     : mConnectionString(connectionString)
+    , mArchiveConnectionString(archiveConnectionString)
 {
 }
 
 std::shared_ptr<IConnection> SqliteConnectionFactory::Create()
 {
-    auto connection = std::make_shared<SqliteConnection>(mConnectionString);
+    auto connection = std::make_shared<SqliteConnection>(mConnectionString, mArchiveConnectionString);
     connection->Connect();
     return std::dynamic_pointer_cast<IConnection>(connection);
 }
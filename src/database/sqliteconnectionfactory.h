@@ -29,11 +29,12 @@ namespace app::db
 class SqliteConnectionFactory final : public IConnectionFactory
 {
 public:
-    SqliteConnectionFactory(std::string connectionString);
+    SqliteConnectionFactory(std::string connectionString, std::string archiveConnectionString);
 
     virtual std::shared_ptr<IConnection> Create();
 
 private:
     std::string mConnectionString;
+    std::string mArchiveConnectionString;
 };
 } // namespace app::db
@@ -0,0 +1,416 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "periodmodel.h"
+
+#include <algorithm>
+
+#include <sqlite_modern_cpp/errors.h>
+
+#include "../data/taskitemdata.h"
+
+namespace app::dv
+{
+const wxString WeekPeriodLabel = wxT("Week %s - %s");
+const wxString DayPeriodLabel = wxT("%s %s");
+const wxString MonthPeriodLabel = wxT("%s %d");
+
+static wxString FormatSeconds(int seconds)
+{
+    return wxTimeSpan::Seconds(seconds).Format();
+}
+
+static wxDateTime ParseISODate(const wxString& date)
+{
+    wxDateTime dateTime;
+    dateTime.ParseISODate(date);
+    return dateTime;
+}
+
+PeriodTreeModelNode::PeriodTreeModelNode(PeriodTreeModelNode* parent,
+    PeriodLevel level,
+    const wxString& label,
+    const wxString& fromDate,
+    const wxString& toDate,
+    const wxString& duration)
+    : pParent(parent)
+    , mChildren()
+    , mLevel(level)
+    , mLabel(label)
+    , mFromDate(fromDate)
+    , mToDate(toDate)
+    , mDuration(duration)
+    , mTaskItemId(-1)
+    , bLoaded(false)
+{
+}
+
+PeriodTreeModelNode::PeriodTreeModelNode(PeriodTreeModelNode* parent,
+    const wxString& projectName,
+    const wxString& duration,
+    const wxString& categoryName,
+    const wxString& description,
+    int taskItemId)
+    : pParent(parent)
+    , mChildren()
+    , mLevel(PeriodLevel::Item)
+    , mLabel(projectName)
+    , mDuration(duration)
+    , mCategoryName(categoryName)
+    , mDescription(description)
+    , mTaskItemId(taskItemId)
+    , bLoaded(true)
+{
+}
+
+bool PeriodTreeModelNode::IsContainer() const
+{
+    return mLevel != PeriodLevel::Item;
+}
+
+bool PeriodTreeModelNode::IsLoaded() const
+{
+    return bLoaded;
+}
+
+PeriodLevel PeriodTreeModelNode::GetLevel() const
+{
+    return mLevel;
+}
+
+PeriodTreeModelNode* PeriodTreeModelNode::GetParent()
+{
+    return pParent;
+}
+
+std::vector<std::unique_ptr<PeriodTreeModelNode>>& PeriodTreeModelNode::GetChildren()
+{
+    return mChildren;
+}
+
+void PeriodTreeModelNode::Append(std::unique_ptr<PeriodTreeModelNode> child)
+{
+    mChildren.push_back(std::move(child));
+}
+
+void PeriodTreeModelNode::MarkLoaded()
+{
+    bLoaded = true;
+}
+
+void PeriodTreeModelNode::Unload()
+{
+    mChildren.clear();
+    bLoaded = false;
+}
+
+wxString PeriodTreeModelNode::GetLabel() const
+{
+    return mLabel;
+}
+
+wxString PeriodTreeModelNode::GetFromDate() const
+{
+    return mFromDate;
+}
+
+wxString PeriodTreeModelNode::GetToDate() const
+{
+    return mToDate;
+}
+
+wxString PeriodTreeModelNode::GetDuration() const
+{
+    return mDuration;
+}
+
+wxString PeriodTreeModelNode::GetCategoryName() const
+{
+    return mCategoryName;
+}
+
+wxString PeriodTreeModelNode::GetDescription() const
+{
+    return mDescription;
+}
+
+int PeriodTreeModelNode::GetTaskItemId() const
+{
+    return mTaskItemId;
+}
+
+// PeriodTreeModel
+PeriodTreeModel::PeriodTreeModel(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+    , pRoot(std::make_unique<PeriodTreeModelNode>(
+          nullptr, PeriodLevel::Root, wxGetEmptyString(), wxGetEmptyString(), wxGetEmptyString(), wxGetEmptyString()))
+{
+}
+
+unsigned int PeriodTreeModel::GetColumnCount() const
+{
+    return Col_Max;
+}
+
+wxString PeriodTreeModel::GetColumnType(unsigned int col) const
+{
+    if (col == Col_Id) {
+        return "long";
+    } else {
+        return "string";
+    }
+}
+
+void PeriodTreeModel::GetValue(wxVariant& variant, const wxDataViewItem& item, unsigned int col) const
+{
+    wxASSERT(item.IsOk());
+
+    PeriodTreeModelNode* node = (PeriodTreeModelNode*) item.GetID();
+    switch (col) {
+    case Col_Period:
+        variant = node->GetLabel();
+        break;
+    case Col_Duration:
+        variant = node->GetDuration();
+        break;
+    case Col_Category:
+        variant = node->GetCategoryName();
+        break;
+    case Col_Description:
+        variant = node->GetDescription();
+        break;
+    case Col_Id:
+        variant = (long) node->GetTaskItemId();
+        break;
+    case Col_Max:
+    default:
+        wxLogError("PeriodTreeModel::GetValue: wrong column %d", col);
+        break;
+    }
+}
+
+bool PeriodTreeModel::SetValue(const wxVariant& variant, const wxDataViewItem& item, unsigned int col)
+{
+    /* the period tree is a read only view over the aggregated task items */
+    return false;
+}
+
+bool PeriodTreeModel::IsEnabled(const wxDataViewItem& item, unsigned int col) const
+{
+    return true;
+}
+
+wxDataViewItem PeriodTreeModel::GetParent(const wxDataViewItem& item) const
+{
+    if (!item.IsOk()) {
+        return wxDataViewItem(0);
+    }
+
+    PeriodTreeModelNode* node = (PeriodTreeModelNode*) item.GetID();
+    if (node->GetParent() == pRoot.get()) {
+        return wxDataViewItem(0);
+    }
+
+    return wxDataViewItem((void*) node->GetParent());
+}
+
+bool PeriodTreeModel::IsContainer(const wxDataViewItem& item) const
+{
+    if (!item.IsOk()) {
+        return true;
+    }
+
+    PeriodTreeModelNode* node = (PeriodTreeModelNode*) item.GetID();
+    return node->IsContainer();
+}
+
+unsigned int PeriodTreeModel::GetChildren(const wxDataViewItem& parent, wxDataViewItemArray& array) const
+{
+    PeriodTreeModelNode* node = (PeriodTreeModelNode*) parent.GetID();
+    if (!node) {
+        node = pRoot.get();
+    }
+
+    if (!node->IsLoaded()) {
+        LoadChildren(node);
+    }
+
+    auto& children = node->GetChildren();
+    for (auto& child : children) {
+        array.Add(wxDataViewItem((void*) child.get()));
+    }
+
+    return children.size();
+}
+
+void PeriodTreeModel::Reload()
+{
+    pRoot->Unload();
+    Cleared();
+}
+
+wxDateTime PeriodTreeModel::GetDateFromDataViewItem(const wxDataViewItem& item) const
+{
+    if (!item.IsOk()) {
+        return wxDateTime::Now();
+    }
+
+    PeriodTreeModelNode* node = (PeriodTreeModelNode*) item.GetID();
+    if (node->GetLevel() == PeriodLevel::Item) {
+        node = node->GetParent();
+    }
+
+    if (node->GetLevel() != PeriodLevel::Day) {
+        return wxDateTime::Now();
+    }
+
+    return ParseISODate(node->GetFromDate());
+}
+
+int PeriodTreeModel::GetTaskItemIdFromDataViewItem(const wxDataViewItem& item) const
+{
+    if (!item.IsOk()) {
+        return -1;
+    }
+
+    PeriodTreeModelNode* node = (PeriodTreeModelNode*) item.GetID();
+    return node->GetTaskItemId();
+}
+
+void PeriodTreeModel::LoadChildren(PeriodTreeModelNode* node) const
+{
+    try {
+        switch (node->GetLevel()) {
+        case PeriodLevel::Root:
+            LoadYears(node);
+            break;
+        case PeriodLevel::Year:
+            LoadMonths(node);
+            break;
+        case PeriodLevel::Month:
+            LoadWeeks(node);
+            break;
+        case PeriodLevel::Week:
+            LoadDays(node);
+            break;
+        case PeriodLevel::Day:
+            LoadItems(node);
+            break;
+        case PeriodLevel::Item:
+        default:
+            break;
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured on PeriodTreeModel::LoadChildren({0}, {1}) - {2:d} : {3}",
+            node->GetFromDate().ToStdString(),
+            node->GetToDate().ToStdString(),
+            e.get_code(),
+            e.what());
+    }
+
+    node->MarkLoaded();
+}
+
+void PeriodTreeModel::LoadYears(PeriodTreeModelNode* node) const
+{
+    data::TaskItemData taskItemData;
+    auto totals = taskItemData.GetDurationTotalsByYear();
+
+    for (const auto& [year, seconds] : totals) {
+        node->Append(std::make_unique<PeriodTreeModelNode>(node,
+            PeriodLevel::Year,
+            year,
+            wxString::Format(wxT("%s-01-01"), year),
+            wxString::Format(wxT("%s-12-31"), year),
+            FormatSeconds(seconds)));
+    }
+}
+
+void PeriodTreeModel::LoadMonths(PeriodTreeModelNode* node) const
+{
+    data::TaskItemData taskItemData;
+    auto totals = taskItemData.GetDurationTotalsByMonth(node->GetFromDate(), node->GetToDate());
+
+    for (const auto& [month, seconds] : totals) {
+        wxDateTime firstDay = ParseISODate(wxString::Format(wxT("%s-01"), month));
+        wxDateTime lastDay = firstDay;
+        lastDay.SetToLastMonthDay(firstDay.GetMonth(), firstDay.GetYear());
+
+        node->Append(std::make_unique<PeriodTreeModelNode>(node,
+            PeriodLevel::Month,
+            wxString::Format(MonthPeriodLabel, wxDateTime::GetMonthName(firstDay.GetMonth()), firstDay.GetYear()),
+            firstDay.FormatISODate(),
+            lastDay.FormatISODate(),
+            FormatSeconds(seconds)));
+    }
+}
+
+void PeriodTreeModel::LoadWeeks(PeriodTreeModelNode* node) const
+{
+    data::TaskItemData taskItemData;
+    auto totals = taskItemData.GetDurationTotalsByWeek(node->GetFromDate(), node->GetToDate());
+
+    for (const auto& [monday, seconds] : totals) {
+        wxString sunday = ParseISODate(monday).Add(wxDateSpan::Days(6)).FormatISODate();
+
+        /* ISO dates compare lexicographically, so clamp the week to the month it is shown under */
+        wxString fromDate = std::max(monday, node->GetFromDate());
+        wxString toDate = std::min(sunday, node->GetToDate());
+
+        node->Append(std::make_unique<PeriodTreeModelNode>(node,
+            PeriodLevel::Week,
+            wxString::Format(WeekPeriodLabel, fromDate, toDate),
+            fromDate,
+            toDate,
+            FormatSeconds(seconds)));
+    }
+}
+
+void PeriodTreeModel::LoadDays(PeriodTreeModelNode* node) const
+{
+    data::TaskItemData taskItemData;
+    auto totals = taskItemData.GetDurationTotalsByDay(node->GetFromDate(), node->GetToDate());
+
+    for (const auto& [day, seconds] : totals) {
+        wxDateTime date = ParseISODate(day);
+
+        node->Append(std::make_unique<PeriodTreeModelNode>(node,
+            PeriodLevel::Day,
+            wxString::Format(DayPeriodLabel, wxDateTime::GetWeekDayName(date.GetWeekDay()), day),
+            day,
+            day,
+            FormatSeconds(seconds)));
+    }
+}
+
+void PeriodTreeModel::LoadItems(PeriodTreeModelNode* node) const
+{
+    data::TaskItemData taskItemData;
+    auto taskItems = taskItemData.GetAllByDate(node->GetFromDate());
+
+    for (const auto& taskItem : taskItems) {
+        node->Append(std::make_unique<PeriodTreeModelNode>(node,
+            taskItem->GetProject()->GetDisplayName(),
+            taskItem->GetDuration(),
+            taskItem->GetCategory()->GetName(),
+            taskItem->GetDescription(),
+            taskItem->GetTaskItemId()));
+    }
+}
+} // namespace app::dv
@@ -0,0 +1,122 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <wx/wx.h>
+#include <wx/dataview.h>
+
+#include <spdlog/spdlog.h>
+
+namespace app::dv
+{
+enum class PeriodLevel : int { Root = 0, Year, Month, Week, Day, Item };
+
+class PeriodTreeModelNode final
+{
+public:
+    PeriodTreeModelNode(PeriodTreeModelNode* parent,
+        PeriodLevel level,
+        const wxString& label,
+        const wxString& fromDate,
+        const wxString& toDate,
+        const wxString& duration);
+    PeriodTreeModelNode(PeriodTreeModelNode* parent,
+        const wxString& projectName,
+        const wxString& duration,
+        const wxString& categoryName,
+        const wxString& description,
+        int taskItemId);
+    ~PeriodTreeModelNode() = default;
+
+    bool IsContainer() const;
+    bool IsLoaded() const;
+    PeriodLevel GetLevel() const;
+    PeriodTreeModelNode* GetParent();
+    std::vector<std::unique_ptr<PeriodTreeModelNode>>& GetChildren();
+
+    void Append(std::unique_ptr<PeriodTreeModelNode> child);
+    void MarkLoaded();
+    void Unload();
+
+    wxString GetLabel() const;
+    wxString GetFromDate() const;
+    wxString GetToDate() const;
+    wxString GetDuration() const;
+    wxString GetCategoryName() const;
+    wxString GetDescription() const;
+    int GetTaskItemId() const;
+
+private:
+    PeriodTreeModelNode* pParent;
+    std::vector<std::unique_ptr<PeriodTreeModelNode>> mChildren;
+
+    PeriodLevel mLevel;
+    wxString mLabel;
+    wxString mFromDate;
+    wxString mToDate;
+    wxString mDuration;
+    wxString mCategoryName;
+    wxString mDescription;
+    int mTaskItemId;
+    bool bLoaded;
+};
+
+/*
+ Hierarchical year -> month -> week -> day -> item model. Every period level is filled from a single
+ aggregate query the first time it is expanded and only expanded days fetch their task item rows.
+ Weeks are clamped to the month they are shown under, so a week spanning two months shows up in both
+ */
+class PeriodTreeModel : public wxDataViewModel
+{
+public:
+    enum { Col_Period = 0, Col_Duration, Col_Category, Col_Description, Col_Id, Col_Max };
+
+    PeriodTreeModel(std::shared_ptr<spdlog::logger> logger);
+    ~PeriodTreeModel() = default;
+
+    unsigned int GetColumnCount() const override;
+    wxString GetColumnType(unsigned int col) const override;
+    void GetValue(wxVariant& variant, const wxDataViewItem& item, unsigned int col) const override;
+    bool SetValue(const wxVariant& variant, const wxDataViewItem& item, unsigned int col) override;
+    bool IsEnabled(const wxDataViewItem& item, unsigned int col) const override;
+    wxDataViewItem GetParent(const wxDataViewItem& item) const override;
+    bool IsContainer(const wxDataViewItem& item) const override;
+    unsigned int GetChildren(const wxDataViewItem& parent, wxDataViewItemArray& array) const override;
+
+    void Reload();
+
+    wxDateTime GetDateFromDataViewItem(const wxDataViewItem& item) const;
+    int GetTaskItemIdFromDataViewItem(const wxDataViewItem& item) const;
+
+private:
+    void LoadChildren(PeriodTreeModelNode* node) const;
+    void LoadYears(PeriodTreeModelNode* node) const;
+    void LoadMonths(PeriodTreeModelNode* node) const;
+    void LoadWeeks(PeriodTreeModelNode* node) const;
+    void LoadDays(PeriodTreeModelNode* node) const;
+    void LoadItems(PeriodTreeModelNode* node) const;
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::unique_ptr<PeriodTreeModelNode> pRoot;
+};
+} // namespace app::dv
@@ -20,9 +20,6 @@
 #include "weeklymodel.h"
 
 #include <algorithm>
-#include <iterator>
-
-#include "../data/taskitemdata.h"
 
 namespace app::dv
 {
@@ -36,36 +33,32 @@ wxString DayDateLabels[7] = {
     wxT("Sunday %s"),
 };
 
-WeeklyTreeModelNode::WeeklyTreeModelNode(WeeklyTreeModelNode* parent,
-    const wxString& projectName,
+WeeklyTreeModelNode::WeeklyTreeModelNode(const wxString& projectName,
     const wxString& duration,
     const wxString& categoryName,
     const wxString& description,
     int taskItemId)
-    : pParent(parent)
-    , mProjectName(projectName)
+    : mProjectName(projectName)
     , mDuration(duration)
     , mCategoryName(categoryName)
     , mDescription(description)
     , mTaskItemId(taskItemId)
     , bContainer(false)
+    , bDeleted(false)
 {
 }
 
-WeeklyTreeModelNode::WeeklyTreeModelNode(WeeklyTreeModelNode* parent, const wxString& branch)
-    : pParent(parent)
-    , mProjectName(branch)
+WeeklyTreeModelNode::WeeklyTreeModelNode(const wxString& branch)
+    : mProjectName(branch)
+    , mTaskItemId(-1)
     , bContainer(true)
+    , bDeleted(false)
 {
 }
 
-WeeklyTreeModelNode::~WeeklyTreeModelNode()
+WeeklyTreeModelNode::WeeklyTreeModelNode()
+    : WeeklyTreeModelNode(wxGetEmptyString())
 {
-    std::size_t count = mChildren.GetCount();
-    for (std::size_t i = 0; i < count; i++) {
-        WeeklyTreeModelNode* child = mChildren[i];
-        delete child;
-    }
 }
 
 bool WeeklyTreeModelNode::IsContainer() const
@@ -73,34 +66,9 @@ bool WeeklyTreeModelNode::IsContainer() const
     return bContainer;
 }
 
-WeeklyTreeModelNode* WeeklyTreeModelNode::GetParent()
-{
-    return pParent;
-}
-
-WeeklyTreeModelNodePtrArray& WeeklyTreeModelNode::GetChildren()
-{
-    return mChildren;
-}
-
-WeeklyTreeModelNode* WeeklyTreeModelNode::GetNthChild(unsigned int n)
-{
-    return mChildren.Item(n);
-}
-
-void WeeklyTreeModelNode::Insert(WeeklyTreeModelNode* child, unsigned int n)
-{
-    mChildren.Insert(child, n);
-}
-
-void WeeklyTreeModelNode::Append(WeeklyTreeModelNode* child)
-{
-    mChildren.Add(child);
-}
-
-const unsigned int WeeklyTreeModelNode::GetChildCount() const
+bool WeeklyTreeModelNode::IsDeleted() const
 {
-    return mChildren.Count();
+    return bDeleted;
 }
 
 wxString WeeklyTreeModelNode::GetProjectName() const
@@ -153,49 +121,42 @@ void WeeklyTreeModelNode::SetTaskItemId(int taskItemId)
     mTaskItemId = taskItemId;
 }
 
+void WeeklyTreeModelNode::MarkDeleted()
+{
+    bDeleted = true;
+}
+
 const wxString WeekLabel = wxT("Monday %s - Sunday %s");
 // WeeklyTreeModel
 WeeklyTreeModel::WeeklyTreeModel(const DateTraverser& dateTraverser)
-    : mWeeklyTasksMap()
-    , pDayNodes()
+    : mRoot()
+    , mDayNodes()
+    , mDayItems()
+    , mWeekCache()
     , mDateTraverser(dateTraverser)
 {
+    mWeekCache.reserve(WeekCacheSize);
     SetupNodes();
 }
 
-WeeklyTreeModel::~WeeklyTreeModel()
-{
-    delete pRoot;
-}
-
-// This method should only be used once from WeeklyTaskViewDialog::FillControls
 void WeeklyTreeModel::AddToWeek(std::vector<std::unique_ptr<model::TaskItemModel>>& taskItems)
 {
+    std::array<std::vector<std::unique_ptr<model::TaskItemModel>>, NumberOfDays> dayTasks;
+    const auto& dates = mDateTraverser.GetISODates();
+
     for (auto& taskItem : taskItems) {
-        wxString taskDateIndex = taskItem->GetTask()->GetTaskDate();
-        mWeeklyTasksMap[taskDateIndex].push_back(std::move(taskItem));
+        wxString taskDate = taskItem->GetTask()->GetTaskDate();
+        for (std::size_t i = 0; i < NumberOfDays; i++) {
+            if (taskDate == dates[i]) {
+                dayTasks[i].push_back(std::move(taskItem));
+                break;
+            }
+        }
     }
 
-    auto& mondayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Monday)];
-    AddMany(pDayNodes[constants::Days::Monday], mondayTaskItems);
-
-    auto& tuesdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Tuesday)];
-    AddMany(pDayNodes[constants::Days::Tuesday], tuesdayTaskItems);
-
-    auto& wednesdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Wednesday)];
-    AddMany(pDayNodes[constants::Days::Wednesday], wednesdayTaskItems);
-
-    auto& thursdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Thursday)];
-    AddMany(pDayNodes[constants::Days::Thursday], thursdayTaskItems);
-
-    auto& fridayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Friday)];
-    AddMany(pDayNodes[constants::Days::Friday], fridayTaskItems);
-
-    auto& saturdayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Saturday)];
-    AddMany(pDayNodes[constants::Days::Saturday], saturdayTaskItems);
-
-    auto& sundayTaskItems = mWeeklyTasksMap[mDateTraverser.GetDayISODate(constants::Days::Sunday)];
-    AddMany(pDayNodes[constants::Days::Sunday], sundayTaskItems);
+    for (std::size_t i = 0; i < NumberOfDays; i++) {
+        AddMany(i, dayTasks[i]);
+    }
 }
 
 unsigned int WeeklyTreeModel::GetColumnCount() const
@@ -216,22 +177,22 @@ void WeeklyTreeModel::GetValue(wxVariant& variant, const wxDataViewItem& item, u
 {
     wxASSERT(item.IsOk());
 
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
+    const WeeklyTreeModelNode& node = GetNode(item);
     switch (col) {
     case Col_Project:
-        variant = node->GetProjectName();
+        variant = node.GetProjectName();
         break;
     case Col_Duration:
-        variant = node->GetDuration();
+        variant = node.GetDuration();
         break;
     case Col_Category:
-        variant = node->GetCategoryName();
+        variant = node.GetCategoryName();
         break;
     case Col_Description:
-        variant = node->GetDescription();
+        variant = node.GetDescription();
         break;
     case Col_Id:
-        variant = (long) node->GetTaskItemId();
+        variant = (long) node.GetTaskItemId();
         break;
     case Col_Max:
     default:
@@ -244,22 +205,22 @@ bool WeeklyTreeModel::SetValue(const wxVariant& variant, const wxDataViewItem& i
 {
     wxASSERT(item.IsOk());
 
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
+    WeeklyTreeModelNode& node = GetNode(item);
     switch (col) {
     case Col_Project:
-        node->SetProjectName(variant.GetString());
+        node.SetProjectName(variant.GetString());
         break;
     case Col_Duration:
-        node->SetDuration(variant.GetString());
+        node.SetDuration(variant.GetString());
         break;
     case Col_Category:
-        node->SetCategoryName(variant.GetString());
+        node.SetCategoryName(variant.GetString());
         break;
     case Col_Description:
-        node->SetDescription(variant.GetString());
+        node.SetDescription(variant.GetString());
         break;
     case Col_Id:
-        node->SetTaskItemId(variant.GetInteger());
+        node.SetTaskItemId(variant.GetInteger());
         break;
     case Col_Max:
     default:
@@ -281,13 +242,16 @@ wxDataViewItem WeeklyTreeModel::GetParent(const wxDataViewItem& item) const
         return wxDataViewItem(0);
     }
 
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
-
-    if (node == pRoot) {
+    std::size_t dayIndex = DayIndexFromItem(item);
+    if (dayIndex == RootIndex) {
         return wxDataViewItem(0);
     }
 
-    return wxDataViewItem((void*) node->GetParent());
+    if (!IsRowItem(item)) {
+        return MakeContainerItem(RootIndex);
+    }
+
+    return MakeContainerItem(dayIndex);
 }
 
 bool WeeklyTreeModel::IsContainer(const wxDataViewItem& item) const
@@ -296,26 +260,36 @@ bool WeeklyTreeModel::IsContainer(const wxDataViewItem& item) const
         return true;
     }
 
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
-    return node->IsContainer();
+    return !IsRowItem(item);
 }
 
 unsigned int WeeklyTreeModel::GetChildren(const wxDataViewItem& parent, wxDataViewItemArray& array) const
 {
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) parent.GetID();
-    if (!node) {
-        array.Add(wxDataViewItem((void*) pRoot));
+    if (!parent.IsOk()) {
+        array.Add(MakeContainerItem(RootIndex));
         return 1;
     }
 
-    if (node->GetChildCount() == 0) {
+    std::size_t dayIndex = DayIndexFromItem(parent);
+    if (dayIndex == RootIndex) {
+        for (std::size_t i = 0; i < NumberOfDays; i++) {
+            array.Add(MakeContainerItem(i));
+        }
+        return NumberOfDays;
+    }
+
+    if (IsRowItem(parent)) {
         return 0;
     }
 
-    unsigned int count = node->GetChildren().GetCount();
-    for (unsigned int pos = 0; pos < count; pos++) {
-        WeeklyTreeModelNode* child = node->GetChildren().Item(pos);
-        array.Add(wxDataViewItem((void*) child));
+    const auto& items = mDayItems[dayIndex];
+    unsigned int count = 0;
+    array.reserve(array.size() + items.size());
+    for (std::size_t row = 0; row < items.size(); row++) {
+        if (!items[row].IsDeleted()) {
+            array.Add(MakeItem(dayIndex, row));
+            count++;
+        }
     }
 
     return count;
@@ -323,27 +297,22 @@ unsigned int WeeklyTreeModel::GetChildren(const wxDataViewItem& parent, wxDataVi
 
 void WeeklyTreeModel::Delete(const wxDataViewItem& item)
 {
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
-    if (!node) { // happens if item.IsOk()==false
+    if (!item.IsOk()) {
         return;
     }
 
-    wxDataViewItem parent(node->GetParent());
-    if (!parent.IsOk()) { // this means that the root node was clicked and has no parent
+    // do not delete the root or the day nodes
+    if (!IsRowItem(item)) {
         return;
     }
 
-    // do not delete the special nodes
-    for (std::size_t i = 0; i < NumberOfDays; i++) {
-        if (node == pDayNodes[i]) {
-            return;
-        }
+    WeeklyTreeModelNode& node = GetNode(item);
+    if (node.IsDeleted()) {
+        return;
     }
+    node.MarkDeleted();
 
-    node->GetParent()->GetChildren().Remove(node);
-    delete node;
-
-    ItemDeleted(parent, item);
+    ItemDeleted(GetParent(item), item);
 }
 
 void WeeklyTreeModel::ClearAll()
@@ -351,45 +320,95 @@ void WeeklyTreeModel::ClearAll()
     UpdateNodeLabels();
 
     for (std::size_t i = 0; i < NumberOfDays; i++) {
-        ClearDayNodes(pDayNodes[i]);
+        ClearDayNodes(i);
+    }
+}
+
+/*
+ Swaps the nodes of the week currently shown into the week cache and the nodes of the week to switch to
+ out of it. On a cache miss the storage of the least recently viewed week is reused, so once the cache is
+ warm switching weeks does not allocate. Returns false on a cache miss, in which case the day nodes are
+ empty and the caller is expected to fill them with AddToWeek
+ */
+bool WeeklyTreeModel::SwitchWeek(const DateTraverser& dateTraverser)
+{
+    DateTraverser nextDateTraverser = dateTraverser;
+    wxString nextMondayDate = nextDateTraverser.GetDayISODate(constants::Days::Monday);
+    wxString currentMondayDate = mDateTraverser.GetDayISODate(constants::Days::Monday);
+
+    if (nextMondayDate == currentMondayDate) {
+        return true;
+    }
+
+    auto cachedWeek = std::find_if(mWeekCache.begin(), mWeekCache.end(), [&](const CachedWeek& week) {
+        return week.mMondayDate == nextMondayDate;
+    });
+
+    bool cacheHit = cachedWeek != mWeekCache.end();
+    if (!cacheHit) {
+        if (mWeekCache.size() < WeekCacheSize) {
+            mWeekCache.emplace_back();
+        }
+        cachedWeek = mWeekCache.end() - 1;
+    }
+
+    std::swap(mDayItems, cachedWeek->mDayItems);
+    cachedWeek->mMondayDate = currentMondayDate;
+    std::rotate(mWeekCache.begin(), cachedWeek, cachedWeek + 1);
+
+    if (!cacheHit) {
+        for (auto& items : mDayItems) {
+            items.clear();
+        }
+    }
+
+    mDateTraverser = nextDateTraverser;
+    UpdateNodeLabels();
+    Cleared();
+
+    return cacheHit;
+}
+
+void WeeklyTreeModel::InvalidateWeekCache()
+{
+    for (auto& week : mWeekCache) {
+        week.mMondayDate = wxGetEmptyString();
+        for (auto& items : week.mDayItems) {
+            items.clear();
+        }
     }
 }
 
 wxDataViewItem WeeklyTreeModel::ExpandRootNode()
 {
-    return wxDataViewItem((void*) pRoot);
+    return MakeContainerItem(RootIndex);
 }
 
 wxDataViewItemArray WeeklyTreeModel::CollapseDayNodes()
 {
     wxDataViewItemArray array;
     for (std::size_t i = 0; i < NumberOfDays; i++) {
-        array.Add(wxDataViewItem((void*)pDayNodes[i]));
+        array.Add(MakeContainerItem(i));
     }
     return array;
 }
 
 wxDateTime WeeklyTreeModel::GetDateFromDataViewItem(const wxDataViewItem& item)
 {
-    WeeklyTreeModelNode* node = (WeeklyTreeModelNode*) item.GetID();
-
-    if (node->GetParent() == pDayNodes[constants::Days::Monday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Monday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Tuesday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Tuesday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Wednesday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Wednesday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Thursday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Thursday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Friday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Friday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Saturday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Saturday);
-    } else if (node->GetParent() == pDayNodes[constants::Days::Sunday]) {
-        return mDateTraverser.GetDayDate(constants::Days::Sunday);
-    } else {
+    if (!item.IsOk() || !IsRowItem(item)) {
         return wxDateTime::Now();
     }
+
+    return mDateTraverser.GetDayDate(constants::MapIndexToEnum(DayIndexFromItem(item)));
+}
+
+int WeeklyTreeModel::GetTaskItemIdFromDataViewItem(const wxDataViewItem& item) const
+{
+    if (!item.IsOk() || !IsRowItem(item)) {
+        return -1;
+    }
+
+    return GetNode(item).GetTaskItemId();
 }
 
 void WeeklyTreeModel::SetDateTraverser(const DateTraverser& dateTraverser)
@@ -397,57 +416,108 @@ void WeeklyTreeModel::SetDateTraverser(const DateTraverser& dateTraverser)
     mDateTraverser = dateTraverser;
 }
 
-void WeeklyTreeModel::SetupNodes()
+wxDataViewItem WeeklyTreeModel::MakeItem(std::size_t dayIndex, std::size_t rowIndex)
 {
-    wxString weekLabel = wxString::Format(WeekLabel,
-        mDateTraverser.GetDayISODate(constants::Days::Monday),
-        mDateTraverser.GetDayISODate(constants::Days::Sunday));
+    wxASSERT(rowIndex < RowMask);
 
-    pRoot = new WeeklyTreeModelNode(nullptr, weekLabel);
+    std::uintptr_t id = (std::uintptr_t(dayIndex + 1) << RowBits) | std::uintptr_t(rowIndex + 1);
+    return wxDataViewItem(reinterpret_cast<void*>(id));
+}
 
-    for (std::size_t i = 0; i < NumberOfDays; i++) {
-        wxString label = wxString::Format(DayDateLabels[i], mDateTraverser.GetDayISODate(constants::MapIndexToEnum(i)));
-        pDayNodes[i] = new WeeklyTreeModelNode(pRoot, label);
-        pRoot->Append(pDayNodes[i]);
+wxDataViewItem WeeklyTreeModel::MakeContainerItem(std::size_t dayIndex)
+{
+    std::uintptr_t id = std::uintptr_t(dayIndex + 1) << RowBits;
+    return wxDataViewItem(reinterpret_cast<void*>(id));
+}
+
+std::size_t WeeklyTreeModel::DayIndexFromItem(const wxDataViewItem& item)
+{
+    std::uintptr_t id = reinterpret_cast<std::uintptr_t>(item.GetID());
+    return static_cast<std::size_t>(id >> RowBits) - 1;
+}
+
+bool WeeklyTreeModel::IsRowItem(const wxDataViewItem& item)
+{
+    std::uintptr_t id = reinterpret_cast<std::uintptr_t>(item.GetID());
+    return (id & RowMask) != 0;
+}
+
+std::size_t WeeklyTreeModel::RowIndexFromItem(const wxDataViewItem& item)
+{
+    std::uintptr_t id = reinterpret_cast<std::uintptr_t>(item.GetID());
+    return static_cast<std::size_t>(id & RowMask) - 1;
+}
+
+WeeklyTreeModelNode& WeeklyTreeModel::GetNode(const wxDataViewItem& item)
+{
+    return const_cast<WeeklyTreeModelNode&>(static_cast<const WeeklyTreeModel*>(this)->GetNode(item));
+}
+
+const WeeklyTreeModelNode& WeeklyTreeModel::GetNode(const wxDataViewItem& item) const
+{
+    std::size_t dayIndex = DayIndexFromItem(item);
+    if (dayIndex == RootIndex) {
+        return mRoot;
+    }
+
+    if (!IsRowItem(item)) {
+        return mDayNodes[dayIndex];
     }
+
+    return mDayItems[dayIndex][RowIndexFromItem(item)];
 }
 
-void WeeklyTreeModel::AddMany(WeeklyTreeModelNode* dayNodeToAdd,
+void WeeklyTreeModel::SetupNodes()
+{
+    UpdateNodeLabels();
+}
+
+void WeeklyTreeModel::AddMany(std::size_t dayIndex,
     std::vector<std::unique_ptr<model::TaskItemModel>>& dayTasksToAdd)
 {
+    if (dayTasksToAdd.empty()) {
+        return;
+    }
+
+    auto& items = mDayItems[dayIndex];
+    std::size_t firstRow = items.size();
+    items.reserve(firstRow + dayTasksToAdd.size());
+
+    wxDataViewItemArray itemsAdded;
+    itemsAdded.reserve(dayTasksToAdd.size());
+
     for (const auto& taskToAdd : dayTasksToAdd) {
-        auto node = new WeeklyTreeModelNode(dayNodeToAdd,
-            taskToAdd->GetProject()->GetDisplayName(),
+        items.emplace_back(taskToAdd->GetProject()->GetDisplayName(),
             taskToAdd->GetDuration(),
             taskToAdd->GetCategory()->GetName(),
             taskToAdd->GetDescription(),
             taskToAdd->GetTaskItemId());
 
-        dayNodeToAdd->Append(node);
+        itemsAdded.Add(MakeItem(dayIndex, items.size() - 1));
     }
+
+    ItemsAdded(MakeContainerItem(dayIndex), itemsAdded);
 }
 
-void WeeklyTreeModel::ClearDayNodes(WeeklyTreeModelNode* node)
+void WeeklyTreeModel::ClearDayNodes(std::size_t dayIndex)
 {
-    wxDataViewItemArray itemsRemoved;
-    unsigned int count = node->GetChildCount();
-
-    for (unsigned int pos = 0; pos < count; pos++) {
-        WeeklyTreeModelNode* child = node->GetChildren().Item(pos);
-        itemsRemoved.Add(wxDataViewItem((void*) child));
+    auto& items = mDayItems[dayIndex];
+    if (items.empty()) {
+        return;
     }
 
-    for (auto child : node->GetChildren()) {
-        delete child;
-        child = nullptr;
+    wxDataViewItemArray itemsRemoved;
+    itemsRemoved.reserve(items.size());
+    for (std::size_t row = 0; row < items.size(); row++) {
+        if (!items[row].IsDeleted()) {
+            itemsRemoved.Add(MakeItem(dayIndex, row));
+        }
     }
 
-    node->GetChildren().clear();
-
-    count = node->GetChildCount();
+    /* clear() keeps the capacity of the vector so the next week is filled without reallocating */
+    items.clear();
 
-    wxDataViewItem parent((void*) node);
-    ItemsDeleted(parent, itemsRemoved);
+    ItemsDeleted(MakeContainerItem(dayIndex), itemsRemoved);
 }
 
 void WeeklyTreeModel::UpdateNodeLabels()
@@ -456,10 +526,10 @@ void WeeklyTreeModel::UpdateNodeLabels()
         mDateTraverser.GetDayISODate(constants::Days::Monday),
         mDateTraverser.GetDayISODate(constants::Days::Sunday));
 
-    pRoot->SetProjectName(weekLabel);
+    mRoot.SetProjectName(weekLabel);
     for (std::size_t i = 0; i < NumberOfDays; i++) {
         wxString label = wxString::Format(DayDateLabels[i], mDateTraverser.GetDayISODate(constants::MapIndexToEnum(i)));
-        pDayNodes[i]->SetProjectName(label);
+        mDayNodes[i].SetProjectName(label);
     }
 }
 } // namespace app::dv
@@ -20,7 +20,7 @@
 #pragma once
 
 #include <array>
-#include <unordered_map>
+#include <cstdint>
 #include <vector>
 
 #include <wx/wx.h>
@@ -33,29 +33,20 @@ namespace app::dv
 {
 const int NumberOfDays = 7;
 
-class WeeklyTreeModelNode;
-WX_DEFINE_ARRAY_PTR(WeeklyTreeModelNode*, WeeklyTreeModelNodePtrArray);
-
 class WeeklyTreeModelNode final
 {
 public:
-    WeeklyTreeModelNode(WeeklyTreeModelNode* parent,
-        const wxString& projectName,
+    WeeklyTreeModelNode(const wxString& projectName,
         const wxString& duration,
         const wxString& categoryName,
         const wxString& description,
         int taskItemId);
-    WeeklyTreeModelNode(WeeklyTreeModelNode* parent, const wxString& branch);
-    ~WeeklyTreeModelNode();
+    WeeklyTreeModelNode(const wxString& branch);
+    WeeklyTreeModelNode();
+    ~WeeklyTreeModelNode() = default;
 
     bool IsContainer() const;
-    WeeklyTreeModelNode* GetParent();
-    WeeklyTreeModelNodePtrArray& GetChildren();
-    WeeklyTreeModelNode* GetNthChild(unsigned int n);
-
-    void Insert(WeeklyTreeModelNode* child, unsigned int n);
-    void Append(WeeklyTreeModelNode* child);
-    const unsigned int GetChildCount() const;
+    bool IsDeleted() const;
 
     wxString GetProjectName() const;
     wxString GetDuration() const;
@@ -68,26 +59,32 @@ class WeeklyTreeModelNode final
     void SetCategoryName(const wxString& value);
     void SetDescription(const wxString& value);
     void SetTaskItemId(int taskItemId);
+    void MarkDeleted();
 
 private:
-    WeeklyTreeModelNode* pParent;
-    WeeklyTreeModelNodePtrArray mChildren;
-
     wxString mProjectName;
     wxString mDuration;
     wxString mCategoryName;
     wxString mDescription;
     int mTaskItemId;
     bool bContainer;
+    bool bDeleted;
 };
 
+/*
+ The weekly tree is stored as one contiguous node vector per day. A wxDataViewItem does not point
+ to a heap node, instead its id encodes the position of the node in the tree:
+   [ day index + 1 | row index + 1 ]
+ where the row part is 0 for the day nodes themselves and the day part is NumberOfDays + 1 for the root.
+ Deleting a single item only marks its node as deleted so that the ids of its siblings stay valid
+ */
 class WeeklyTreeModel : public wxDataViewModel
 {
 public:
     enum { Col_Project = 0, Col_Duration, Col_Category, Col_Description, Col_Id, Col_Max };
 
     WeeklyTreeModel(const DateTraverser& dateTraverser);
-    ~WeeklyTreeModel();
+    ~WeeklyTreeModel() = default;
 
     void AddToWeek(std::vector<std::unique_ptr<model::TaskItemModel>>& taskItems);
 
@@ -102,24 +99,49 @@ class WeeklyTreeModel : public wxDataViewModel
     void Delete(const wxDataViewItem& item);
     void ClearAll();
 
+    bool SwitchWeek(const DateTraverser& dateTraverser);
+    void InvalidateWeekCache();
+
     wxDataViewItem ExpandRootNode();
     wxDataViewItemArray CollapseDayNodes();
     wxDateTime GetDateFromDataViewItem(const wxDataViewItem& item);
+    int GetTaskItemIdFromDataViewItem(const wxDataViewItem& item) const;
 
     void SetDateTraverser(const DateTraverser& dateTraverser);
 
 private:
+    static const unsigned int RowBits = 24;
+    static const std::uintptr_t RowMask = (std::uintptr_t(1) << RowBits) - 1;
+    static const std::size_t RootIndex = NumberOfDays;
+    static const std::size_t WeekCacheSize = 4;
+
+    struct CachedWeek {
+        wxString mMondayDate;
+        std::array<std::vector<WeeklyTreeModelNode>, NumberOfDays> mDayItems;
+    };
+
+    static wxDataViewItem MakeItem(std::size_t dayIndex, std::size_t rowIndex);
+    static wxDataViewItem MakeContainerItem(std::size_t dayIndex);
+    static std::size_t DayIndexFromItem(const wxDataViewItem& item);
+    static bool IsRowItem(const wxDataViewItem& item);
+    static std::size_t RowIndexFromItem(const wxDataViewItem& item);
+
+    WeeklyTreeModelNode& GetNode(const wxDataViewItem& item);
+    const WeeklyTreeModelNode& GetNode(const wxDataViewItem& item) const;
+
     void SetupNodes();
 
-    void AddMany(WeeklyTreeModelNode* dayNodeToAdd, std::vector<std::unique_ptr<model::TaskItemModel>>& dayTasksToAdd);
-    void ClearDayNodes(WeeklyTreeModelNode* node);
+    void AddMany(std::size_t dayIndex, std::vector<std::unique_ptr<model::TaskItemModel>>& dayTasksToAdd);
+    void ClearDayNodes(std::size_t dayIndex);
 
     void UpdateNodeLabels();
 
-    std::unordered_map<wxString, std::vector<std::unique_ptr<model::TaskItemModel>>> mWeeklyTasksMap;
+    WeeklyTreeModelNode mRoot;
+    std::array<WeeklyTreeModelNode, NumberOfDays> mDayNodes;
+    std::array<std::vector<WeeklyTreeModelNode>, NumberOfDays> mDayItems;
 
-    WeeklyTreeModelNode* pRoot;
-    std::array<WeeklyTreeModelNode*, NumberOfDays> pDayNodes;
+    /* recently viewed weeks, most recently viewed first. The week currently shown is never in the cache */
+    std::vector<CachedWeek> mWeekCache;
 
     DateTraverser mDateTraverser;
 };
@@ -336,7 +336,7 @@ void CategoriesDialog::FillControls(std::unique_ptr<model::CategoryModel> catego
 
     pNameTextCtrl->ChangeValue(category->GetName());
 
-    pColorPickerCtrl->SetColour(category->GetColor());
+    pColorPickerCtrl->SetColour(wxColour(category->GetColor()));
 }
 
 void CategoriesDialog::AppendListControlEntry(model::CategoryModel* category)
@@ -346,7 +346,7 @@ void CategoriesDialog::AppendListControlEntry(model::CategoryModel* category)
 
     listIndex = pCategoryListCtrl->InsertItem(columnIndex++, category->GetProject()->GetDisplayName());
     pCategoryListCtrl->SetItem(listIndex, columnIndex++, category->GetName());
-    pCategoryListCtrl->SetItemBackgroundColour(listIndex, category->GetColor());
+    pCategoryListCtrl->SetItemBackgroundColour(listIndex, wxColour(category->GetColor()));
     pCategoryListCtrl->SetItemPtrData(listIndex, category->GetProjectId());
 }
 
@@ -356,7 +356,7 @@ void CategoriesDialog::UpdateListControlEntry(model::CategoryModel* category)
 
     pCategoryListCtrl->SetItem(mItemIndex, columnIndex++, category->GetProject()->GetDisplayName());
     pCategoryListCtrl->SetItem(mItemIndex, columnIndex++, category->GetName());
-    pCategoryListCtrl->SetItemBackgroundColour(mItemIndex, category->GetColor());
+    pCategoryListCtrl->SetItemBackgroundColour(mItemIndex, wxColour(category->GetColor()));
     pCategoryListCtrl->SetItemPtrData(mItemIndex, category->GetProjectId());
 
     mItemIndex = -1;
@@ -574,7 +574,7 @@ bool CategoriesDialog::TransferDataAndValidate()
     pCategory->GetProject()->SetDisplayName(displayName);
 
     wxColor color = pColorPickerCtrl->GetColour();
-    pCategory->SetColor(color);
+    pCategory->SetColor(color.GetRGB());
 
     return true;
 }
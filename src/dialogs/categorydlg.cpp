@@ -218,7 +218,7 @@ void CategoryDialog::DataToControls()
 
     pNameTextCtrl->SetValue(category->GetName());
 
-    pColorPickerCtrl->SetColour(category->GetColor());
+    pColorPickerCtrl->SetColour(wxColour(category->GetColor()));
 
     pDateTextCtrl->SetLabel(wxString::Format(constants::DateLabel,
         util::ToFriendlyDateTimeString(category->GetDateCreated()),
@@ -249,7 +249,7 @@ bool CategoryDialog::TransferDataAndValidate()
     pCategory->SetProjectId(projectId);
 
     wxColor color = pColorPickerCtrl->GetColour();
-    pCategory->SetColor(color);
+    pCategory->SetColor(color.GetRGB());
 
     return true;
 }
@@ -0,0 +1,161 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "periodtaskviewdlg.h"
+
+#include "../common/common.h"
+
+namespace app::dlg
+{
+PeriodTaskViewDialog::PeriodTaskViewDialog(wxWindow* parent,
+    std::shared_ptr<spdlog::logger> logger,
+    std::shared_ptr<cfg::Configuration> config,
+    const wxString& name)
+    : pParent(parent)
+    , pLogger(logger)
+    , pConfig(config)
+    , pPeriodTreeModel(nullptr)
+    , pDataViewCtrl(nullptr)
+    , pRefreshButton(nullptr)
+{
+    long style = wxCAPTION | wxCLOSE_BOX | wxMAXIMIZE_BOX | wxMINIMIZE_BOX | wxRESIZE_BORDER;
+    wxSize dialogSize = wxSize(740, 540);
+    Create(pParent, wxID_ANY, wxT("Period Task View"), wxDefaultPosition, dialogSize, style, name);
+    SetMinSize(dialogSize);
+}
+
+bool PeriodTaskViewDialog::Create(wxWindow* parent,
+    wxWindowID windowId,
+    const wxString& title,
+    const wxPoint& position,
+    const wxSize& size,
+    long style,
+    const wxString& name)
+{
+    bool created = wxDialog::Create(parent, windowId, title, position, size, style, name);
+    if (created) {
+        CreateControls();
+        ConfigureEventBindings();
+
+        SetIcon(common::GetProgramIcon());
+        Center();
+    }
+
+    return created;
+}
+
+void PeriodTaskViewDialog::CreateControls()
+{
+    /* Main Window Sizer */
+    auto mainSizer = new wxBoxSizer(wxVERTICAL);
+    SetSizer(mainSizer);
+
+    /* Main Dialog Panel */
+    auto mainPanelSizer = new wxBoxSizer(wxVERTICAL);
+    auto dataViewPanel = new wxPanel(this, wxID_STATIC);
+    dataViewPanel->SetSizer(mainPanelSizer);
+    mainSizer->Add(dataViewPanel, 1, wxGROW | wxALL, 1);
+
+    /* Data View Ctrl */
+    long dataViewStyle = wxDV_SINGLE | wxDV_ROW_LINES | wxDV_HORIZ_RULES | wxDV_VERT_RULES;
+    pDataViewCtrl = new wxDataViewCtrl(dataViewPanel, IDC_DATAVIEW, wxDefaultPosition, wxDefaultSize, dataViewStyle);
+    mainPanelSizer->Add(pDataViewCtrl, 1, wxEXPAND | wxALL, 5);
+
+    /* Data View Model */
+    pPeriodTreeModel = new dv::PeriodTreeModel(pLogger);
+    pDataViewCtrl->AssociateModel(pPeriodTreeModel.get());
+
+    /* Data View Columns */
+    auto periodTextRenderer = new wxDataViewTextRenderer("string", wxDATAVIEW_CELL_INERT);
+    auto durationTextRenderer = new wxDataViewTextRenderer("string", wxDATAVIEW_CELL_INERT);
+    auto categoryNameTextRenderer = new wxDataViewTextRenderer("string", wxDATAVIEW_CELL_INERT);
+    auto descriptionTextRenderer = new wxDataViewTextRenderer("string", wxDATAVIEW_CELL_INERT);
+    descriptionTextRenderer->EnableEllipsize(wxEllipsizeMode::wxELLIPSIZE_END);
+
+    auto idRenderer = new wxDataViewTextRenderer("long", wxDATAVIEW_CELL_INERT);
+
+    /* Period Column */
+    auto periodColumn = new wxDataViewColumn(wxT("Period"),
+        periodTextRenderer,
+        dv::PeriodTreeModel::Col_Period,
+        80,
+        wxALIGN_LEFT,
+        wxDATAVIEW_COL_RESIZABLE);
+    periodColumn->SetWidth(wxCOL_WIDTH_AUTOSIZE);
+    pDataViewCtrl->AppendColumn(periodColumn);
+
+    /* Duration Column */
+    auto durationColumn =
+        new wxDataViewColumn(wxT("Duration"), durationTextRenderer, dv::PeriodTreeModel::Col_Duration);
+    durationColumn->SetWidth(wxCOL_WIDTH_AUTOSIZE);
+    durationColumn->SetResizeable(false);
+    pDataViewCtrl->AppendColumn(durationColumn);
+
+    /* Category Column */
+    auto categoryColumn = new wxDataViewColumn(wxT("Category"),
+        categoryNameTextRenderer,
+        dv::PeriodTreeModel::Col_Category,
+        80,
+        wxALIGN_CENTER,
+        wxDATAVIEW_COL_RESIZABLE);
+    categoryColumn->SetWidth(wxCOL_WIDTH_AUTOSIZE);
+    pDataViewCtrl->AppendColumn(categoryColumn);
+
+    /* Description Column */
+    auto descriptionColumn = new wxDataViewColumn(wxT("Description"),
+        descriptionTextRenderer,
+        dv::PeriodTreeModel::Col_Description,
+        80,
+        wxALIGN_LEFT,
+        wxDATAVIEW_COL_RESIZABLE);
+    pDataViewCtrl->AppendColumn(descriptionColumn);
+
+    /* ID Column */
+    auto idColumn = new wxDataViewColumn(
+        wxT("ID"), idRenderer, dv::PeriodTreeModel::Col_Id, 32, wxALIGN_CENTER, wxDATAVIEW_COL_HIDDEN);
+    pDataViewCtrl->AppendColumn(idColumn);
+
+    /* Button Panel */
+    auto buttonPanel = new wxPanel(this, wxID_STATIC);
+    auto buttonPanelSizer = new wxBoxSizer(wxHORIZONTAL);
+    buttonPanel->SetSizer(buttonPanelSizer);
+    mainSizer->Add(buttonPanel, common::sizers::ControlRight);
+
+    pRefreshButton = new wxButton(buttonPanel, IDC_REFRESH, wxT("&Refresh"));
+    pRefreshButton->SetToolTip(wxT("Reload the period totals from the database"));
+    buttonPanelSizer->Add(pRefreshButton, common::sizers::ControlDefault);
+}
+
+// clang-format off
+void PeriodTaskViewDialog::ConfigureEventBindings()
+{
+    pRefreshButton->Bind(
+        wxEVT_BUTTON,
+        &PeriodTaskViewDialog::OnRefresh,
+        this
+    );
+}
+// clang-format on
+
+void PeriodTaskViewDialog::OnRefresh(wxCommandEvent& WXUNUSED(event))
+{
+    wxBusyCursor wait;
+    pPeriodTreeModel->Reload();
+}
+} // namespace app::dlg
@@ -0,0 +1,68 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+
+#include <wx/wx.h>
+#include <wx/dataview.h>
+
+#include <spdlog/spdlog.h>
+
+#include "../config/configuration.h"
+#include "../dataview/periodmodel.h"
+
+namespace app::dlg
+{
+class PeriodTaskViewDialog final : public wxDialog
+{
+public:
+    PeriodTaskViewDialog() = delete;
+    PeriodTaskViewDialog(wxWindow* parent,
+        std::shared_ptr<spdlog::logger> logger,
+        std::shared_ptr<cfg::Configuration> config,
+        const wxString& name = wxT("periodtaskviewdlg"));
+    virtual ~PeriodTaskViewDialog() = default;
+
+private:
+    bool Create(wxWindow* parent,
+        wxWindowID windowId,
+        const wxString& title,
+        const wxPoint& position,
+        const wxSize& size,
+        long style,
+        const wxString& name);
+
+    void CreateControls();
+    void ConfigureEventBindings();
+
+    void OnRefresh(wxCommandEvent& event);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::shared_ptr<cfg::Configuration> pConfig;
+
+    wxWindow* pParent;
+    wxObjectDataPtr<dv::PeriodTreeModel> pPeriodTreeModel;
+    wxDataViewCtrl* pDataViewCtrl;
+    wxButton* pRefreshButton;
+
+    enum { IDC_DATAVIEW = wxID_HIGHEST + 1, IDC_REFRESH };
+};
+} // namespace app::dlg
@@ -32,10 +32,17 @@ DatabasePage::DatabasePage(wxWindow* parent, std::shared_ptr<cfg::Configuration>
     , pParent(parent)
     , pDatabasePathTextCtrl(nullptr)
     , pBrowseDatabasePathButton(nullptr)
+    , pArchiveAfterMonthsCtrl(nullptr)
     , pBackupDatabaseCtrl(nullptr)
     , pBackupPathTextCtrl(nullptr)
     , pBrowseBackupPathButton(nullptr)
-    , pDeleteBackupsAfterCtrl(nullptr)
+    , pKeepDailyBackupsCtrl(nullptr)
+    , pKeepWeeklyBackupsCtrl(nullptr)
+    , pKeepMonthlyBackupsCtrl(nullptr)
+    , pBackupSizeLimitCtrl(nullptr)
+    , pCompressBackupsCtrl(nullptr)
+    , pDifferentialBackupsCtrl(nullptr)
+    , pFullBackupIntervalCtrl(nullptr)
 {
     CreateControls();
     ConfigureEventBindings();
@@ -45,9 +52,16 @@ DatabasePage::DatabasePage(wxWindow* parent, std::shared_ptr<cfg::Configuration>
 void DatabasePage::Apply()
 {
     pConfig->SetDatabasePath(pDatabasePathTextCtrl->GetValue());
+    pConfig->SetArchiveAfterMonths(std::stoi(pArchiveAfterMonthsCtrl->GetValue().ToStdString()));
     pConfig->SetBackupEnabled(pBackupDatabaseCtrl->GetValue());
     pConfig->SetBackupPath(pBackupPathTextCtrl->GetValue());
-    pConfig->SetDeleteBackupsAfter(std::stoi(pDeleteBackupsAfterCtrl->GetValue().ToStdString()));
+    pConfig->SetKeepDailyBackups(std::stoi(pKeepDailyBackupsCtrl->GetValue().ToStdString()));
+    pConfig->SetKeepWeeklyBackups(std::stoi(pKeepWeeklyBackupsCtrl->GetValue().ToStdString()));
+    pConfig->SetKeepMonthlyBackups(std::stoi(pKeepMonthlyBackupsCtrl->GetValue().ToStdString()));
+    pConfig->SetBackupSizeLimit(std::stoi(pBackupSizeLimitCtrl->GetValue().ToStdString()));
+    pConfig->SetBackupCompression(pCompressBackupsCtrl->GetValue());
+    pConfig->SetDifferentialBackup(pDifferentialBackupsCtrl->GetValue());
+    pConfig->SetFullBackupInterval(std::stoi(pFullBackupIntervalCtrl->GetValue().ToStdString()));
 }
 
 void DatabasePage::CreateControls()
@@ -75,6 +89,27 @@ void DatabasePage::CreateControls()
     pBrowseDatabasePathButton = new wxButton(databaseSettingsBox, IDC_DATABASE_PATH_BUTTON, wxT("Browse..."));
     databaseHorizontalSizer->Add(pBrowseDatabasePathButton, common::sizers::ControlDefault);
 
+    auto archiveSizer = new wxBoxSizer(wxHORIZONTAL);
+    databaseSizer->Add(archiveSizer, common::sizers::ControlDefault);
+
+    auto archiveAfterMonthsLabel = new wxStaticText(databaseSettingsBox, wxID_ANY, wxT("Archive After (months)"));
+    archiveSizer->Add(archiveAfterMonthsLabel, common::sizers::ControlCenter);
+
+    wxIntegerValidator<int> archiveAfterMonthsValidator;
+    archiveAfterMonthsValidator.SetMin(0);
+    archiveAfterMonthsValidator.SetMax(120);
+
+    pArchiveAfterMonthsCtrl = new wxTextCtrl(databaseSettingsBox,
+        IDC_ARCHIVE_AFTER_MONTHS,
+        wxT("0"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        archiveAfterMonthsValidator);
+    pArchiveAfterMonthsCtrl->SetToolTip(
+        wxT("Move task items older than this many months into the archive database, 0 to keep them live"));
+    archiveSizer->Add(pArchiveAfterMonthsCtrl, common::sizers::ControlDefault);
+
     sizer->Add(databaseSettingsSizer, 0, wxLEFT | wxRIGHT | wxEXPAND, 5);
 
     /* Backups Settings Panel */
@@ -107,25 +142,103 @@ void DatabasePage::CreateControls()
     auto databaseBackupsBox = new wxStaticBox(this, wxID_ANY, wxT("Backup Options"));
     auto databaseBackupsSizer = new wxStaticBoxSizer(databaseBackupsBox, wxHORIZONTAL);
 
+    auto backupOptionsVerticalSizer = new wxBoxSizer(wxVERTICAL);
+    databaseBackupsSizer->Add(backupOptionsVerticalSizer, 1, wxALL | wxEXPAND, 5);
+
     auto backupOptionsSizer = new wxBoxSizer(wxHORIZONTAL);
-    databaseBackupsSizer->Add(backupOptionsSizer, 1, wxALL | wxEXPAND, 5);
+    backupOptionsVerticalSizer->Add(backupOptionsSizer, common::sizers::ControlDefault);
+
+    auto keepDailyBackupsLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Keep Daily"));
+    backupOptionsSizer->Add(keepDailyBackupsLabel, common::sizers::ControlCenter);
+
+    wxIntegerValidator<int> retentionValidator;
+    retentionValidator.SetMin(0);
+    retentionValidator.SetMax(99);
 
-    auto deleteBackupsAfterLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Delete Backups After (days)"));
-    backupOptionsSizer->Add(deleteBackupsAfterLabel, common::sizers::ControlCenter);
+    pKeepDailyBackupsCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_KEEP_DAILY_BACKUPS,
+        wxT("7"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        retentionValidator);
+    pKeepDailyBackupsCtrl->SetToolTip(wxT("Number of days to keep the last backup of"));
+    backupOptionsSizer->Add(pKeepDailyBackupsCtrl, common::sizers::ControlDefault);
+
+    auto keepWeeklyBackupsLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Weekly"));
+    backupOptionsSizer->Add(keepWeeklyBackupsLabel, common::sizers::ControlCenter);
+
+    pKeepWeeklyBackupsCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_KEEP_WEEKLY_BACKUPS,
+        wxT("4"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        retentionValidator);
+    pKeepWeeklyBackupsCtrl->SetToolTip(wxT("Number of weeks to keep the last backup of"));
+    backupOptionsSizer->Add(pKeepWeeklyBackupsCtrl, common::sizers::ControlDefault);
 
-    wxIntegerValidator<int> integerValidator;
-    integerValidator.SetMin(1);
-    integerValidator.SetMax(30);
+    auto keepMonthlyBackupsLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Monthly"));
+    backupOptionsSizer->Add(keepMonthlyBackupsLabel, common::sizers::ControlCenter);
 
-    pDeleteBackupsAfterCtrl = new wxTextCtrl(databaseBackupsBox,
-        IDC_DELETE_BACKUPS_AFTER,
-        wxT("30"),
+    pKeepMonthlyBackupsCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_KEEP_MONTHLY_BACKUPS,
+        wxT("6"),
         wxDefaultPosition,
         wxSize(42, -1),
         wxTE_CENTRE,
-        integerValidator);
-    pDeleteBackupsAfterCtrl->SetToolTip(wxT("Number of days to keep a backup"));
-    backupOptionsSizer->Add(pDeleteBackupsAfterCtrl, common::sizers::ControlDefault);
+        retentionValidator);
+    pKeepMonthlyBackupsCtrl->SetToolTip(wxT("Number of months to keep the last backup of"));
+    backupOptionsSizer->Add(pKeepMonthlyBackupsCtrl, common::sizers::ControlDefault);
+
+    auto backupSizeLimitSizer = new wxBoxSizer(wxHORIZONTAL);
+    backupOptionsVerticalSizer->Add(backupSizeLimitSizer, common::sizers::ControlDefault);
+
+    auto backupSizeLimitLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Size Limit (MB)"));
+    backupSizeLimitSizer->Add(backupSizeLimitLabel, common::sizers::ControlCenter);
+
+    wxIntegerValidator<int> sizeLimitValidator;
+    sizeLimitValidator.SetMin(0);
+    sizeLimitValidator.SetMax(1000000);
+
+    pBackupSizeLimitCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_BACKUP_SIZE_LIMIT,
+        wxT("0"),
+        wxDefaultPosition,
+        wxSize(64, -1),
+        wxTE_CENTRE,
+        sizeLimitValidator);
+    pBackupSizeLimitCtrl->SetToolTip(wxT("Space all backups together may take up, 0 for no limit"));
+    backupSizeLimitSizer->Add(pBackupSizeLimitCtrl, common::sizers::ControlDefault);
+
+    pCompressBackupsCtrl = new wxCheckBox(databaseBackupsBox, IDC_COMPRESS_BACKUPS, wxT("Compress Backups"));
+    pCompressBackupsCtrl->SetToolTip(wxT("Store backups as gzip compressed (.db.gz) files"));
+    backupOptionsVerticalSizer->Add(pCompressBackupsCtrl, common::sizers::ControlDefault);
+
+    pDifferentialBackupsCtrl =
+        new wxCheckBox(databaseBackupsBox, IDC_DIFFERENTIAL_BACKUPS, wxT("Differential Backups"));
+    pDifferentialBackupsCtrl->SetToolTip(wxT("Only store the changes since the last full backup"));
+    backupOptionsVerticalSizer->Add(pDifferentialBackupsCtrl, common::sizers::ControlDefault);
+
+    auto fullBackupIntervalSizer = new wxBoxSizer(wxHORIZONTAL);
+    backupOptionsVerticalSizer->Add(fullBackupIntervalSizer, common::sizers::ControlDefault);
+
+    auto fullBackupIntervalLabel = new wxStaticText(databaseBackupsBox, wxID_ANY, wxT("Full Backup Every (days)"));
+    fullBackupIntervalSizer->Add(fullBackupIntervalLabel, common::sizers::ControlCenter);
+
+    wxIntegerValidator<int> fullBackupIntervalValidator;
+    fullBackupIntervalValidator.SetMin(1);
+    fullBackupIntervalValidator.SetMax(30);
+
+    pFullBackupIntervalCtrl = new wxTextCtrl(databaseBackupsBox,
+        IDC_FULL_BACKUP_INTERVAL,
+        wxT("7"),
+        wxDefaultPosition,
+        wxSize(42, -1),
+        wxTE_CENTRE,
+        fullBackupIntervalValidator);
+    pFullBackupIntervalCtrl->SetToolTip(wxT("Number of days between full backups"));
+    fullBackupIntervalSizer->Add(pFullBackupIntervalCtrl, common::sizers::ControlDefault);
 
     sizer->Add(databaseBackupsSizer, 0, wxLEFT | wxRIGHT | wxEXPAND, 5);
 
@@ -139,6 +252,8 @@ void DatabasePage::ConfigureEventBindings()
 
     pBackupDatabaseCtrl->Bind(wxEVT_CHECKBOX, &DatabasePage::OnBackupDatabaseCheck, this);
 
+    pDifferentialBackupsCtrl->Bind(wxEVT_CHECKBOX, &DatabasePage::OnDifferentialBackupsCheck, this);
+
     pBrowseBackupPathButton->Bind(
         wxEVT_BUTTON, &DatabasePage::OnOpenDirectoryForBackupLocation, this, IDC_BACKUP_PATH_BUTTON);
 }
@@ -146,14 +261,30 @@ void DatabasePage::ConfigureEventBindings()
 void DatabasePage::FillControls()
 {
     pDatabasePathTextCtrl->SetValue(pConfig->GetDatabasePath());
+    pArchiveAfterMonthsCtrl->SetValue(wxString(std::to_string(pConfig->GetArchiveAfterMonths())));
     pBackupDatabaseCtrl->SetValue(pConfig->IsBackupEnabled());
     pBackupPathTextCtrl->SetValue(pConfig->GetBackupPath());
-    pDeleteBackupsAfterCtrl->SetValue(wxString(std::to_string(pConfig->GetDeleteBackupsAfter())));
+    pKeepDailyBackupsCtrl->SetValue(wxString(std::to_string(pConfig->GetKeepDailyBackups())));
+    pKeepWeeklyBackupsCtrl->SetValue(wxString(std::to_string(pConfig->GetKeepWeeklyBackups())));
+    pKeepMonthlyBackupsCtrl->SetValue(wxString(std::to_string(pConfig->GetKeepMonthlyBackups())));
+    pBackupSizeLimitCtrl->SetValue(wxString(std::to_string(pConfig->GetBackupSizeLimit())));
+    pCompressBackupsCtrl->SetValue(pConfig->IsBackupCompressionEnabled());
+    pDifferentialBackupsCtrl->SetValue(pConfig->IsDifferentialBackupEnabled());
+    pFullBackupIntervalCtrl->SetValue(wxString(std::to_string(pConfig->GetFullBackupInterval())));
 
     if (!pBackupDatabaseCtrl->GetValue()) {
         pBackupPathTextCtrl->Disable();
         pBrowseBackupPathButton->Disable();
-        pDeleteBackupsAfterCtrl->Disable();
+        pKeepDailyBackupsCtrl->Disable();
+        pKeepWeeklyBackupsCtrl->Disable();
+        pKeepMonthlyBackupsCtrl->Disable();
+        pBackupSizeLimitCtrl->Disable();
+        pCompressBackupsCtrl->Disable();
+        pDifferentialBackupsCtrl->Disable();
+    }
+
+    if (!pBackupDatabaseCtrl->GetValue() || !pDifferentialBackupsCtrl->GetValue()) {
+        pFullBackupIntervalCtrl->Disable();
     }
 }
 
@@ -184,14 +315,31 @@ void DatabasePage::OnBackupDatabaseCheck(wxCommandEvent& event)
     if (event.IsChecked()) {
         pBackupPathTextCtrl->Enable();
         pBrowseBackupPathButton->Enable();
-        pDeleteBackupsAfterCtrl->Enable();
+        pKeepDailyBackupsCtrl->Enable();
+        pKeepWeeklyBackupsCtrl->Enable();
+        pKeepMonthlyBackupsCtrl->Enable();
+        pBackupSizeLimitCtrl->Enable();
+        pCompressBackupsCtrl->Enable();
+        pDifferentialBackupsCtrl->Enable();
+        pFullBackupIntervalCtrl->Enable(pDifferentialBackupsCtrl->GetValue());
     } else {
         pBackupPathTextCtrl->Disable();
         pBrowseBackupPathButton->Disable();
-        pDeleteBackupsAfterCtrl->Disable();
+        pKeepDailyBackupsCtrl->Disable();
+        pKeepWeeklyBackupsCtrl->Disable();
+        pKeepMonthlyBackupsCtrl->Disable();
+        pBackupSizeLimitCtrl->Disable();
+        pCompressBackupsCtrl->Disable();
+        pDifferentialBackupsCtrl->Disable();
+        pFullBackupIntervalCtrl->Disable();
     }
 }
 
+void DatabasePage::OnDifferentialBackupsCheck(wxCommandEvent& event)
+{
+    pFullBackupIntervalCtrl->Enable(event.IsChecked());
+}
+
 void DatabasePage::OnOpenDirectoryForBackupLocation(wxCommandEvent& event)
 {
     wxString pathDirectory = wxGetEmptyString();
@@ -46,6 +46,7 @@ class DatabasePage final : public wxPanel
 
     void OnOpenDirectoryForDatabaseLocation(wxCommandEvent& event);
     void OnBackupDatabaseCheck(wxCommandEvent& event);
+    void OnDifferentialBackupsCheck(wxCommandEvent& event);
     void OnOpenDirectoryForBackupLocation(wxCommandEvent& event);
 
     std::shared_ptr<cfg::Configuration> pConfig;
@@ -54,18 +55,32 @@ class DatabasePage final : public wxPanel
 
     wxTextCtrl* pDatabasePathTextCtrl;
     wxButton* pBrowseDatabasePathButton;
+    wxTextCtrl* pArchiveAfterMonthsCtrl;
     wxCheckBox* pBackupDatabaseCtrl;
     wxTextCtrl* pBackupPathTextCtrl;
     wxButton* pBrowseBackupPathButton;
-    wxTextCtrl* pDeleteBackupsAfterCtrl;
+    wxTextCtrl* pKeepDailyBackupsCtrl;
+    wxTextCtrl* pKeepWeeklyBackupsCtrl;
+    wxTextCtrl* pKeepMonthlyBackupsCtrl;
+    wxTextCtrl* pBackupSizeLimitCtrl;
+    wxCheckBox* pCompressBackupsCtrl;
+    wxCheckBox* pDifferentialBackupsCtrl;
+    wxTextCtrl* pFullBackupIntervalCtrl;
 
     enum {
         IDC_DATABASE_PATH = wxID_HIGHEST + 1,
         IDC_DATABASE_PATH_BUTTON,
+        IDC_ARCHIVE_AFTER_MONTHS,
         IDC_BACKUP_DATABASE,
         IDC_BACKUP_PATH,
         IDC_BACKUP_PATH_BUTTON,
-        IDC_DELETE_BACKUPS_AFTER
+        IDC_KEEP_DAILY_BACKUPS,
+        IDC_KEEP_WEEKLY_BACKUPS,
+        IDC_KEEP_MONTHLY_BACKUPS,
+        IDC_BACKUP_SIZE_LIMIT,
+        IDC_COMPRESS_BACKUPS,
+        IDC_DIFFERENTIAL_BACKUPS,
+        IDC_FULL_BACKUP_INTERVAL
     };
 };
 } // namespace app::dlg
@@ -31,6 +31,8 @@ StopwatchPage::StopwatchPage(wxWindow* parent, std::shared_ptr<cfg::Configuratio
     , pHideWindowTimeChoiceCtrl(nullptr)
     , pNotificationTimeChoiceCtrl(nullptr)
     , pPausedTaskReminderChoiceCtrl(nullptr)
+    , pIdleDetectionCtrl(nullptr)
+    , pIdleThresholdChoiceCtrl(nullptr)
     , pStartStopwatchOnLaunchCtrl(nullptr)
 {
     CreateControls();
@@ -45,6 +47,8 @@ void StopwatchPage::Apply()
     pConfig->SetNotificationTimerInterval(std::stoi(pNotificationTimeChoiceCtrl->GetStringSelection().ToStdString()));
     pConfig->SetPausedTaskReminderInterval(
         std::stoi(pPausedTaskReminderChoiceCtrl->GetStringSelection().ToStdString()));
+    pConfig->SetIdleDetection(pIdleDetectionCtrl->GetValue());
+    pConfig->SetIdleThreshold(std::stoi(pIdleThresholdChoiceCtrl->GetStringSelection().ToStdString()));
     pConfig->SetStartStopwatchOnLaunch(pStartStopwatchOnLaunchCtrl->GetValue());
 }
 
@@ -115,6 +119,30 @@ void StopwatchPage::CreateControls()
     pPausedTaskReminderChoiceCtrl->SetToolTip(wxT("Select a interval in minutes for a reminder when a task is paused"));
     stopwatchGridSizer->Add(pPausedTaskReminderChoiceCtrl, common::sizers::ControlDefault);
 
+    pIdleDetectionCtrl = new wxCheckBox(stopwatchSettingsBox, IDC_IDLE_DETECTION, wxT("Detect Idle Time"));
+    pIdleDetectionCtrl->SetToolTip(wxT("Pause a running task when there is no keyboard or mouse input"));
+    stopwatchGridSizer->Add(pIdleDetectionCtrl, common::sizers::ControlDefault);
+
+    stopwatchGridSizer->Add(0, 0);
+
+    auto idleThresholdText = new wxStaticText(stopwatchSettingsBox, wxID_ANY, wxT("Idle Threshold (m)"));
+    stopwatchGridSizer->Add(idleThresholdText, common::sizers::ControlDefault);
+
+    wxArrayString idleThresholdChoices;
+    idleThresholdChoices.Add(wxT("3"));
+    idleThresholdChoices.Add(wxT("5"));
+    idleThresholdChoices.Add(wxT("10"));
+    idleThresholdChoices.Add(wxT("15"));
+    idleThresholdChoices.Add(wxT("30"));
+
+    pIdleThresholdChoiceCtrl = new wxChoice(stopwatchSettingsBox,
+        IDC_IDLE_THRESHOLD_CHOICE,
+        wxDefaultPosition,
+        wxSize(150, -1),
+        idleThresholdChoices);
+    pIdleThresholdChoiceCtrl->SetToolTip(wxT("Select after how many minutes without input a task is paused"));
+    stopwatchGridSizer->Add(pIdleThresholdChoiceCtrl, common::sizers::ControlDefault);
+
     pStartStopwatchOnLaunchCtrl =
         new wxCheckBox(stopwatchSettingsBox, IDC_START_STOPWATCH_ON_LAUNCH, wxT("Start Stopwatch on Launch"));
     pStartStopwatchOnLaunchCtrl->SetToolTip(
@@ -131,6 +159,7 @@ void StopwatchPage::CreateControls()
 void StopwatchPage::ConfigureEventBindings()
 {
     pMinimizeStopwatchWindowCtrl->Bind(wxEVT_CHECKBOX, &StopwatchPage::OnMinimizeTimedTaskWindowCheck, this);
+    pIdleDetectionCtrl->Bind(wxEVT_CHECKBOX, &StopwatchPage::OnIdleDetectionCheck, this);
 }
 
 void StopwatchPage::FillControls()
@@ -143,6 +172,13 @@ void StopwatchPage::FillControls()
     pHideWindowTimeChoiceCtrl->SetStringSelection(std::to_string(pConfig->GetHideWindowTimerInterval()));
     pNotificationTimeChoiceCtrl->SetStringSelection(std::to_string(pConfig->GetNotificationTimerInterval()));
     pPausedTaskReminderChoiceCtrl->SetStringSelection(std::to_string(pConfig->GetPausedTaskReminderInterval()));
+    pIdleDetectionCtrl->SetValue(pConfig->IsIdleDetectionEnabled());
+    if (!pConfig->IsIdleDetectionEnabled()) {
+        pIdleThresholdChoiceCtrl->Disable();
+    }
+    if (!pIdleThresholdChoiceCtrl->SetStringSelection(std::to_string(pConfig->GetIdleThreshold()))) {
+        pIdleThresholdChoiceCtrl->SetStringSelection(wxT("5"));
+    }
     pStartStopwatchOnLaunchCtrl->SetValue(pConfig->IsStartStopwatchOnLaunch());
 }
 
@@ -154,4 +190,13 @@ void StopwatchPage::OnMinimizeTimedTaskWindowCheck(wxCommandEvent& event)
         pHideWindowTimeChoiceCtrl->Disable();
     }
 }
+
+void StopwatchPage::OnIdleDetectionCheck(wxCommandEvent& event)
+{
+    if (event.IsChecked()) {
+        pIdleThresholdChoiceCtrl->Enable();
+    } else {
+        pIdleThresholdChoiceCtrl->Disable();
+    }
+}
 } // namespace app::dlg
@@ -45,6 +45,7 @@ class StopwatchPage final : public wxPanel
     void FillControls();
 
     void OnMinimizeTimedTaskWindowCheck(wxCommandEvent& event);
+    void OnIdleDetectionCheck(wxCommandEvent& event);
 
     std::shared_ptr<cfg::Configuration> pConfig;
 
@@ -54,6 +55,8 @@ class StopwatchPage final : public wxPanel
     wxChoice* pHideWindowTimeChoiceCtrl;
     wxChoice* pNotificationTimeChoiceCtrl;
     wxChoice* pPausedTaskReminderChoiceCtrl;
+    wxCheckBox* pIdleDetectionCtrl;
+    wxChoice* pIdleThresholdChoiceCtrl;
     wxCheckBox* pStartStopwatchOnLaunchCtrl;
 
     enum {
@@ -61,6 +64,8 @@ class StopwatchPage final : public wxPanel
         IDC_HIDE_WINDOW_TIME_CHOICE,
         IDC_NOTIFICATION_TIME_CHOICE,
         IDC_PAUSED_TASK_REMINDER_CHOICE,
+        IDC_IDLE_DETECTION,
+        IDC_IDLE_THRESHOLD_CHOICE,
         IDC_START_STOPWATCH_ON_LAUNCH,
     };
 };
@@ -19,12 +19,13 @@
 
 #include "stopwatchtaskdlg.h"
 
+#include <chrono>
+
 #include <wx/notifmsg.h>
 #include <wx/statline.h>
 
 #include "../common/common.h"
 #include "../common/util.h"
-#include "../services/taskstateservice.h"
 #include "taskitemdlg.h"
 
 wxDEFINE_EVENT(START_NEW_STOPWATCH_TASK, wxCommandEvent);
@@ -35,14 +36,22 @@ static const wxString ElapsedTimeText = wxT("Elapsed Time: %s");
 static const wxString AccumulatedTimeText = wxT("Time accumulated thus far: %s");
 static const wxString TaskRunningForText = wxT("Task running for: %s");
 static const wxString PendingPausedTaskText = wxT("There is a pending pasued task");
+static const wxString TimeAwayText = wxT("The task was paused while you were away for %s.\n"
+                                         "Do you want to keep the time you were away as part of the task?");
+static const wxString TimeSinceRestoreText = wxT("The task was running when the program closed, last saved at %s.\n"
+                                                 "Do you want to keep the time since then (%s) as part of the task?");
+static const wxString JournalErrorText = wxT("The stopwatch could not be saved to disk.\n"
+                                             "The task will not be restored if the program closes unexpectedly.");
+
+static const auto ElapsedRefreshInterval = std::chrono::milliseconds(1000);
+static const auto ReminderLeeway = std::chrono::seconds(5);
+static const auto CheckpointInterval = std::chrono::seconds(60);
 
 // clang-format off
 wxBEGIN_EVENT_TABLE(StopwatchTaskDialog, wxDialog)
 EVT_CLOSE(StopwatchTaskDialog::OnClose)
-EVT_TIMER(StopwatchTaskDialog::IDC_NOTIFICATION_TIMER, StopwatchTaskDialog::OnTimer)
-EVT_TIMER(StopwatchTaskDialog::IDC_ELAPSED_TIMER, StopwatchTaskDialog::OnElapsedTimeUpdate)
-EVT_TIMER(StopwatchTaskDialog::IDC_HIDE_WINDOW_TIMER, StopwatchTaskDialog::OnHideWindow)
-EVT_TIMER(StopwatchTaskDialog::IDC_PAUSED_TASK_REMINDER, StopwatchTaskDialog::OnPausedTaskReminder)
+EVT_SHOW(StopwatchTaskDialog::OnShow)
+EVT_ICONIZE(StopwatchTaskDialog::OnIconize)
 EVT_BUTTON(StopwatchTaskDialog::IDC_START, StopwatchTaskDialog::OnStart)
 EVT_BUTTON(StopwatchTaskDialog::IDC_PAUSE, StopwatchTaskDialog::OnPause)
 EVT_BUTTON(StopwatchTaskDialog::IDC_STOP, StopwatchTaskDialog::OnStop)
@@ -52,7 +61,10 @@ wxEND_EVENT_TABLE()
 StopwatchTaskDialog::StopwatchTaskDialog(wxWindow* parent,
     std::shared_ptr<cfg::Configuration> config,
     std::shared_ptr<spdlog::logger> logger,
-    std::shared_ptr<services::TaskStateService> taskState,
+    std::shared_ptr<services::StopwatchRegistry> registry,
+    std::shared_ptr<services::TickScheduler> scheduler,
+    std::shared_ptr<services::IdleDetector> idleDetector,
+    int stopwatchId,
     frm::TaskBarIcon *taskBarIcon,
     const wxString& name)
     : pLogger(logger)
@@ -65,64 +77,67 @@ StopwatchTaskDialog::StopwatchTaskDialog(wxWindow* parent,
     , pPauseButton(nullptr)
     , pStopButton(nullptr)
     , pCancelButton(nullptr)
-    , pElapsedTimer(std::make_unique<wxTimer>(this, IDC_ELAPSED_TIMER))
-    , pNotificationTimer(std::make_unique<wxTimer>(this, IDC_NOTIFICATION_TIMER))
-    , pHideWindowTimer(std::make_unique<wxTimer>(this, IDC_HIDE_WINDOW_TIMER))
-    , pPausedTaskReminder(std::make_unique<wxTimer>(this, IDC_PAUSED_TASK_REMINDER))
     , pConfig(config)
-    , pTaskState(taskState)
+    , pRegistry(registry)
+    , pScheduler(scheduler)
+    , pIdleDetector(idleDetector)
+    , pStopwatch(registry->Get(stopwatchId))
     , pTaskBarIcon(taskBarIcon)
-    , mStartTime(wxDefaultDateTime)
-    , mEndTime(wxDefaultDateTime)
-    , bWasTaskPaused(false)
-    , bHasPendingPausedTask(false)
+    , mStopwatchId(stopwatchId)
+    , mElapsedRefreshTaskId(-1)
+    , mCheckpointTaskId(-1)
+    , mNotificationTaskId(-1)
+    , mPausedTaskReminderTaskId(-1)
+    , mIdleSubscriptionId(-1)
+    , mNotificationSubscriptionId(-1)
+    , mPausedTaskReminderSubscriptionId(-1)
+    , bWasPausedOnIdle(false)
+    , bWasJournalErrorShown(false)
 // clang-format on
 {
     Create(parent,
         wxID_ANY,
-        wxT("Stopwatch"),
+        wxString::Format(wxT("Stopwatch #%d"), stopwatchId),
         wxDefaultPosition,
         wxSize(420, 380),
         wxCAPTION | wxCLOSE_BOX | wxSYSTEM_MENU,
         name);
+
+    /* the elapsed time display is only refreshed while the dialog can be seen */
+    mElapsedRefreshTaskId = pScheduler->ScheduleRefresh([this]() { return common::IsWindowVisible(this); },
+        ElapsedRefreshInterval,
+        [this]() { OnElapsedTimeUpdate(); });
+
+    /* unlike the display refresh, checkpoints keep going while the dialog is hidden in the tray */
+    mCheckpointTaskId = pScheduler->Schedule(CheckpointInterval, [this]() { OnCheckpoint(); }, ReminderLeeway);
+
+    mIdleSubscriptionId = pIdleDetector->Subscribe(
+        [this](auto lastActivity) { OnIdle(lastActivity); }, [this](auto lastActivity) { OnActive(lastActivity); });
+
+    /* a reminder that is already running picks up a changed interval straight away */
+    mNotificationSubscriptionId =
+        pConfig->Subscribe(cfg::Setting::NotificationTimer, [this](const cfg::Settings& settings) {
+            if (pScheduler->IsScheduled(mNotificationTaskId)) {
+                ScheduleNotification(settings.mNotificationTimerInterval);
+            }
+        });
+    mPausedTaskReminderSubscriptionId =
+        pConfig->Subscribe(cfg::Setting::PausedTaskReminder, [this](const cfg::Settings& settings) {
+            if (pScheduler->IsScheduled(mPausedTaskReminderTaskId)) {
+                SchedulePausedTaskReminder(settings.mPausedTaskReminderInterval);
+            }
+        });
 }
 
-StopwatchTaskDialog::StopwatchTaskDialog(wxWindow* parent,
-    std::shared_ptr<cfg::Configuration> config,
-    std::shared_ptr<spdlog::logger> logger,
-    std::shared_ptr<services::TaskStateService> taskState,
-    frm::TaskBarIcon* taskBarIcon,
-    bool hasPendingPausedTask,
-    const wxString& name)
-    : pLogger(logger)
-    , pParent(parent)
-    , pElapsedTimeText(nullptr)
-    , pAccumulatedTimeText(nullptr)
-    , pStartNewTask(nullptr)
-    , pStopwatchDescription(nullptr)
-    , pStartButton(nullptr)
-    , pPauseButton(nullptr)
-    , pStopButton(nullptr)
-    , pCancelButton(nullptr)
-    , pElapsedTimer(std::make_unique<wxTimer>(this, IDC_ELAPSED_TIMER))
-    , pNotificationTimer(std::make_unique<wxTimer>(this, IDC_NOTIFICATION_TIMER))
-    , pHideWindowTimer(std::make_unique<wxTimer>(this, IDC_HIDE_WINDOW_TIMER))
-    , pPausedTaskReminder(std::make_unique<wxTimer>(this, IDC_PAUSED_TASK_REMINDER))
-    , pConfig(config)
-    , pTaskState(taskState)
-    , pTaskBarIcon(taskBarIcon)
-    , mStartTime(wxDefaultDateTime)
-    , mEndTime(wxDefaultDateTime)
-    , bWasTaskPaused(false)
-    , bHasPendingPausedTask(hasPendingPausedTask)
+StopwatchTaskDialog::~StopwatchTaskDialog()
 {
-    Create(parent,
-        wxID_ANY,
-        wxT("Stopwatch"),
-        wxDefaultPosition,
-        wxSize(420, 320),
-        wxCAPTION | wxCLOSE_BOX | wxSYSTEM_MENU,
-        name);
+    pScheduler->Cancel(mElapsedRefreshTaskId);
+    pScheduler->Cancel(mCheckpointTaskId);
+    pScheduler->Cancel(mNotificationTaskId);
+    pScheduler->Cancel(mPausedTaskReminderTaskId);
+    pIdleDetector->Unsubscribe(mIdleSubscriptionId);
+    pConfig->Unsubscribe(mNotificationSubscriptionId);
+    pConfig->Unsubscribe(mPausedTaskReminderSubscriptionId);
 }
 
 void StopwatchTaskDialog::Launch()
@@ -131,14 +146,18 @@ void StopwatchTaskDialog::Launch()
     pStopButton->Disable();
     pStartNewTask->Disable();
 
-    if (pConfig->IsStartStopwatchOnLaunch()) {
+    if (pStopwatch->IsRunning()) {
+        /* the stopwatch was restored from its journal while running */
+        ExecuteResumeRunningProcedure();
+        CallAfter([this]() { PromptForTimeSinceRestore(); });
+    } else if (pConfig->IsStartStopwatchOnLaunch()) {
         ExecuteStartupProcedure();
         pPauseButton->SetDefault();
     } else {
         pStartButton->SetDefault();
     }
 
-    wxDialog::ShowModal();
+    wxDialog::Show();
 }
 
 void StopwatchTaskDialog::Relaunch()
@@ -157,17 +176,14 @@ void StopwatchTaskDialog::Relaunch()
         pStartNewTask->Disable();
     }
 
-    /* set state */
-    bWasTaskPaused = true;
-
     /* restore state */
-    auto accumulatedTimeThusFar = pTaskState->GetAccumulatedTime();
+    auto accumulatedTimeThusFar = pStopwatch->GetAccumulatedTime();
     pAccumulatedTimeText->SetLabel(wxString::Format(AccumulatedTimeText, accumulatedTimeThusFar.Format()));
-    if (!pTaskState->GetStoredDescription().empty()) {
-        pStopwatchDescription->ChangeValue(pTaskState->GetStoredDescription());
+    if (!pStopwatch->GetDescription().empty()) {
+        pStopwatchDescription->ChangeValue(pStopwatch->GetDescription());
     }
 
-    wxDialog::ShowModal();
+    wxDialog::Show();
 }
 
 bool StopwatchTaskDialog::Create(wxWindow* parent,
@@ -274,20 +290,30 @@ void StopwatchTaskDialog::CreateControls()
 
 void StopwatchTaskDialog::ExecuteStartupProcedure()
 {
-    /* get the current time */
-    mStartTime = wxDateTime::Now();
+    /* start the stopwatch */
+    pStopwatch->Start();
+    WarnOnJournalError();
 
-    /* set state */
-    bIsPaused = false;
+    ExecuteResumeRunningProcedure();
+}
+
+void StopwatchTaskDialog::ExecuteResumeRunningProcedure()
+{
+    /* restore state */
+    if (pStopwatch->GetIntervalCount() > 0) {
+        auto accumulatedTimeThusFar = pStopwatch->GetAccumulatedTime();
+        pAccumulatedTimeText->SetLabel(wxString::Format(AccumulatedTimeText, accumulatedTimeThusFar.Format()));
+    }
+    if (pStopwatchDescription->GetValue().empty() && !pStopwatch->GetDescription().empty()) {
+        pStopwatchDescription->ChangeValue(pStopwatch->GetDescription());
+    }
 
-    /* start the timers */
-    pElapsedTimer->Start(1000 /*milliseconds*/);
-    pNotificationTimer->Start(util::MinutesToMilliseconds(pConfig->GetNotificationTimerInterval()));
+    /* start the notification task */
+    OnElapsedTimeUpdate();
+    ScheduleNotification(pConfig->GetNotificationTimerInterval());
 
     /* stop paused task reminder */
-    if (pPausedTaskReminder->IsRunning()) {
-        pPausedTaskReminder->Stop();
-    }
+    pScheduler->Cancel(mPausedTaskReminderTaskId);
 
     /* enable stop and pause buttons */
     pStopButton->Enable();
@@ -296,20 +322,12 @@ void StopwatchTaskDialog::ExecuteStartupProcedure()
     /* disable start button */
     pStartButton->Disable();
 
-    /* check for pending task */
-    if (bHasPendingPausedTask) {
-        pStartNewTask->Disable();
-    } else {
-        pStartNewTask->Enable();
-    }
+    /* enable checkbox to start new task */
+    pStartNewTask->Enable();
 }
 
 void StopwatchTaskDialog::ExecutePauseProcedure()
 {
-    /* set state */
-    bIsPaused = true;
-    bWasTaskPaused = true;
-
     /* enable start button */
     pStartButton->Enable();
     pStartButton->SetDefault();
@@ -320,53 +338,43 @@ void StopwatchTaskDialog::ExecutePauseProcedure()
     /* disable checkbox to start new task */
     pStartNewTask->Disable();
 
-    /* stop timers */
-    pNotificationTimer->Stop();
-    pElapsedTimer->Stop();
+    /* stop notification task */
+    pScheduler->Cancel(mNotificationTaskId);
 
-    /* start timer */
-    pPausedTaskReminder->Start(util::MinutesToMilliseconds(pConfig->GetPausedTaskReminderInterval()));
-
-    /* get the current end time */
-    mEndTime = wxDateTime::Now();
+    /* start paused task reminder */
+    SchedulePausedTaskReminder(pConfig->GetPausedTaskReminderInterval());
 
     /* save state */
-    pTaskState->PushTimes(mStartTime, mEndTime);
     if (!pStopwatchDescription->GetValue().empty()) {
-        if (pStopwatchDescription->GetValue() != pTaskState->GetStoredDescription()) {
-            pTaskState->StoreDescription(pStopwatchDescription->GetValue());
-        }
+        pStopwatch->SetDescription(pStopwatchDescription->GetValue());
     }
+    pStopwatch->Pause();
+    WarnOnJournalError();
 
     /* update UI */
-    auto accumulatedTimeThusFar = pTaskState->GetAccumulatedTime();
+    auto accumulatedTimeThusFar = pStopwatch->GetAccumulatedTime();
     pAccumulatedTimeText->SetLabel(wxString::Format(AccumulatedTimeText, accumulatedTimeThusFar.Format()));
 
     /* check if a new stopwatch task needs to be started */
     if (pStartNewTask->IsChecked()) {
+        pStartNewTask->SetValue(false);
         wxCommandEvent startNewStopwatchTask(START_NEW_STOPWATCH_TASK);
         wxPostEvent(pParent, startNewStopwatchTask);
-        EndModal(wxID_OK);
     }
 }
 
-void StopwatchTaskDialog::ExecuteStopProcedure()
+bool StopwatchTaskDialog::ExecuteStopProcedure()
 {
-    /* did the user go from pause to stop state? */
-    if (!bIsPaused) {
-        /* get the current end time */
-        mEndTime = wxDateTime::Now();
-
-        /* push state */
-        pTaskState->PushTimes(mStartTime, mEndTime);
+    /* close the running interval, if the user went from pause to stop state there is none */
+    if (!pStopwatchDescription->GetValue().empty()) {
+        pStopwatch->SetDescription(pStopwatchDescription->GetValue());
     }
+    pStopwatch->Stop();
+    WarnOnJournalError();
 
-    /* stop timers */
-    pNotificationTimer->Stop();
-    pElapsedTimer->Stop();
-    if (pPausedTaskReminder->IsRunning()) {
-        pPausedTaskReminder->Stop();
-    }
+    /* stop scheduled tasks */
+    pScheduler->Cancel(mNotificationTaskId);
+    pScheduler->Cancel(mPausedTaskReminderTaskId);
 
     /* disable buttons */
     pStopButton->Disable();
@@ -374,40 +382,89 @@ void StopwatchTaskDialog::ExecuteStopProcedure()
     pStartButton->Disable();
     pStartNewTask->Disable();
 
-    /* was the task paused previously? */
-    if (bWasTaskPaused) {
-        /* save state */
-        auto accumulatedTimeThusFar = pTaskState->GetAccumulatedTime();
-        pAccumulatedTimeText->SetLabel(wxString::Format(AccumulatedTimeText, accumulatedTimeThusFar.Format()));
+    /* nothing has been tracked, e.g. the task was stopped right after discarding the time since a crash */
+    if (pStopwatch->GetIntervalCount() == 0) {
+        pStopwatch->Reset();
+        return true;
+    }
 
-        /* sum up the time for the task */
-        auto durationOfTask = pTaskState->GetAccumulatedTime();
+    /* update UI */
+    auto accumulatedTimeThusFar = pStopwatch->GetAccumulatedTime();
+    pAccumulatedTimeText->SetLabel(wxString::Format(AccumulatedTimeText, accumulatedTimeThusFar.Format()));
 
-        /* launch dialog */
-        dlg::TaskItemDialog newTask(this->GetParent(), pLogger, pConfig, constants::TaskItemTypes::EntryTask);
-        newTask.SetDurationFromStopwatchTask(durationOfTask);
-        newTask.SetDescriptionFromStopwatchTask(pStopwatchDescription->GetValue());
-        newTask.ShowModal();
-    } else {
-        /* launch dialog */
-        dlg::TaskItemDialog newTask(this->GetParent(), pLogger, pConfig, constants::TaskItemTypes::TimedTask);
-        newTask.SetTimesFromStopwatchTask(mStartTime, mEndTime);
-        newTask.SetDescriptionFromStopwatchTask(pStopwatchDescription->GetValue());
-        newTask.ShowModal();
+    /* every interval is saved as its own timed task item, the task item dialog only asks for its details */
+    dlg::TaskItemDialog newTask(this->GetParent(), pLogger, pConfig, constants::TaskItemTypes::TimedTask);
+    newTask.SetIntervalsFromStopwatchTask(pStopwatch->GetIntervals());
+    newTask.SetDescriptionFromStopwatchTask(pStopwatchDescription->GetValue());
+    int ret = newTask.ShowModal();
+
+    if (ret != wxID_OK) {
+        /* the task was not saved, keep the stopwatch around in its paused state so no time is lost */
+        pStartButton->Enable();
+        pStartButton->SetDefault();
+        pStopButton->Enable();
+        SchedulePausedTaskReminder(pConfig->GetPausedTaskReminderInterval());
+        return false;
     }
+
+    /* the task has been saved by the task item dialog so the journal can be discarded */
+    pStopwatch->Reset();
+    return true;
+}
+
+/* Shown once per stopwatch, the journal is not retried until the stopwatch is reset */
+void StopwatchTaskDialog::WarnOnJournalError()
+{
+    if (pStopwatch->IsJournalIntact() || bWasJournalErrorShown) {
+        return;
+    }
+
+    bWasJournalErrorShown = true;
+    wxMessageBox(JournalErrorText, GetTitle(), wxOK | wxICON_WARNING, this);
 }
 
-void StopwatchTaskDialog::OnElapsedTimeUpdate(wxTimerEvent& WXUNUSED(event))
+void StopwatchTaskDialog::Dismiss()
 {
-    auto current = wxDateTime::Now();
-    auto timeDiff = current - mStartTime;
+    pRegistry->Remove(mStopwatchId);
+    Destroy();
+}
+
+void StopwatchTaskDialog::ScheduleNotification(int intervalMinutes)
+{
+    pScheduler->Cancel(mNotificationTaskId);
+    mNotificationTaskId = pScheduler->Schedule(std::chrono::milliseconds(util::MinutesToMilliseconds(intervalMinutes)),
+        [this]() { OnNotification(); },
+        ReminderLeeway);
+}
+
+void StopwatchTaskDialog::SchedulePausedTaskReminder(int intervalMinutes)
+{
+    pScheduler->Cancel(mPausedTaskReminderTaskId);
+    mPausedTaskReminderTaskId =
+        pScheduler->Schedule(std::chrono::milliseconds(util::MinutesToMilliseconds(intervalMinutes)),
+            [this]() { OnPausedTaskReminder(); },
+            ReminderLeeway);
+}
+
+void StopwatchTaskDialog::OnElapsedTimeUpdate()
+{
+    if (!pStopwatch->IsRunning()) {
+        return;
+    }
+
+    auto timeDiff = pStopwatch->GetElapsedTime();
     pElapsedTimeText->SetLabel(wxString::Format(ElapsedTimeText, timeDiff.Format()));
 }
 
-void StopwatchTaskDialog::OnTimer(wxTimerEvent& WXUNUSED(event))
+void StopwatchTaskDialog::OnCheckpoint()
+{
+    pStopwatch->Checkpoint();
+    WarnOnJournalError();
+}
+
+void StopwatchTaskDialog::OnNotification()
 {
-    auto current = wxDateTime::Now();
-    auto elapsed = current - mStartTime;
+    auto elapsed = pStopwatch->GetElapsedTime();
     auto message = wxString::Format(TaskRunningForText, elapsed.Format());
 
     wxNotificationMessage taskElaspedMessage(common::GetProgramName(), message, this);
@@ -415,21 +472,116 @@ void StopwatchTaskDialog::OnTimer(wxTimerEvent& WXUNUSED(event))
     taskElaspedMessage.Show();
 }
 
-void StopwatchTaskDialog::OnHideWindow(wxTimerEvent& WXUNUSED(event))
-{
-    Iconize(true);
-    pHideWindowTimer->Stop();
-}
-
-void StopwatchTaskDialog::OnPausedTaskReminder(wxTimerEvent& event)
+void StopwatchTaskDialog::OnPausedTaskReminder()
 {
     wxNotificationMessage pausedTaskMessage(common::GetProgramName(), PendingPausedTaskText, this);
     pausedTaskMessage.SetIcon(common::GetProgramIcon64());
     pausedTaskMessage.Show();
 }
 
+/*
+ Nobody has been at the keyboard for a while: close the running interval at the last activity
+ so the idle time is not counted, the user is asked about it once they are back
+ */
+void StopwatchTaskDialog::OnIdle(services::IdleDetector::Clock::time_point lastActivity)
+{
+    if (!pStopwatch->IsRunning()) {
+        return;
+    }
+
+    pStopwatch->PauseAt(lastActivity);
+    bWasPausedOnIdle = true;
+
+    pStartNewTask->SetValue(false);
+    ExecutePauseProcedure();
+}
+
+void StopwatchTaskDialog::OnActive(services::IdleDetector::Clock::time_point lastActivity)
+{
+    if (!bWasPausedOnIdle) {
+        return;
+    }
+
+    bWasPausedOnIdle = false;
+
+    /* do not block the scheduler wakeup that delivered this with a modal prompt */
+    CallAfter([this, lastActivity]() { PromptForTimeAway(lastActivity); });
+}
+
+void StopwatchTaskDialog::PromptForTimeAway(services::IdleDetector::Clock::time_point lastActivity)
+{
+    /* the user may have resumed or stopped the task on their own in the meantime */
+    if (pStopwatch->IsRunning()) {
+        return;
+    }
+
+    auto away = std::chrono::duration_cast<std::chrono::milliseconds>(
+        services::IdleDetector::Clock::now() - lastActivity);
+    wxMessageDialog prompt(this,
+        wxString::Format(TimeAwayText, wxTimeSpan::Milliseconds(away.count()).Format()),
+        GetTitle(),
+        wxYES_NO | wxCANCEL | wxICON_QUESTION);
+    prompt.SetYesNoCancelLabels(wxT("&Keep"), wxT("&Discard"), wxT("Stay &Paused"));
+
+    int ret = prompt.ShowModal();
+    if (ret == wxID_YES) {
+        /* reopen the task from the last activity, so the time away is counted */
+        pStopwatch->StartFrom(lastActivity);
+        ExecuteResumeRunningProcedure();
+    } else if (ret == wxID_NO) {
+        ExecuteStartupProcedure();
+    }
+}
+
+/*
+ The interval restored from the journal kept running while the program was not, the time between
+ the last recorded event and now is only kept if the user says so
+ */
+void StopwatchTaskDialog::PromptForTimeSinceRestore()
+{
+    /* the user may have paused or stopped the task on their own in the meantime */
+    if (!pStopwatch->IsRunning()) {
+        return;
+    }
+
+    auto lastRecordTime = pStopwatch->GetLastRecordTime();
+    auto sinceLastRecord = wxDateTime::UNow() - lastRecordTime;
+    wxMessageDialog prompt(this,
+        wxString::Format(TimeSinceRestoreText, lastRecordTime.FormatISOCombined(' '), sinceLastRecord.Format()),
+        GetTitle(),
+        wxYES_NO | wxICON_QUESTION);
+    prompt.SetYesNoLabels(wxT("&Keep"), wxT("&Discard"));
+
+    if (prompt.ShowModal() == wxID_NO) {
+        pStopwatch->PauseAtLastRecord();
+        ExecutePauseProcedure();
+    }
+}
+
+void StopwatchTaskDialog::OnShow(wxShowEvent& event)
+{
+    /* refresh right away, the refresh task was throttled while the dialog was hidden */
+    if (event.IsShown()) {
+        OnElapsedTimeUpdate();
+        pScheduler->Restart(mElapsedRefreshTaskId);
+    }
+
+    event.Skip();
+}
+
+void StopwatchTaskDialog::OnIconize(wxIconizeEvent& event)
+{
+    if (!event.IsIconized()) {
+        OnElapsedTimeUpdate();
+        pScheduler->Restart(mElapsedRefreshTaskId);
+    }
+
+    event.Skip();
+}
+
 void StopwatchTaskDialog::OnStart(wxCommandEvent& WXUNUSED(event))
 {
+    bWasPausedOnIdle = false;
     ExecuteStartupProcedure();
 }
 
@@ -440,21 +592,21 @@ void StopwatchTaskDialog::OnPause(wxCommandEvent& WXUNUSED(event))
 
 void StopwatchTaskDialog::OnStop(wxCommandEvent& WXUNUSED(event))
 {
-    ExecuteStopProcedure();
-
-    EndModal(wxID_OK);
+    if (ExecuteStopProcedure()) {
+        Dismiss();
+    }
 }
 
 void StopwatchTaskDialog::OnCancel(wxCommandEvent& event)
 {
-    pTaskState->mTimes.clear();
-    EndModal(wxID_CANCEL);
+    pStopwatch->Reset();
+    Dismiss();
 }
 
 void StopwatchTaskDialog::OnClose(wxCloseEvent& event)
 {
-    pTaskState->mTimes.clear();
-    EndModal(wxID_CLOSE);
+    pStopwatch->Reset();
+    Dismiss();
 }
 
 } // namespace app::dlg
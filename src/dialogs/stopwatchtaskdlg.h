@@ -26,7 +26,9 @@
 #include <spdlog/spdlog.h>
 
 #include "../config/configuration.h"
-#include "../services/taskstateservice.h"
+#include "../services/idledetector.h"
+#include "../services/stopwatchregistry.h"
+#include "../services/tickscheduler.h"
 #include "../frame/taskbaricon.h"
 
 wxDECLARE_EVENT(START_NEW_STOPWATCH_TASK, wxCommandEvent);
@@ -41,19 +43,14 @@ class StopwatchTaskDialog : public wxDialog
     explicit StopwatchTaskDialog(wxWindow* parent,
         std::shared_ptr<cfg::Configuration> config,
         std::shared_ptr<spdlog::logger> logger,
-        std::shared_ptr<services::TaskStateService> taskState,
+        std::shared_ptr<services::StopwatchRegistry> registry,
+        std::shared_ptr<services::TickScheduler> scheduler,
+        std::shared_ptr<services::IdleDetector> idleDetector,
+        int stopwatchId,
         frm::TaskBarIcon *taskBarIcon,
         const wxString& name = wxT("stopwatchtaskdlg"));
 
-    explicit StopwatchTaskDialog(wxWindow* parent,
-        std::shared_ptr<cfg::Configuration> config,
-        std::shared_ptr<spdlog::logger> logger,
-        std::shared_ptr<services::TaskStateService> taskState,
-        frm::TaskBarIcon *taskBarIcon,
-        bool hasPendingPausedTask,
-        const wxString& name = wxT("stopwatchtaskdlg"));
-
-    virtual ~StopwatchTaskDialog() = default;
+    virtual ~StopwatchTaskDialog();
 
     void Launch();
     void Relaunch();
@@ -72,13 +69,25 @@ class StopwatchTaskDialog : public wxDialog
     void CreateControls();
 
     void ExecuteStartupProcedure();
+    void ExecuteResumeRunningProcedure();
     void ExecutePauseProcedure();
-    void ExecuteStopProcedure();
-
-    void OnElapsedTimeUpdate(wxTimerEvent& event);
-    void OnTimer(wxTimerEvent& event);
-    void OnHideWindow(wxTimerEvent& event);
-    void OnPausedTaskReminder(wxTimerEvent& event);
+    bool ExecuteStopProcedure();
+    void WarnOnJournalError();
+    void Dismiss();
+
+    void ScheduleNotification(int intervalMinutes);
+    void SchedulePausedTaskReminder(int intervalMinutes);
+
+    void OnElapsedTimeUpdate();
+    void OnCheckpoint();
+    void OnNotification();
+    void OnPausedTaskReminder();
+    void OnIdle(services::IdleDetector::Clock::time_point lastActivity);
+    void OnActive(services::IdleDetector::Clock::time_point lastActivity);
+    void PromptForTimeAway(services::IdleDetector::Clock::time_point lastActivity);
+    void PromptForTimeSinceRestore();
+    void OnShow(wxShowEvent& event);
+    void OnIconize(wxIconizeEvent& event);
     void OnStart(wxCommandEvent& event);
     void OnPause(wxCommandEvent& event);
     void OnStop(wxCommandEvent& event);
@@ -87,7 +96,10 @@ class StopwatchTaskDialog : public wxDialog
 
     std::shared_ptr<spdlog::logger> pLogger;
     std::shared_ptr<cfg::Configuration> pConfig;
-    std::shared_ptr<services::TaskStateService> pTaskState;
+    std::shared_ptr<services::StopwatchRegistry> pRegistry;
+    std::shared_ptr<services::TickScheduler> pScheduler;
+    std::shared_ptr<services::IdleDetector> pIdleDetector;
+    std::shared_ptr<services::StopwatchEngine> pStopwatch;
 
     wxWindow* pParent;
     wxStaticText* pElapsedTimeText;
@@ -98,27 +110,24 @@ class StopwatchTaskDialog : public wxDialog
     wxButton* pPauseButton;
     wxButton* pStopButton;
     wxButton* pCancelButton;
-    std::unique_ptr<wxTimer> pElapsedTimer;
-    std::unique_ptr<wxTimer> pNotificationTimer;
-    std::unique_ptr<wxTimer> pHideWindowTimer;
-    std::unique_ptr<wxTimer> pPausedTaskReminder;
     frm::TaskBarIcon* pTaskBarIcon;
 
-    wxDateTime mStartTime;
-    wxDateTime mEndTime;
-    bool bIsPaused;
-    bool bWasTaskPaused;
-    bool bHasPendingPausedTask;
+    int mStopwatchId;
+    int mElapsedRefreshTaskId;
+    int mCheckpointTaskId;
+    int mNotificationTaskId;
+    int mPausedTaskReminderTaskId;
+    int mIdleSubscriptionId;
+    int mNotificationSubscriptionId;
+    int mPausedTaskReminderSubscriptionId;
+    bool bWasPausedOnIdle;
+    bool bWasJournalErrorShown;
 
     enum {
         IDC_ELAPSED = wxID_HIGHEST + 1,
         IDC_ACCUMULATED_TIME,
         IDC_START_NEW_TASK_CHECK,
         IDC_TASK_DESCRIPTION,
-        IDC_ELAPSED_TIMER,
-        IDC_NOTIFICATION_TIMER,
-        IDC_HIDE_WINDOW_TIMER,
-        IDC_PAUSED_TASK_REMINDER,
         IDC_START,
         IDC_PAUSE,
         IDC_STOP,
@@ -57,6 +57,7 @@ TaskItemDialog::TaskItemDialog(wxWindow* parent,
     , pConfig(config)
     , mType(taskItemType)
     , bIsEdit(false)
+    , bIsFromStopwatch(false)
     , mTaskItemId(-1)
     , mDateContext(dateTimeContext)
     , pTaskContextTextCtrl(nullptr)
@@ -102,6 +103,7 @@ TaskItemDialog::TaskItemDialog(wxWindow* parent,
     , pConfig(config)
     , mType(taskItemType)
     , bIsEdit(edit)
+    , bIsFromStopwatch(false)
     , mTaskItemId(taskId)
     , mDateContext(dateTimeContext)
     , pTaskContextTextCtrl(nullptr)
@@ -134,19 +136,25 @@ TaskItemDialog::TaskItemDialog(wxWindow* parent,
         name);
 }
 
-void TaskItemDialog::SetDurationFromStopwatchTask(wxTimeSpan duration)
+void TaskItemDialog::SetIntervalsFromStopwatchTask(const std::vector<std::tuple<wxDateTime, wxDateTime>>& intervals)
 {
-    wxDateTime durationTime;
-    durationTime.ParseISOTime(duration.Format());
-    pDurationTimeCtrl->SetValue(durationTime);
-}
+    mStopwatchIntervals = intervals;
+    mStopwatchTime = wxTimeSpan();
+    for (const auto& [startTime, endTime] : intervals) {
+        mStopwatchTime += endTime.Subtract(startTime);
+    }
 
-void TaskItemDialog::SetTimesFromStopwatchTask(wxDateTime startTime, wxDateTime endTime)
-{
-    pStartTimeCtrl->SetValue(startTime);
-    pEndTimeCtrl->SetValue(endTime);
+    /* each interval is saved under its own day, with the times the stopwatch recorded */
+    pStartTimeCtrl->SetValue(std::get<0>(intervals.front()));
+    pEndTimeCtrl->SetValue(std::get<1>(intervals.back()));
+    pDurationCtrl->SetLabelText(mStopwatchTime.Format(wxT("%H:%M:%S")));
+    pDateContextCtrl->SetValue(std::get<0>(intervals.front()));
 
-    CalculateTimeDiff(startTime, endTime);
+    pDateContextCtrl->Disable();
+    pStartTimeCtrl->Disable();
+    pEndTimeCtrl->Disable();
+
+    bIsFromStopwatch = true;
 }
 
 void TaskItemDialog::SetDescriptionFromStopwatchTask(const wxString& value)
@@ -649,6 +657,12 @@ void TaskItemDialog::CalculateRate()
     }
 
     if (mType == constants::TaskItemTypes::TimedTask) {
+        /* the start and end of a stopwatch task include the time it was paused */
+        if (bIsFromStopwatch) {
+            CalculateRate(mStopwatchTime);
+            return;
+        }
+
         auto start = pStartTimeCtrl->GetValue();
         auto end = pEndTimeCtrl->GetValue();
 
@@ -852,7 +866,27 @@ void TaskItemDialog::OnDurationTimeChange(wxDateEvent& event)
 void TaskItemDialog::OnOk(wxCommandEvent& event)
 {
     if (TransferDataAndValidate()) {
-        if (!bIsEdit) {
+        if (!bIsEdit && bIsFromStopwatch) {
+            std::vector<int64_t> taskItemIds;
+            try {
+                taskItemIds = mTaskItemData.Create(std::move(pTaskItem), mStopwatchIntervals);
+            } catch (const sqlite::sqlite_exception& e) {
+                pLogger->error("Error occured in TaskItemModel::Create() - {0:d} : {1}", e.get_code(), e.what());
+                wxLogDebug(wxString(e.get_sql()));
+                EndModal(ids::ID_ERROR_OCCURED);
+                return;
+            }
+            /* nothing was saved, the stopwatch keeps its task */
+            if (taskItemIds.empty()) {
+                EndModal(wxID_CANCEL);
+                return;
+            }
+            for (auto taskItemId : taskItemIds) {
+                GenerateTaskInsertedEvent(taskItemId);
+            }
+        }
+
+        if (!bIsEdit && !bIsFromStopwatch) {
             int64_t id = -1;
             try {
                 id = mTaskItemData.Create(std::move(pTaskItem));
@@ -978,7 +1012,7 @@ bool TaskItemDialog::TransferDataAndValidate()
         pTaskItem->SetProject(std::move(mProjectData.GetById(projectId)));
     }
 
-    if (mType == constants::TaskItemTypes::TimedTask) {
+    if (mType == constants::TaskItemTypes::TimedTask && !bIsFromStopwatch) {
         auto startTime = pStartTimeCtrl->GetValue();
         auto endTime = pEndTimeCtrl->GetValue();
         auto isStartAheadOfEnd = startTime.IsLaterThan(endTime);
@@ -1041,6 +1075,11 @@ bool TaskItemDialog::TransferDataAndValidate()
     }
     pTaskItem->SetDescription(description);
 
+    /* the task items of a stopwatch task resolve their task when they are created, in one transaction */
+    if (bIsFromStopwatch) {
+        return true;
+    }
+
     data::TaskData taskData;
     int taskId = -1;
     try {
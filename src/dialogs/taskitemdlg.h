@@ -20,6 +20,8 @@
 #pragma once
 
 #include <memory>
+#include <tuple>
+#include <vector>
 
 #include <wx/wx.h>
 
@@ -67,8 +69,8 @@ class TaskItemDialog : public wxDialog
 
     virtual ~TaskItemDialog() = default;
 
-    void SetDurationFromStopwatchTask(wxTimeSpan duration);
-    void SetTimesFromStopwatchTask(wxDateTime startTime, wxDateTime endTime);
+    /* The times of a stopwatch task are fixed, only its details can be edited (timed task dialogs only) */
+    void SetIntervalsFromStopwatchTask(const std::vector<std::tuple<wxDateTime, wxDateTime>>& intervals);
     void SetDescriptionFromStopwatchTask(const wxString& value);
 
 private:
@@ -136,8 +138,11 @@ class TaskItemDialog : public wxDialog
     constants::TaskItemTypes mType;
     int mTaskItemId;
     bool bIsEdit;
+    bool bIsFromStopwatch;
     wxDateTime mDateContext;
     double mCalculatedRate;
+    std::vector<std::tuple<wxDateTime, wxDateTime>> mStopwatchIntervals;
+    wxTimeSpan mStopwatchTime;
 
     std::unique_ptr<model::TaskItemModel> pTaskItem;
     std::unique_ptr<model::ProjectModel> pProject;
@@ -19,6 +19,9 @@
 
 #include "weeklytaskviewdlg.h"
 
+#include <algorithm>
+#include <iterator>
+
 #include <wx/utils.h>
 #include <wx/clipbrd.h>
 
@@ -26,12 +29,14 @@
 #include "../common/constants.h"
 #include "../common/util.h"
 #include "../data/taskitemdata.h"
+#include "../services/databasearchive.h"
 
 #include "../dialogs/taskitemdlg.h"
 
 namespace app::dlg
 {
 const wxString WeekLabel = wxT("Monday %s - Sunday %s");
+const wxString ArchivedWeekLabel = wxT("Monday %s - Sunday %s (archived, read only)");
 const wxString SelectedDateLabel = wxT("%s");
 wxString DayHoursLabels[7] = {
     wxT("Monday: %H:%M:%S"),
@@ -259,6 +264,24 @@ void WeeklyTaskViewDialog::ConfigureEventBindings()
         this,
         wxID_DELETE
     );
+
+    Bind(
+        EVT_TASK_ITEM_INSERTED,
+        &WeeklyTaskViewDialog::OnTaskItemChanged,
+        this
+    );
+
+    Bind(
+        EVT_TASK_ITEM_UPDATED,
+        &WeeklyTaskViewDialog::OnTaskItemChanged,
+        this
+    );
+
+    Bind(
+        EVT_TASK_ITEM_DELETED,
+        &WeeklyTaskViewDialog::OnTaskItemChanged,
+        this
+    );
 }
 // clang-format on
 
@@ -267,7 +290,9 @@ void WeeklyTaskViewDialog::FillControls()
     wxString mondayISODateString = mDateTraverser.GetDayISODate(constants::Days::Monday);
     wxString sundayISODateString = mDateTraverser.GetDayISODate(constants::Days::Sunday);
 
-    pWeekDatesLabel->SetLabel(wxString::Format(WeekLabel, mondayISODateString, sundayISODateString));
+    pWeekDatesLabel->SetLabel(wxString::Format(IsArchivedDate(mondayISODateString) ? ArchivedWeekLabel : WeekLabel,
+        mondayISODateString,
+        sundayISODateString));
 
     {
         wxWindowDisabler disableAll;
@@ -290,16 +315,39 @@ void WeeklyTaskViewDialog::OnCalendarWeekSelection(wxCalendarEvent& event)
         wxBusyCursor wait;
 
         mDateTraverser.Recalculate(event.GetDate());
-        pWeeklyTreeModel->SetDateTraverser(mDateTraverser);
-        pWeeklyTreeModel->ClearAll();
-        for (auto& item : pWeeklyTreeModel->CollapseDayNodes()) {
-            pDataViewCtrl->Collapse(item);
+
+        wxString mondayISODateString = mDateTraverser.GetDayISODate(constants::Days::Monday);
+        wxString sundayISODateString = mDateTraverser.GetDayISODate(constants::Days::Sunday);
+
+        pWeekDatesLabel->SetLabel(wxString::Format(IsArchivedDate(mondayISODateString) ? ArchivedWeekLabel : WeekLabel,
+            mondayISODateString,
+            sundayISODateString));
+
+        GetTaskItemsForDailyBreakdown();
+        /* recently viewed weeks are swapped back in from the model's week cache */
+        if (!pWeeklyTreeModel->SwitchWeek(mDateTraverser)) {
+            GetTaskItemsByDateRange(mondayISODateString, sundayISODateString);
         }
+        GetTaskItemHoursByDateRange(mondayISODateString, sundayISODateString);
+    }
+
+    pDataViewCtrl->Expand(pWeeklyTreeModel->ExpandRootNode());
+    pDataViewCtrl->Refresh();
+}
+
+void WeeklyTaskViewDialog::OnTaskItemChanged(wxCommandEvent& WXUNUSED(event))
+{
+    /* cached weeks may hold the changed task item, so drop them and reload the week being shown */
+    pWeeklyTreeModel->InvalidateWeekCache();
+
+    {
+        wxWindowDisabler disableAll;
+        wxBusyCursor wait;
 
         wxString mondayISODateString = mDateTraverser.GetDayISODate(constants::Days::Monday);
         wxString sundayISODateString = mDateTraverser.GetDayISODate(constants::Days::Sunday);
 
-        pWeekDatesLabel->SetLabel(wxString::Format(WeekLabel, mondayISODateString, sundayISODateString));
+        pWeeklyTreeModel->ClearAll();
 
         GetTaskItemsForDailyBreakdown();
         GetTaskItemsByDateRange(mondayISODateString, sundayISODateString);
@@ -314,9 +362,13 @@ void WeeklyTaskViewDialog::OnContextMenu(wxDataViewEvent& event)
     wxDataViewItem item = event.GetItem();
 
     if (item.IsOk()) {
-        auto contextModel = (dv::WeeklyTreeModelNode*) item.GetID();
-        if (!contextModel->IsContainer()) {
-            mSelectedTaskItemId = contextModel->GetTaskItemId();
+        if (!pWeeklyTreeModel->IsContainer(item)) {
+            /* archived task items are only in the all_task_items view, which cannot be changed */
+            if (IsArchivedDate(pWeeklyTreeModel->GetDateFromDataViewItem(item).FormatISODate())) {
+                return;
+            }
+
+            mSelectedTaskItemId = pWeeklyTreeModel->GetTaskItemIdFromDataViewItem(item);
             mDaySelected = pWeeklyTreeModel->GetDateFromDataViewItem(item);
             mSelectedDataViewItem = item;
 
@@ -394,7 +446,8 @@ void WeeklyTaskViewDialog::GetTaskItemsForDailyBreakdown()
     for (std::size_t i = 0; i <= constants::Sunday; i++) {
         std::vector<wxString> durations;
         try {
-            durations = taskItemData.GetHours(dateArray[i]);
+            durations = IsArchivedDate(dateArray[i]) ? taskItemData.GetAllHours(dateArray[i])
+                                                     : taskItemData.GetHours(dateArray[i]);
         } catch (const sqlite::sqlite_exception& e) {
             pLogger->error("Error occured on TaskItemData::GetHours({0}) - {1:d} : {2}",
                 dateArray[i].ToStdString(),
@@ -422,7 +475,14 @@ void WeeklyTaskViewDialog::GetTaskItemsByDateRange(const wxString& fromDate, con
     data::TaskItemData taskItemData;
     std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
     try {
-        taskItems = taskItemData.GetByWeek(fromDate, toDate);
+        if (IsArchivedDate(fromDate)) {
+            for (const auto& date : mDateTraverser.GetISODates()) {
+                auto dayTaskItems = taskItemData.GetAllByDate(date);
+                std::move(dayTaskItems.begin(), dayTaskItems.end(), std::back_inserter(taskItems));
+            }
+        } else {
+            taskItems = taskItemData.GetByWeek(fromDate, toDate);
+        }
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured on TaskItemData::GetByWeek({0}, {1}) - {2:d} : {3}",
             fromDate.ToStdString(),
@@ -439,7 +499,8 @@ void WeeklyTaskViewDialog::GetTaskItemHoursByDateRange(const wxString& fromDate,
     data::TaskItemData taskItemData;
     std::vector<wxString> durations;
     try {
-        durations = taskItemData.GetHoursByWeek(fromDate, toDate);
+        durations = IsArchivedDate(fromDate) ? taskItemData.GetAllHoursByWeek(fromDate, toDate)
+                                             : taskItemData.GetHoursByWeek(fromDate, toDate);
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured on TaskItemData::GetHoursByWeek({0}, {1}) - {2:d} : {3}",
             fromDate.ToStdString(),
@@ -461,4 +522,10 @@ void WeeklyTaskViewDialog::GetTaskItemHoursByDateRange(const wxString& fromDate,
 
     pTotalWeekHoursLabel->SetLabel(totalDuration.Format(constants::TotalHours));
 }
+
+/* weeks that start before the archive cut-off are read from the all_task_items view and cannot be changed */
+bool WeeklyTaskViewDialog::IsArchivedDate(const wxString& isoDate) const
+{
+    return isoDate < svc::DatabaseArchive::GetCutOffDate(pConfig);
+}
 } // namespace app::dlg
@@ -66,10 +66,12 @@ class WeeklyTaskViewDialog final : public wxDialog
     void OnContextMenuCopyToClipboard(wxCommandEvent& event);
     void OnContextMenuEdit(wxCommandEvent& event);
     void OnContextMenuDelete(wxCommandEvent& event);
+    void OnTaskItemChanged(wxCommandEvent& event);
 
     void GetTaskItemsForDailyBreakdown();
     void GetTaskItemsByDateRange(const wxString& fromDate, const wxString& toDate);
     void GetTaskItemHoursByDateRange(const wxString& fromDate, const wxString& toDate);
+    bool IsArchivedDate(const wxString& isoDate) const;
 
     std::shared_ptr<spdlog::logger> pLogger;
     std::shared_ptr<cfg::Configuration> pConfig;
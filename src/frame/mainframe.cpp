@@ -19,21 +19,29 @@
 
 #include "mainframe.h"
 
+#include <chrono>
 #include <vector>
 
+#include <spdlog/sinks/basic_file_sink.h>
 #include <sqlite_modern_cpp/errors.h>
 
 #include <wx/aboutdlg.h>
 #include <wx/clipbrd.h>
+#include <wx/filename.h>
+#include <wx/progdlg.h>
+#include <wx/stdpaths.h>
 #include <wx/taskbarbutton.h>
 
 #include "../common/constants.h"
 #include "../common/common.h"
 #include "../common/ids.h"
+#include "../common/startupprofiler.h"
 #include "../common/util.h"
 #include "../common/version.h"
 
 #include "../data/taskitemdata.h"
+#include "../database/connectionprovider.h"
+#include "../database/querystatistics.h"
 #include "../models/taskitemmodel.h"
 
 #include "../dialogs/taskitemdlg.h"
@@ -47,6 +55,7 @@
 #include "../dialogs/categoriesdlg.h"
 
 #include "../dialogs/weeklytaskviewdlg.h"
+#include "../dialogs/periodtaskviewdlg.h"
 
 #include "../dialogs/preferencesdlg.h"
 
@@ -54,17 +63,22 @@
 #include "taskbaricon.h"
 
 #include "../services/databasebackup.h"
-#include "../services/databasebackupdeleter.h"
+#include "../services/databasemaintenance.h"
+#include "../services/backupretention.h"
+#include "../services/databasearchive.h"
 
 namespace app::frm
 {
+static const std::size_t QueryStatisticsSummaryLimit = 10;
+static const wxString QueryStatisticsFileName = wxT("query-statistics.txt");
+static const wxString ArchivedDateText = wxT("Task items on this day are archived and can no longer be changed");
+
 // clang-format off
 wxBEGIN_EVENT_TABLE(MainFrame, wxFrame)
 /* General Event Handlers */
 EVT_CLOSE(MainFrame::OnClose)
 EVT_ICONIZE(MainFrame::OnIconize)
 EVT_SIZE(MainFrame::OnResize)
-EVT_TIMER(IDC_DISMISS_INFOBAR_TIMER, MainFrame::OnDismissInfoBar)
 /* Main Menu Event Handlers */
 EVT_MENU(wxID_ABOUT, MainFrame::OnAbout)
 EVT_MENU(wxID_EXIT, MainFrame::OnExit)
@@ -75,6 +89,7 @@ EVT_MENU(ids::ID_NEW_PROJECT, MainFrame::OnNewProject)
 EVT_MENU(ids::ID_NEW_CLIENT, MainFrame::OnNewClient)
 EVT_MENU(ids::ID_NEW_CATEGORY, MainFrame::OnNewCategory)
 EVT_MENU(ids::ID_WEEKLY_VIEW, MainFrame::OnWeeklyView)
+EVT_MENU(ids::ID_PERIOD_VIEW, MainFrame::OnPeriodView)
 EVT_MENU(ids::ID_EDIT_EMPLOYER, MainFrame::OnEditEmployer)
 EVT_MENU(ids::ID_EDIT_CLIENT, MainFrame::OnEditClient)
 EVT_MENU(ids::ID_EDIT_PROJECT, MainFrame::OnEditProject)
@@ -84,6 +99,7 @@ EVT_MENU(ids::ID_STOPWATCH_TASK, MainFrame::OnTaskStopwatch)
 EVT_MENU(ids::ID_CHECK_FOR_UPDATE, MainFrame::OnCheckForUpdate)
 EVT_MENU(ids::ID_RESTORE_DATABASE, MainFrame::OnRestoreDatabase)
 EVT_MENU(ids::ID_BACKUP_DATABASE, MainFrame::OnBackupDatabase)
+EVT_MENU(ids::ID_QUERY_STATISTICS, MainFrame::OnQueryStatistics)
 EVT_MENU(ids::ID_RETURN_TO_CURRENT_DATE, MainFrame::OnReturnToCurrentDate)
 /* Frame Control Event Handlers */
 EVT_DATE_CHANGED(MainFrame::IDC_GO_TO_DATE, MainFrame::OnDateChanged)
@@ -112,9 +128,11 @@ MainFrame::MainFrame(std::shared_ptr<cfg::Configuration> config,
         nullptr, wxID_ANY, common::GetProgramName(), wxDefaultPosition, wxSize(600, 500), wxDEFAULT_FRAME_STYLE, name)
     , pConfig(config)
     , pLogger(logger)
-    , pTaskState(std::make_shared<services::TaskStateService>())
-    , pTaskStorage(std::make_unique<services::TaskStorage>())
-    , pDismissInfoBarTimer(std::make_unique<wxTimer>(this, IDC_DISMISS_INFOBAR_TIMER))
+    , pScheduler(std::make_shared<services::TickScheduler>())
+    , pIdleDetector(std::make_shared<services::IdleDetector>(
+          std::make_unique<services::SystemIdleTimeProvider>(), pScheduler, config))
+    , pStopwatchRegistry(std::make_shared<services::StopwatchRegistry>(logger))
+    , pBackupThread(nullptr)
     , pPrevDayBtn(nullptr)
     , pDatePickerCtrl(nullptr)
     , pNextDayBtn(nullptr)
@@ -128,6 +146,9 @@ MainFrame::MainFrame(std::shared_ptr<cfg::Configuration> config,
     , pFeedbackPopupWindow(nullptr)
     , mItemIndex(-1)
     , mSelectedTaskItemId(-1)
+    , mDismissInfoBarTaskId(-1)
+    , mMaintenanceTaskId(-1)
+    , mQueryStatisticsTaskId(-1)
 // clang-format on
 {
 }
@@ -135,32 +156,57 @@ MainFrame::MainFrame(std::shared_ptr<cfg::Configuration> config,
 MainFrame::~MainFrame()
 {
     auto size = GetSize();
-    pConfig->SetFrameSize(size);
+    pConfig->SetFrameSize(size.GetWidth(), size.GetHeight());
 
     if (pTaskBarIcon) {
         delete pTaskBarIcon;
     }
 
+    pScheduler->Cancel(mMaintenanceTaskId);
+    pScheduler->Cancel(mQueryStatisticsTaskId);
+
+    /* a manual backup still in flight is abandoned in favour of the exit backup */
+    if (pBackupThread) {
+        pBackupThread->Cancel();
+        StopDatabaseBackupThread();
+    }
+
+    RunExitDatabaseMaintenance();
+
     RunDatabaseBackup();
 }
 
 bool MainFrame::CreateFrame()
 {
-    auto configSize = pConfig->GetFrameSize();
-    SetSize(configSize);
+    auto [width, height] = pConfig->GetFrameSize();
+    SetSize(wxSize(width, height));
 
     bool success = Create();
     SetMinSize(wxSize(850, 580));
     SetIcon(common::GetProgramIcon());
 
-    if (pConfig->IsBackupEnabled()) {
-        svc::DatabaseBackupDeleter dbBackupDeleter(pConfig);
-        dbBackupDeleter.Execute();
+    mMaintenanceTaskId = pScheduler->Schedule(
+        std::chrono::minutes(5), [this]() { RunIdleDatabaseMaintenance(); }, std::chrono::minutes(1));
+
+    if (db::QueryStatistics::Get().IsEnabled()) {
+        mQueryStatisticsTaskId = pScheduler->Schedule(
+            std::chrono::minutes(15),
+            [this]() { db::QueryStatistics::Get().LogSummary(pLogger, QueryStatisticsSummaryLimit); },
+            std::chrono::minutes(1));
     }
 
     pTaskBarIcon = new TaskBarIcon(this, pConfig, pLogger);
-    if (pConfig->IsShowInTray()) {
-        pTaskBarIcon->SetTaskBarIcon();
+
+    /* menu icons, backup retention, the tray icon and the rest of the connection pool wait for the first paint */
+    Bind(wxEVT_IDLE, &MainFrame::OnFirstIdle, this);
+
+    Bind(DATABASE_BACKUP_PROGRESS, &MainFrame::OnDatabaseBackupProgress, this);
+    Bind(DATABASE_BACKUP_COMPLETED, &MainFrame::OnDatabaseBackupCompleted, this);
+
+    /* stopwatch tasks that were pending when the application last exited are replayed from their journals */
+    for (int stopwatchId : pStopwatchRegistry->Restore()) {
+        pLogger->info("Restored pending stopwatch task {0:d} from journal", stopwatchId);
+        CallAfter([this, stopwatchId]() { LaunchStopwatch(stopwatchId); });
     }
 
     return success;
@@ -168,8 +214,15 @@ bool MainFrame::CreateFrame()
 
 bool MainFrame::Create()
 {
-    CreateControls();
-    DataToControls();
+    {
+        common::StartupProfiler::Phase phase("Create controls");
+        CreateControls();
+    }
+
+    {
+        common::StartupProfiler::Phase phase("Load today's task items");
+        DataToControls();
+    }
 
     return true;
 }
@@ -198,19 +251,10 @@ void MainFrame::CreateControls()
     /* File Menu Control */
     auto fileMenu = new wxMenu();
 
-    auto entryTaskMenuItem =
-        fileMenu->Append(ids::ID_NEW_ENTRY_TASK, wxT("New &Entry Task\tCtrl-E"), wxT("Create new entry task"));
-    entryTaskMenuItem->SetBitmap(common::GetEntryTaskIcon());
-
-    auto timedTaskMenuItem =
-        fileMenu->Append(ids::ID_NEW_TIMED_TASK, wxT("New &Timed Task\tCtrl-T"), wxT("Create new timed task"));
-    timedTaskMenuItem->SetBitmap(common::GetTimedTaskIcon());
-
+    fileMenu->Append(ids::ID_NEW_ENTRY_TASK, wxT("New &Entry Task\tCtrl-E"), wxT("Create new entry task"));
+    fileMenu->Append(ids::ID_NEW_TIMED_TASK, wxT("New &Timed Task\tCtrl-T"), wxT("Create new timed task"));
     fileMenu->AppendSeparator();
-
-    auto stopwatchMenuItem =
-        fileMenu->Append(ids::ID_STOPWATCH_TASK, wxT("Stop&watch\tCtrl-W"), wxT("Start task stopwatch"));
-    stopwatchMenuItem->SetBitmap(common::GetStopwatchIcon());
+    fileMenu->Append(ids::ID_STOPWATCH_TASK, wxT("Stop&watch\tCtrl-W"), wxT("Start task stopwatch"));
 
     fileMenu->AppendSeparator();
     fileMenu->Append(ids::ID_NEW_EMPLOYER, wxT("New &Employer"), wxT("Create new employer"));
@@ -220,10 +264,10 @@ void MainFrame::CreateControls()
     fileMenu->AppendSeparator();
     auto fileViewMenu = new wxMenu();
     fileViewMenu->Append(ids::ID_WEEKLY_VIEW, wxT("Week View"));
+    fileViewMenu->Append(ids::ID_PERIOD_VIEW, wxT("Month and Year View"));
     fileMenu->AppendSubMenu(fileViewMenu, wxT("View"));
     fileMenu->AppendSeparator();
-    auto exitMenuItem = fileMenu->Append(wxID_EXIT, wxT("Exit"), wxT("Exit the application"));
-    exitMenuItem->SetBitmap(common::GetQuitIcon());
+    fileMenu->Append(wxID_EXIT, wxT("Exit"), wxT("Exit the application"));
 
     /* Edit Menu Control */
     auto editMenu = new wxMenu();
@@ -232,29 +276,27 @@ void MainFrame::CreateControls()
     editMenu->Append(ids::ID_EDIT_PROJECT, wxT("Edit &Project"), wxT("Select a project to edit"));
     editMenu->Append(ids::ID_EDIT_CATEGORY, wxT("Edit C&ategory"), wxT("Select a category to edit"));
     editMenu->AppendSeparator();
-    auto preferencesMenuItem =
-        editMenu->Append(ids::ID_PREFERENCES, wxT("&Preferences\tCtrl-P"), wxT("Edit application preferences"));
-    preferencesMenuItem->SetBitmap(common::GetSettingsIcon());
+    editMenu->Append(ids::ID_PREFERENCES, wxT("&Preferences\tCtrl-P"), wxT("Edit application preferences"));
 
     /* Export Menu Control */
     // auto exportMenu = new wxMenu();
 
     /* Tools Menu Control */
     auto toolsMenu = new wxMenu();
-    auto restoreMenuItem = toolsMenu->Append(
-        ids::ID_RESTORE_DATABASE, wxT("Restore Database"), wxT("Restore database to a previous point"));
-    restoreMenuItem->SetBitmap(common::GetDatabaseRestoreIcon());
-    auto backupMenuItem = toolsMenu->Append(
-        ids::ID_BACKUP_DATABASE, wxT("Backup Database"), wxT("Backup database at the current snapshot"));
-    backupMenuItem->SetBitmap(common::GetDatabaseBackupIcon());
+    toolsMenu->Append(ids::ID_RESTORE_DATABASE, wxT("Restore Database"), wxT("Restore database to a previous point"));
+    toolsMenu->Append(ids::ID_BACKUP_DATABASE, wxT("Backup Database"), wxT("Backup database at the current snapshot"));
+    if (db::QueryStatistics::Get().IsEnabled()) {
+        toolsMenu->AppendSeparator();
+        toolsMenu->Append(ids::ID_QUERY_STATISTICS,
+            wxT("Dump Query Statistics"),
+            wxT("Write the statements run since the last dump to the logs directory"));
+    }
 
     /* Help Menu Control */
     wxMenu* helpMenu = new wxMenu();
-    auto helpMenuItem = helpMenu->Append(wxID_ABOUT);
-    helpMenuItem->SetBitmap(common::GetAboutIcon());
-    auto checkUpdateMenuItem = helpMenu->Append(
+    helpMenu->Append(wxID_ABOUT);
+    helpMenu->Append(
         ids::ID_CHECK_FOR_UPDATE, wxT("Check for update"), wxT("Check if an update is available for application"));
-    checkUpdateMenuItem->SetBitmap(common::GetCheckForUpdateIcon());
 
     /* Menu Bar */
     wxMenuBar* menuBar = new wxMenuBar();
@@ -384,6 +426,46 @@ void MainFrame::DataToControls()
     FillListCtrl();
 }
 
+void MainFrame::SetMenuIcons()
+{
+    auto menuBar = GetMenuBar();
+
+    menuBar->FindItem(ids::ID_NEW_ENTRY_TASK)->SetBitmap(common::GetEntryTaskIcon());
+    menuBar->FindItem(ids::ID_NEW_TIMED_TASK)->SetBitmap(common::GetTimedTaskIcon());
+    menuBar->FindItem(ids::ID_STOPWATCH_TASK)->SetBitmap(common::GetStopwatchIcon());
+    menuBar->FindItem(wxID_EXIT)->SetBitmap(common::GetQuitIcon());
+    menuBar->FindItem(ids::ID_PREFERENCES)->SetBitmap(common::GetSettingsIcon());
+    menuBar->FindItem(ids::ID_RESTORE_DATABASE)->SetBitmap(common::GetDatabaseRestoreIcon());
+    menuBar->FindItem(ids::ID_BACKUP_DATABASE)->SetBitmap(common::GetDatabaseBackupIcon());
+    menuBar->FindItem(wxID_ABOUT)->SetBitmap(common::GetAboutIcon());
+    menuBar->FindItem(ids::ID_CHECK_FOR_UPDATE)->SetBitmap(common::GetCheckForUpdateIcon());
+}
+
+void MainFrame::RunDeferredStartup()
+{
+    {
+        common::StartupProfiler::Phase phase("Set menu icons");
+        SetMenuIcons();
+    }
+
+    if (pConfig->IsBackupEnabled()) {
+        common::StartupProfiler::Phase phase("Backup retention");
+        svc::BackupRetention backupRetention(pConfig, pLogger);
+        svc::RetentionResult retentionResult;
+        backupRetention.Execute(false, retentionResult);
+    }
+
+    if (pConfig->IsShowInTray()) {
+        common::StartupProfiler::Phase phase("Set tray icon");
+        pTaskBarIcon->SetTaskBarIcon();
+    }
+
+    {
+        common::StartupProfiler::Phase phase("Warm up connection pool");
+        db::ConnectionProvider::Get().Handle()->WarmUp();
+    }
+}
+
 void MainFrame::OnClose(wxCloseEvent& event)
 {
     if (pConfig->IsConfirmOnExit() && event.CanVeto()) {
@@ -427,10 +509,15 @@ void MainFrame::OnResize(wxSizeEvent& event)
     event.Skip();
 }
 
-void MainFrame::OnDismissInfoBar(wxTimerEvent& event)
+void MainFrame::OnFirstIdle(wxIdleEvent& event)
 {
-    pDismissInfoBarTimer->Stop();
-    pInfoBar->Dismiss();
+    Unbind(wxEVT_IDLE, &MainFrame::OnFirstIdle, this);
+
+    common::StartupProfiler::Get().Mark("Main window painted");
+    RunDeferredStartup();
+    common::StartupProfiler::Get().Finish(pLogger);
+
+    event.Skip();
 }
 
 void MainFrame::OnAbout(wxCommandEvent& event)
@@ -505,6 +592,12 @@ void MainFrame::OnWeeklyView(wxCommandEvent& event)
     weeklyTaskViewDialog->Show(true);
 }
 
+void MainFrame::OnPeriodView(wxCommandEvent& event)
+{
+    dlg::PeriodTaskViewDialog* periodTaskViewDialog = new dlg::PeriodTaskViewDialog(this, pLogger, pConfig);
+    periodTaskViewDialog->Show(true);
+}
+
 void MainFrame::OnEditEmployer(wxCommandEvent& event)
 {
     dlg::EditListDialog employerEdit(this, dlg::DialogType::Employer, pLogger);
@@ -541,10 +634,7 @@ void MainFrame::OnPreferences(wxCommandEvent& event)
 
 void MainFrame::OnTaskStopwatch(wxCommandEvent& event)
 {
-    dlg::StopwatchTaskDialog stopwatchTask(this, pConfig, pLogger, pTaskState, pTaskBarIcon);
-    stopwatchTask.Launch();
-
-    pListCtrl->SetFocus();
+    LaunchStopwatch(pStopwatchRegistry->Create());
 }
 
 void MainFrame::OnCheckForUpdate(wxCommandEvent& event)
@@ -556,6 +646,14 @@ void MainFrame::OnCheckForUpdate(wxCommandEvent& event)
 void MainFrame::OnRestoreDatabase(wxCommandEvent& event)
 {
     if (pConfig->IsBackupEnabled()) {
+        /* the backup holds a pooled connection the restore would pull from under it */
+        if (pBackupThread) {
+            wxMessageBox(wxT("Please wait for the running database backup to finish"),
+                common::GetProgramName(),
+                wxOK_DEFAULT | wxICON_INFORMATION);
+            return;
+        }
+
         auto wizard = new wizard::DatabaseRestoreWizard(this, pConfig, pLogger);
         wizard->CenterOnParent();
         wizard->Run();
@@ -570,22 +668,51 @@ void MainFrame::OnRestoreDatabase(wxCommandEvent& event)
 void MainFrame::OnBackupDatabase(wxCommandEvent& event)
 {
     if (pConfig->IsBackupEnabled()) {
-        svc::DatabaseBackup databaseBackup(pConfig, pLogger);
-        bool result = databaseBackup.Execute();
-        if (result) {
-            wxMessageBox(
-                wxT("Backup completed successfully!"), common::GetProgramName(), wxOK_DEFAULT | wxICON_INFORMATION);
-        } else {
+        if (pBackupThread) {
+            wxMessageBox(wxT("A database backup is already running"),
+                common::GetProgramName(),
+                wxOK_DEFAULT | wxICON_INFORMATION);
+            return;
+        }
+
+        /* the backup runs in the background, completion is reported by OnDatabaseBackupCompleted */
+        pBackupThread = std::make_unique<svc::DatabaseBackupThread>(this, pConfig, pLogger);
+        if (pBackupThread->Run() != wxTHREAD_NO_ERROR) {
+            pLogger->error("Failed to start the database backup thread");
+            pBackupThread.reset();
             wxMessageBox(wxT("Backup database operation encountered error(s)!"),
                 common::GetProgramName(),
                 wxOK_DEFAULT | wxICON_ERROR);
+            return;
         }
+
+        SetStatusText(wxT("Backing up database..."), 0);
     } else {
         wxMessageBox(
             wxT("Warning! Backup option is turned off"), common::GetProgramName(), wxOK_DEFAULT | wxICON_WARNING);
     }
 }
 
+void MainFrame::OnQueryStatistics(wxCommandEvent& WXUNUSED(event))
+{
+    auto filePath = wxFileName(common::GetLogsDirectory(), QueryStatisticsFileName).GetFullPath();
+
+    try {
+        auto fileSink = std::make_shared<spdlog::sinks::basic_file_sink_st>(filePath.ToStdString(), true);
+        auto fileLogger = std::make_shared<spdlog::logger>("query_statistics", fileSink);
+        fileLogger->set_pattern("%v");
+        db::QueryStatistics::Get().LogSummary(fileLogger, 0);
+        fileLogger->flush();
+    } catch (const spdlog::spdlog_ex& e) {
+        pLogger->error("Unable to write query statistics to {0} - {1}", filePath.ToStdString(), e.what());
+        return;
+    }
+
+    /* every dump covers the statements run since the previous one */
+    db::QueryStatistics::Get().Reset();
+    SetStatusText(wxString::Format(wxT("Query statistics written to %s"), filePath), 0);
+}
+
 void MainFrame::OnReturnToCurrentDate(wxCommandEvent& WXUNUSED(event))
 {
     wxDateTime currentDate = wxDateTime::Now();
@@ -650,6 +777,11 @@ void MainFrame::OnKeyDown(wxKeyEvent& event)
 
 void MainFrame::OnItemDoubleClick(wxListEvent& event)
 {
+    if (IsArchivedDate(pDatePickerCtrl->GetValue())) {
+        ShowInfoBarMessageForArchivedDate();
+        return;
+    }
+
     mItemIndex = event.GetIndex();
 
     data::TaskItemData data;
@@ -679,8 +811,11 @@ void MainFrame::OnItemRightClick(wxListEvent& event)
     wxMenu menu;
 
     menu.Append(wxID_COPY, wxT("&Copy to Clipboard"));
-    menu.Append(wxID_EDIT, wxT("&Edit"));
-    menu.Append(wxID_DELETE, wxT("&Delete"));
+    /* copying reads the list control, so it is the only action left for archived task items */
+    if (!IsArchivedDate(pDatePickerCtrl->GetValue())) {
+        menu.Append(wxID_EDIT, wxT("&Edit"));
+        menu.Append(wxID_DELETE, wxT("&Delete"));
+    }
 
     PopupMenu(&menu);
 }
@@ -741,6 +876,7 @@ void MainFrame::OnTaskInserted(wxCommandEvent& event)
     auto selectedDate = pDatePickerCtrl->GetValue();
 
     CalculateTotalTime(selectedDate);
+    NotifyWeeklyTaskViews(event);
 
     int id = event.GetId();
 
@@ -766,7 +902,7 @@ void MainFrame::OnTaskInserted(wxCommandEvent& event)
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetCategory()->GetName());
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDescription());
 
-        pListCtrl->SetItemBackgroundColour(listIndex, taskItem->GetCategory()->GetColor());
+        pListCtrl->SetItemBackgroundColour(listIndex, wxColour(taskItem->GetCategory()->GetColor()));
 
         pListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(taskItem->GetTaskItemId()));
     }
@@ -777,6 +913,7 @@ void MainFrame::OnTaskUpdated(wxCommandEvent& event)
     auto selectedDate = pDatePickerCtrl->GetValue();
 
     CalculateTotalTime(selectedDate);
+    NotifyWeeklyTaskViews(event);
 
     int id = event.GetId();
 
@@ -800,7 +937,7 @@ void MainFrame::OnTaskUpdated(wxCommandEvent& event)
     pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetCategory()->GetName());
     pListCtrl->SetItem(mItemIndex, columnIndex++, taskItem->GetDescription());
 
-    pListCtrl->SetItemBackgroundColour(mItemIndex, taskItem->GetCategory()->GetColor());
+    pListCtrl->SetItemBackgroundColour(mItemIndex, wxColour(taskItem->GetCategory()->GetColor()));
 
     pListCtrl->SetItemPtrData(mItemIndex, static_cast<wxUIntPtr>(taskItem->GetTaskItemId()));
 
@@ -826,6 +963,8 @@ void MainFrame::OnTaskDeleted(wxCommandEvent& event)
         return;
     }
 
+    NotifyWeeklyTaskViews(event);
+
     pListCtrl->DeleteItem(mItemIndex);
 
     mItemIndex = -1;
@@ -833,22 +972,28 @@ void MainFrame::OnTaskDeleted(wxCommandEvent& event)
 
 void MainFrame::OnNewStopwatchTaskFromPausedStopwatchTask(wxCommandEvent& event)
 {
-    pTaskStorage->Store(pTaskState);
-    pTaskState->mTimes.clear();
-
-    dlg::StopwatchTaskDialog stopwatchTask(
-        this, pConfig, pLogger, pTaskState, pTaskBarIcon, /* hasPendingPausedTask */ true);
-    stopwatchTask.Launch();
-
-    pTaskState->mTimes.clear();
-    pTaskStorage->Restore(pTaskState);
+    /* the paused stopwatch stays open alongside the new one */
+    LaunchStopwatch(pStopwatchRegistry->Create());
+}
 
-    dlg::StopwatchTaskDialog stopwatchPausedTask(this, pConfig, pLogger, pTaskState, pTaskBarIcon);
-    stopwatchPausedTask.Relaunch();
+void MainFrame::OnDatabaseBackupProgress(wxThreadEvent& event)
+{
+    SetStatusText(wxString::Format(wxT("Backing up database... %d%%"), event.GetInt()), 0);
+}
 
-    pTaskStorage->mTimes.clear();
+void MainFrame::OnDatabaseBackupCompleted(wxThreadEvent& event)
+{
+    StopDatabaseBackupThread();
+    SetStatusText(wxT("Ready"), 0);
 
-    pListCtrl->SetFocus();
+    if (event.GetInt() == 1) {
+        wxMessageBox(
+            wxT("Backup completed successfully!"), common::GetProgramName(), wxOK_DEFAULT | wxICON_INFORMATION);
+    } else {
+        wxMessageBox(wxT("Backup database operation encountered error(s)!"),
+            common::GetProgramName(),
+            wxOK_DEFAULT | wxICON_ERROR);
+    }
 }
 
 void MainFrame::CalculateTotalTime(wxDateTime date)
@@ -858,7 +1003,7 @@ void MainFrame::CalculateTotalTime(wxDateTime date)
     data::TaskItemData taskItemData;
     std::vector<wxString> taskDurations;
     try {
-        taskDurations = taskItemData.GetHours(dateString);
+        taskDurations = IsArchivedDate(date) ? taskItemData.GetAllHours(dateString) : taskItemData.GetHours(dateString);
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured on TaskItemData::GetHours() - {0:d} : {1}", e.get_code(), e.what());
     }
@@ -884,7 +1029,7 @@ void MainFrame::FillListCtrl(wxDateTime date)
     data::TaskItemData taskItemData;
     std::vector<std::unique_ptr<model::TaskItemModel>> taskItems;
     try {
-        taskItems = taskItemData.GetByDate(dateString);
+        taskItems = IsArchivedDate(date) ? taskItemData.GetAllByDate(dateString) : taskItemData.GetByDate(dateString);
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured on TaskItemData::GetByDate() - {0:d} : {1}", e.get_code(), e.what());
         return;
@@ -904,7 +1049,7 @@ void MainFrame::FillListCtrl(wxDateTime date)
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetCategory()->GetName());
         pListCtrl->SetItem(listIndex, columnIndex++, taskItem->GetDescription());
 
-        pListCtrl->SetItemBackgroundColour(listIndex, taskItem->GetCategory()->GetColor());
+        pListCtrl->SetItemBackgroundColour(listIndex, wxColour(taskItem->GetCategory()->GetColor()));
 
         pListCtrl->SetItemPtrData(listIndex, static_cast<wxUIntPtr>(taskItem->GetTaskItemId()));
 
@@ -912,6 +1057,12 @@ void MainFrame::FillListCtrl(wxDateTime date)
     }
 }
 
+/* task items dated before the archive cut-off may already have been moved out of the live database */
+bool MainFrame::IsArchivedDate(const wxDateTime& date) const
+{
+    return date.FormatISODate() < svc::DatabaseArchive::GetCutOffDate(pConfig);
+}
+
 bool MainFrame::RunDatabaseBackup()
 {
     if (pConfig->IsBackupEnabled()) {
@@ -922,6 +1073,71 @@ bool MainFrame::RunDatabaseBackup()
     return true;
 }
 
+void MainFrame::StopDatabaseBackupThread()
+{
+    /* joined and deleted here so the backup's pooled connection is released on the UI thread */
+    pBackupThread->Wait();
+    pBackupThread.reset();
+}
+
+void MainFrame::RunIdleDatabaseMaintenance()
+{
+    /* independent of the idle detection preference, maintenance only needs the user to be away */
+    if (pBackupThread || !svc::DatabaseMaintenance::IsDue(pConfig)) {
+        return;
+    }
+
+    if (services::SystemIdleTimeProvider().GetIdleTime() < std::chrono::minutes(5)) {
+        return;
+    }
+
+    svc::DatabaseMaintenance maintenance(pConfig, pLogger);
+    maintenance.Execute(svc::MaintenanceMode::Idle);
+}
+
+void MainFrame::RunExitDatabaseMaintenance()
+{
+    svc::DatabaseMaintenance maintenance(pConfig, pLogger);
+    if (svc::DatabaseMaintenance::IsDue(pConfig)) {
+        maintenance.Execute(svc::MaintenanceMode::Exit);
+    }
+
+    /* the one-off VACUUM cannot be time boxed, so it runs to completion here unless the user skips it */
+    if (maintenance.IsVacuumMigrationPending()) {
+        wxProgressDialog progress(common::GetProgramName(),
+            wxT("Compacting the database, this is only done once..."),
+            100,
+            nullptr,
+            wxPD_APP_MODAL | wxPD_AUTO_HIDE | wxPD_CAN_ABORT | wxPD_ELAPSED_TIME);
+        maintenance.MigrateToIncrementalVacuum([&progress]() { return progress.Pulse(); });
+    }
+}
+
+void MainFrame::LaunchStopwatch(int stopwatchId)
+{
+    auto stopwatch = pStopwatchRegistry->Get(stopwatchId);
+
+    /* stopwatch dialogs are modeless and destroy themselves once their task is stopped or discarded */
+    auto stopwatchTask = new dlg::StopwatchTaskDialog(
+        this, pConfig, pLogger, pStopwatchRegistry, pScheduler, pIdleDetector, stopwatchId, pTaskBarIcon);
+    if (stopwatch->HasPendingTask() && !stopwatch->IsRunning()) {
+        stopwatchTask->Relaunch();
+    } else {
+        stopwatchTask->Launch();
+    }
+}
+
+/* open weekly views are modeless, so they only hear about task items changed from their own dialogs */
+void MainFrame::NotifyWeeklyTaskViews(const wxCommandEvent& event)
+{
+    for (auto child : GetChildren()) {
+        auto weeklyTaskViewDialog = dynamic_cast<dlg::WeeklyTaskViewDialog*>(child);
+        if (weeklyTaskViewDialog != nullptr) {
+            wxPostEvent(weeklyTaskViewDialog, event);
+        }
+    }
+}
+
 void MainFrame::ShowInfoBarMessageForAdd(int modalRetCode, const wxString& item)
 {
     if (modalRetCode == wxID_OK) {
@@ -930,7 +1146,7 @@ void MainFrame::ShowInfoBarMessageForAdd(int modalRetCode, const wxString& item)
         pInfoBar->ShowMessage(constants::OnErrorAdd(item), wxICON_ERROR);
     }
 
-    pDismissInfoBarTimer->Start(1500);
+    ScheduleInfoBarDismissal();
 }
 
 void MainFrame::ShowInfoBarMessageForEdit(int modalRetCode, const wxString& item)
@@ -941,7 +1157,7 @@ void MainFrame::ShowInfoBarMessageForEdit(int modalRetCode, const wxString& item
         pInfoBar->ShowMessage(constants::OnErrorEdit(item), wxICON_ERROR);
     }
 
-    pDismissInfoBarTimer->Start(1500);
+    ScheduleInfoBarDismissal();
 }
 
 void MainFrame::ShowInfoBarMessageForDelete(bool success)
@@ -952,7 +1168,20 @@ void MainFrame::ShowInfoBarMessageForDelete(bool success)
         pInfoBar->ShowMessage(wxT("Error deleting task"), wxICON_ERROR);
     }
 
-    pDismissInfoBarTimer->Start(1500);
+    ScheduleInfoBarDismissal();
+}
+
+void MainFrame::ShowInfoBarMessageForArchivedDate()
+{
+    pInfoBar->ShowMessage(ArchivedDateText, wxICON_INFORMATION);
+    ScheduleInfoBarDismissal();
+}
+
+void MainFrame::ScheduleInfoBarDismissal()
+{
+    pScheduler->Cancel(mDismissInfoBarTaskId);
+    mDismissInfoBarTaskId = pScheduler->ScheduleOnce(
+        std::chrono::milliseconds(1500), [this]() { pInfoBar->Dismiss(); }, std::chrono::milliseconds(250));
 }
 
 void MainFrame::DateChangedProcedure(wxDateTime dateTime)
@@ -963,6 +1192,10 @@ void MainFrame::DateChangedProcedure(wxDateTime dateTime)
     CalculateTotalTime(dateTime);
     FillListCtrl(dateTime);
 
+    if (IsArchivedDate(dateTime)) {
+        ShowInfoBarMessageForArchivedDate();
+    }
+
     pListCtrl->SetFocus();
 }
 
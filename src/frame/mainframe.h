@@ -35,8 +35,10 @@
 #include <spdlog/spdlog.h>
 
 #include "../config/configuration.h"
-#include "../services/taskstateservice.h"
-#include "../services/taskstorageservice.h"
+#include "../services/databasebackup.h"
+#include "../services/idledetector.h"
+#include "../services/stopwatchregistry.h"
+#include "../services/tickscheduler.h"
 #include "feedbackpopup.h"
 
 namespace app::frm
@@ -63,12 +65,14 @@ class MainFrame : public wxFrame
 
     void CreateControls();
     void DataToControls();
+    void SetMenuIcons();
+    void RunDeferredStartup();
 
     /* General Event Handlers */
     void OnClose(wxCloseEvent& event);
     void OnIconize(wxIconizeEvent& event);
     void OnResize(wxSizeEvent& event);
-    void OnDismissInfoBar(wxTimerEvent& event);
+    void OnFirstIdle(wxIdleEvent& event);
 
     /* Main Menu Event Handlers */
     void OnAbout(wxCommandEvent& event);
@@ -80,6 +84,7 @@ class MainFrame : public wxFrame
     void OnNewProject(wxCommandEvent& event);
     void OnNewCategory(wxCommandEvent& event);
     void OnWeeklyView(wxCommandEvent& event);
+    void OnPeriodView(wxCommandEvent& event);
     void OnEditEmployer(wxCommandEvent& event);
     void OnEditClient(wxCommandEvent& event);
     void OnEditProject(wxCommandEvent& event);
@@ -89,6 +94,7 @@ class MainFrame : public wxFrame
     void OnCheckForUpdate(wxCommandEvent& event);
     void OnRestoreDatabase(wxCommandEvent& event);
     void OnBackupDatabase(wxCommandEvent& event);
+    void OnQueryStatistics(wxCommandEvent& event);
     void OnReturnToCurrentDate(wxCommandEvent& event);
 
     /* Frame Controls Event Handlers */
@@ -111,25 +117,35 @@ class MainFrame : public wxFrame
     void OnTaskUpdated(wxCommandEvent& event);
     void OnTaskDeleted(wxCommandEvent& event);
     void OnNewStopwatchTaskFromPausedStopwatchTask(wxCommandEvent& event);
+    void OnDatabaseBackupProgress(wxThreadEvent& event);
+    void OnDatabaseBackupCompleted(wxThreadEvent& event);
 
     void CalculateTotalTime(wxDateTime date = wxDateTime::Now());
     void FillListCtrl(wxDateTime date = wxDateTime::Now());
+    bool IsArchivedDate(const wxDateTime& date) const;
 
     bool RunDatabaseBackup();
+    void StopDatabaseBackupThread();
+    void RunIdleDatabaseMaintenance();
+    void RunExitDatabaseMaintenance();
+    void LaunchStopwatch(int stopwatchId);
+    void NotifyWeeklyTaskViews(const wxCommandEvent& event);
 
     void ShowInfoBarMessageForAdd(int modalRetCode, const wxString& item);
     void ShowInfoBarMessageForEdit(int modalRetCode, const wxString& item);
     void ShowInfoBarMessageForDelete(bool success);
+    void ShowInfoBarMessageForArchivedDate();
+    void ScheduleInfoBarDismissal();
 
     void DateChangedProcedure(wxDateTime dateTime);
     void CopyToClipboardProcedure(long itemIndex);
 
     std::shared_ptr<spdlog::logger> pLogger;
     std::shared_ptr<cfg::Configuration> pConfig;
-    std::shared_ptr<services::TaskStateService> pTaskState;
-    std::unique_ptr<services::TaskStorage> pTaskStorage;
-
-    std::unique_ptr<wxTimer> pDismissInfoBarTimer;
+    std::shared_ptr<services::TickScheduler> pScheduler;
+    std::shared_ptr<services::IdleDetector> pIdleDetector;
+    std::shared_ptr<services::StopwatchRegistry> pStopwatchRegistry;
+    std::unique_ptr<svc::DatabaseBackupThread> pBackupThread;
 
     wxButton* pPrevDayBtn;
     wxDatePickerCtrl* pDatePickerCtrl;
@@ -145,6 +161,9 @@ class MainFrame : public wxFrame
     bool bHasPendingTaskToResume;
     long mItemIndex;
     int mSelectedTaskItemId;
+    int mDismissInfoBarTaskId;
+    int mMaintenanceTaskId;
+    int mQueryStatisticsTaskId;
 
     enum {
         IDC_PREV_DAY = wxID_HIGHEST + 1,
@@ -152,8 +171,7 @@ class MainFrame : public wxFrame
         IDC_NEXT_DAY,
         IDC_HOURS_TEXT,
         IDC_LIST,
-        IDC_FEEDBACK,
-        IDC_DISMISS_INFOBAR_TIMER
+        IDC_FEEDBACK
     };
 };
 } // namespace app::frm
@@ -26,7 +26,7 @@ namespace app::model
 CategoryModel::CategoryModel()
     : mCategoryId(0)
     , mName(wxGetEmptyString())
-    , mColor(0, 0, 0)
+    , mColor(0)
     , mDateCreated(wxDefaultDateTime)
     , mDateModified(wxDefaultDateTime)
     , bIsActive(false)
@@ -41,7 +41,7 @@ CategoryModel::CategoryModel(int id)
     mCategoryId = id;
 }
 
-CategoryModel::CategoryModel(wxString name, wxColor color, int projectId)
+CategoryModel::CategoryModel(wxString name, unsigned int color, int projectId)
     : CategoryModel()
 {
     mName = name;
@@ -49,7 +49,12 @@ CategoryModel::CategoryModel(wxString name, wxColor color, int projectId)
     mProjectId = projectId;
 }
 
-CategoryModel::CategoryModel(int id, wxString name, wxColor color, int dateCreated, int dateModified, bool isActive)
+CategoryModel::CategoryModel(int id,
+    wxString name,
+    unsigned int color,
+    int dateCreated,
+    int dateModified,
+    bool isActive)
     : CategoryModel()
 {
     mCategoryId = id;
@@ -80,7 +85,7 @@ const wxString CategoryModel::GetName() const
     return mName;
 }
 
-const wxColor CategoryModel::GetColor() const
+const unsigned int CategoryModel::GetColor() const
 {
     return mColor;
 }
@@ -120,7 +125,7 @@ void CategoryModel::SetName(const wxString& name)
     mName = name;
 }
 
-void CategoryModel::SetColor(const wxColor& color)
+void CategoryModel::SetColor(const unsigned int color)
 {
     mColor = color;
 }
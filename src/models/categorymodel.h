@@ -21,7 +21,6 @@
 
 #include <memory>
 
-#include <wx/colour.h>
 #include <wx/string.h>
 
 #include "projectmodel.h"
@@ -33,15 +32,16 @@ class CategoryModel final
 public:
     CategoryModel();
     CategoryModel(int categoryId);
-    CategoryModel(wxString name, wxColor color, int projectId);
-    CategoryModel(int id, wxString name, wxColor color, int dateCreated, int dateModified, bool isActive);
+    /* the color is an RGB value as returned by wxColour::GetRGB() */
+    CategoryModel(wxString name, unsigned int color, int projectId);
+    CategoryModel(int id, wxString name, unsigned int color, int dateCreated, int dateModified, bool isActive);
 
     bool IsNameValid();
     bool IsProjectSelected();
 
     const int GetCategoryId() const;
     const wxString GetName() const;
-    const wxColor GetColor() const;
+    const unsigned int GetColor() const;
     const wxDateTime GetDateCreated() const;
     const wxDateTime GetDateModified() const;
     const bool IsActive() const;
@@ -51,7 +51,7 @@ class CategoryModel final
 
     void SetCategoryId(const int categoryId);
     void SetName(const wxString& name);
-    void SetColor(const wxColor& color);
+    void SetColor(const unsigned int color);
     void SetDateCreated(const wxDateTime& dateCreated);
     void SetDateModified(const wxDateTime& dateModified);
     void IsActive(const bool isActive);
@@ -62,7 +62,7 @@ class CategoryModel final
 private:
     int mCategoryId;
     wxString mName;
-    wxColor mColor;
+    unsigned int mColor;
     wxDateTime mDateCreated;
     wxDateTime mDateModified;
     bool bIsActive;
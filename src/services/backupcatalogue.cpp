@@ -0,0 +1,359 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupcatalogue.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/hashmap.h>
+#include <wx/regex.h>
+#include <wx/tokenzr.h>
+#include <zlib.h>
+
+#include "../common/common.h"
+#include "differentialbackup.h"
+
+namespace app::svc
+{
+static const wxString CatalogueFileExtension = wxT(".catalogue");
+static const size_t ChecksumChunkSize = 64 * 1024;
+/* catalogues written before archive copies were kept have no archive fields */
+static const size_t CatalogueFieldCount = 9;
+static const size_t CatalogueFieldCountWithoutArchive = 7;
+
+BackupCatalogue::BackupCatalogue(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+    , mEntries()
+    , bLoaded(false)
+{
+}
+
+bool BackupCatalogue::Load()
+{
+    mEntries.clear();
+    bLoaded = false;
+
+    if (pConfig->GetBackupPath().empty() || !wxDirExists(pConfig->GetBackupPath())) {
+        return false;
+    }
+
+    auto catalogueFilePath = GetCatalogueFilePath();
+    if (!wxFileExists(catalogueFilePath)) {
+        bLoaded = Rebuild() && Save();
+        return bLoaded;
+    }
+
+    wxFFile file(catalogueFilePath, wxT("rb"));
+    wxString contents;
+    if (!file.IsOpened() || !file.ReadAll(&contents, wxConvUTF8)) {
+        pLogger->error("Unable to read backup catalogue {0}", catalogueFilePath.ToStdString());
+        return false;
+    }
+
+    wxStringTokenizer lines(contents, wxT("\n"), wxTOKEN_STRTOK);
+    while (lines.HasMoreTokens()) {
+        wxString line = lines.GetNextToken();
+        wxStringTokenizer fields(line, wxT(";"), wxTOKEN_RET_EMPTY_ALL);
+        auto fieldCount = fields.CountTokens();
+        if (fieldCount != CatalogueFieldCount && fieldCount != CatalogueFieldCountWithoutArchive) {
+            pLogger->warn("Skipping malformed backup catalogue entry: {0}", line.ToStdString());
+            continue;
+        }
+
+        BackupCatalogueEntry entry;
+        entry.mFileName = fields.GetNextToken();
+
+        long type = 0;
+        long long size = 0;
+        unsigned long pageCount = 0;
+        unsigned long checksum = 0;
+        if (!entry.mDate.ParseISODate(fields.GetNextToken()) || !fields.GetNextToken().ToLong(&type) ||
+            !fields.GetNextToken().ToLongLong(&size) || !fields.GetNextToken().ToULong(&pageCount) ||
+            !fields.GetNextToken().ToULong(&checksum, 16) || type < static_cast<long>(BackupType::Full) ||
+            type > static_cast<long>(BackupType::Differential)) {
+            pLogger->warn("Skipping malformed backup catalogue entry: {0}", line.ToStdString());
+            continue;
+        }
+
+        entry.mType = static_cast<BackupType>(type);
+        entry.mSize = size;
+        entry.mPageCount = static_cast<std::uint32_t>(pageCount);
+        entry.mChecksum = static_cast<std::uint32_t>(checksum);
+        entry.mBaseFileName = fields.GetNextToken();
+
+        unsigned long archiveChecksum = 0;
+        entry.mArchiveFileName = fieldCount == CatalogueFieldCount ? fields.GetNextToken() : wxGetEmptyString();
+        if (fieldCount == CatalogueFieldCount && !fields.GetNextToken().ToULong(&archiveChecksum, 16)) {
+            pLogger->warn("Skipping malformed backup catalogue entry: {0}", line.ToStdString());
+            continue;
+        }
+        entry.mArchiveChecksum = static_cast<std::uint32_t>(archiveChecksum);
+        mEntries.push_back(entry);
+    }
+
+    Sort();
+    bLoaded = true;
+    return true;
+}
+
+const std::vector<BackupCatalogueEntry>& BackupCatalogue::GetEntries() const
+{
+    return mEntries;
+}
+
+const BackupCatalogueEntry* BackupCatalogue::Find(const wxString& fileName) const
+{
+    auto it = std::find_if(mEntries.begin(), mEntries.end(), [&](const BackupCatalogueEntry& entry) {
+        return entry.mFileName == fileName;
+    });
+    return it != mEntries.end() ? &(*it) : nullptr;
+}
+
+bool BackupCatalogue::Add(const wxString& filePath,
+    BackupType type,
+    std::uint32_t pageCount,
+    const wxString& baseFileName,
+    const wxString& archiveFilePath)
+{
+    if (!bLoaded && !Load()) {
+        return false;
+    }
+
+    BackupCatalogueEntry entry;
+    if (!CreateEntry(filePath, type, pageCount, baseFileName, archiveFilePath, entry)) {
+        return false;
+    }
+
+    /* a backup taken again on the same day replaces the earlier file */
+    mEntries.erase(std::remove_if(mEntries.begin(),
+                       mEntries.end(),
+                       [&](const BackupCatalogueEntry& existing) { return existing.mFileName == entry.mFileName; }),
+        mEntries.end());
+    mEntries.push_back(entry);
+    Sort();
+
+    return Save();
+}
+
+bool BackupCatalogue::Remove(const wxString& fileName)
+{
+    if (!bLoaded && !Load()) {
+        return false;
+    }
+
+    mEntries.erase(std::remove_if(mEntries.begin(),
+                       mEntries.end(),
+                       [&](const BackupCatalogueEntry& entry) { return entry.mFileName == fileName; }),
+        mEntries.end());
+
+    return Save();
+}
+
+bool BackupCatalogue::Remove(const std::vector<wxString>& fileNames)
+{
+    if (!bLoaded && !Load()) {
+        return false;
+    }
+
+    std::unordered_set<wxString, wxStringHash, wxStringEqual> fileNamesToRemove(fileNames.begin(), fileNames.end());
+    mEntries.erase(std::remove_if(mEntries.begin(),
+                       mEntries.end(),
+                       [&](const BackupCatalogueEntry& entry) { return fileNamesToRemove.count(entry.mFileName) > 0; }),
+        mEntries.end());
+
+    return Save();
+}
+
+bool BackupCatalogue::IsArchiveCopy(const wxString& fileName)
+{
+    auto archiveFileName = common::GetArchiveDatabaseFileName();
+    auto archivePrefix = archiveFileName.substr(0, archiveFileName.find(wxT("."))) + wxT(".");
+    return fileName.StartsWith(archivePrefix);
+}
+
+bool BackupCatalogue::CalculateChecksum(const wxString& filePath, std::uint32_t& checksum)
+{
+    wxFile file;
+    if (!file.Open(filePath, wxFile::read)) {
+        return false;
+    }
+
+    std::vector<unsigned char> buffer(ChecksumChunkSize);
+    uLong crc = crc32(0L, Z_NULL, 0);
+    ssize_t bytesRead = 0;
+    while ((bytesRead = file.Read(buffer.data(), ChecksumChunkSize)) > 0) {
+        crc = crc32(crc, buffer.data(), static_cast<uInt>(bytesRead));
+    }
+
+    if (bytesRead == wxInvalidOffset) {
+        return false;
+    }
+
+    checksum = static_cast<std::uint32_t>(crc);
+    return true;
+}
+
+bool BackupCatalogue::Rebuild()
+{
+    wxArrayString files;
+    wxDir::GetAllFiles(pConfig->GetBackupPath(), &files, wxEmptyString, wxDIR_FILES);
+
+    wxRegEx dateRegex(wxT("([0-9]{4}-[0-9]{2}-[0-9]{2})"));
+    if (!dateRegex.IsValid()) {
+        return false;
+    }
+
+    /* archive copies are named by the day they were taken, like the backups they go with */
+    std::unordered_map<wxString, wxString, wxStringHash, wxStringEqual> archiveFilePaths;
+    for (const auto& file : files) {
+        wxFileName fileName(file);
+        if (IsArchiveCopy(fileName.GetFullName()) && dateRegex.Matches(fileName.GetFullName())) {
+            archiveFilePaths[dateRegex.GetMatch(fileName.GetFullName(), 0)] = file;
+        }
+    }
+
+    DifferentialBackup differentialBackup(pConfig, pLogger);
+    for (const auto& file : files) {
+        wxFileName fileName(file);
+        if (!dateRegex.Matches(fileName.GetFullName()) || IsArchiveCopy(fileName.GetFullName())) {
+            continue;
+        }
+
+        auto archiveFilePath = archiveFilePaths.find(dateRegex.GetMatch(fileName.GetFullName(), 0));
+
+        auto type = DifferentialBackup::IsDelta(fileName.GetFullName()) ? BackupType::Differential : BackupType::Full;
+
+        /* a delta that does not say which full backup it needs cannot be restored, so it is left out */
+        wxString baseFileName = wxGetEmptyString();
+        if (type == BackupType::Differential && !differentialBackup.ReadBaseFileName(file, baseFileName)) {
+            continue;
+        }
+
+        BackupCatalogueEntry entry;
+        if (!CreateEntry(file,
+                type,
+                0,
+                baseFileName,
+                archiveFilePath != archiveFilePaths.end() ? archiveFilePath->second : wxGetEmptyString(),
+                entry)) {
+            continue;
+        }
+
+        wxDateTime date;
+        if (date.ParseISODate(dateRegex.GetMatch(fileName.GetFullName(), 0))) {
+            entry.mDate = date;
+        }
+        mEntries.push_back(entry);
+    }
+
+    Sort();
+    pLogger->info("Rebuilt backup catalogue with {0:d} backups", mEntries.size());
+    return true;
+}
+
+bool BackupCatalogue::Save()
+{
+    auto catalogueFilePath = GetCatalogueFilePath();
+    auto temporaryFilePath = wxString::Format(wxT("%s.tmp"), catalogueFilePath);
+
+    wxString contents;
+    for (const auto& entry : mEntries) {
+        contents += wxString::Format(wxT("%s;%s;%d;%lld;%u;%08x;%s;%s;%08x\n"),
+            entry.mFileName,
+            entry.mDate.FormatISODate(),
+            static_cast<int>(entry.mType),
+            static_cast<long long>(entry.mSize),
+            static_cast<unsigned int>(entry.mPageCount),
+            static_cast<unsigned int>(entry.mChecksum),
+            entry.mBaseFileName,
+            entry.mArchiveFileName,
+            static_cast<unsigned int>(entry.mArchiveChecksum));
+    }
+
+    wxFile file;
+    bool success = file.Create(temporaryFilePath, true) && file.Write(contents, wxConvUTF8) && file.Flush();
+    file.Close();
+
+    if (!success || !wxRenameFile(temporaryFilePath, catalogueFilePath, true)) {
+        pLogger->error("Unable to write backup catalogue {0}", catalogueFilePath.ToStdString());
+        wxRemoveFile(temporaryFilePath);
+        return false;
+    }
+    return true;
+}
+
+void BackupCatalogue::Sort()
+{
+    auto isNewer = [](const BackupCatalogueEntry& lhs, const BackupCatalogueEntry& rhs) {
+        return lhs.mDate.IsLaterThan(rhs.mDate) || (lhs.mDate == rhs.mDate && lhs.mFileName > rhs.mFileName);
+    };
+    std::stable_sort(mEntries.begin(), mEntries.end(), isNewer);
+}
+
+bool BackupCatalogue::CreateEntry(const wxString& filePath,
+    BackupType type,
+    std::uint32_t pageCount,
+    const wxString& baseFileName,
+    const wxString& archiveFilePath,
+    BackupCatalogueEntry& entry)
+{
+    wxFileName fileName(filePath);
+    auto size = fileName.GetSize();
+    std::uint32_t checksum = 0;
+    if (size == wxInvalidSize || !CalculateChecksum(filePath, checksum)) {
+        pLogger->error("Unable to read backup {0} for the backup catalogue", filePath.ToStdString());
+        return false;
+    }
+
+    entry.mFileName = fileName.GetFullName();
+    entry.mDate = wxDateTime::Today();
+    entry.mType = type;
+    entry.mSize = static_cast<std::int64_t>(size.GetValue());
+    entry.mPageCount = pageCount;
+    entry.mChecksum = checksum;
+    entry.mBaseFileName = baseFileName;
+    entry.mArchiveFileName = wxGetEmptyString();
+    entry.mArchiveChecksum = 0;
+
+    if (!archiveFilePath.empty()) {
+        std::uint32_t archiveChecksum = 0;
+        if (!CalculateChecksum(archiveFilePath, archiveChecksum)) {
+            pLogger->error("Unable to read archive backup {0} for the backup catalogue", archiveFilePath.ToStdString());
+            return false;
+        }
+        entry.mArchiveFileName = wxFileName(archiveFilePath).GetFullName();
+        entry.mArchiveChecksum = archiveChecksum;
+    }
+    return true;
+}
+
+wxString BackupCatalogue::GetCatalogueFilePath() const
+{
+    wxFileName databaseFileName(common::GetDatabaseFileName());
+    return wxFileName(pConfig->GetBackupPath(), databaseFileName.GetName() + CatalogueFileExtension).GetFullPath();
+}
+} // namespace app::svc
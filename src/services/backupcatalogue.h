@@ -0,0 +1,105 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <wx/datetime.h>
+#include <wx/string.h>
+
+#include "../config/configuration.h"
+
+namespace app::svc
+{
+enum class BackupType : int { Full = 1, Differential };
+
+struct BackupCatalogueEntry {
+    /* file name in the backup directory */
+    wxString mFileName;
+    wxDateTime mDate;
+    BackupType mType;
+    std::int64_t mSize;
+    /* database pages at the time of the backup, 0 when unknown */
+    std::uint32_t mPageCount;
+    /* crc32 of the backup file as stored */
+    std::uint32_t mChecksum;
+    /* full backup a differential backup was taken against, empty for full backups */
+    wxString mBaseFileName;
+    /* copy of the archive database taken with the backup, empty when there was no archive */
+    wxString mArchiveFileName;
+    std::uint32_t mArchiveChecksum;
+};
+
+/*
+ Index of the backups kept next to them in the backup directory. Backups are added when they are
+ taken and removed when they are deleted, so listing, retention and restore never have to scan the
+ directory. The index is only rebuilt from the directory when it does not exist yet. The archive database copy
+ of a backup is not a backup of its own, it is listed on the entry of the backup it was taken with.
+ Every change is written to a temporary file first and then renamed over the index
+ */
+class BackupCatalogue final
+{
+public:
+    BackupCatalogue() = delete;
+    BackupCatalogue(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~BackupCatalogue() = default;
+
+    bool Load();
+
+    /* newest first */
+    const std::vector<BackupCatalogueEntry>& GetEntries() const;
+    const BackupCatalogueEntry* Find(const wxString& fileName) const;
+
+    bool Add(const wxString& filePath,
+        BackupType type,
+        std::uint32_t pageCount,
+        const wxString& baseFileName,
+        const wxString& archiveFilePath);
+    bool Remove(const wxString& fileName);
+    bool Remove(const std::vector<wxString>& fileNames);
+
+    static bool IsArchiveCopy(const wxString& fileName);
+
+    static bool CalculateChecksum(const wxString& filePath, std::uint32_t& checksum);
+
+private:
+    bool Rebuild();
+    bool Save();
+    void Sort();
+
+    bool CreateEntry(const wxString& filePath,
+        BackupType type,
+        std::uint32_t pageCount,
+        const wxString& baseFileName,
+        const wxString& archiveFilePath,
+        BackupCatalogueEntry& entry);
+
+    wxString GetCatalogueFilePath() const;
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    std::vector<BackupCatalogueEntry> mEntries;
+    bool bLoaded;
+};
+} // namespace app::svc
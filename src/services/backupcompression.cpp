@@ -0,0 +1,201 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupcompression.h"
+
+#include <vector>
+
+#include <wx/file.h>
+#include <wx/filefn.h>
+#include <zlib.h>
+
+namespace app::svc
+{
+static const wxString CompressedFileExtension = wxT(".gz");
+static const size_t ChunkSize = 64 * 1024;
+/* 15 bits of window plus 16 selects the gzip wrapper instead of the raw zlib one */
+static const int GzipWindowBits = 15 + 16;
+static const int GzipMemoryLevel = 8;
+
+BackupCompression::BackupCompression(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+bool BackupCompression::Compress(const wxString& sourceFilePath, const wxString& destinationFilePath)
+{
+    wxFile source;
+    if (!source.Open(sourceFilePath, wxFile::read)) {
+        pLogger->error("Failed to open file {0}", sourceFilePath.ToStdString());
+        return false;
+    }
+
+    wxFile destination;
+    if (!destination.Create(destinationFilePath, true)) {
+        pLogger->error("Failed to create file {0}", destinationFilePath.ToStdString());
+        return false;
+    }
+
+    z_stream stream{};
+    int rc = deflateInit2(
+        &stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GzipWindowBits, GzipMemoryLevel, Z_DEFAULT_STRATEGY);
+    if (rc != Z_OK) {
+        pLogger->error("Failed to initialize compression of {0} - {1:d}", sourceFilePath.ToStdString(), rc);
+        destination.Close();
+        wxRemoveFile(destinationFilePath);
+        return false;
+    }
+
+    std::vector<unsigned char> input(ChunkSize);
+    std::vector<unsigned char> output(ChunkSize);
+    bool success = true;
+    int flush = Z_NO_FLUSH;
+    do {
+        ssize_t bytesRead = source.Read(input.data(), ChunkSize);
+        if (bytesRead == wxInvalidOffset) {
+            pLogger->error("Failed to read file {0}", sourceFilePath.ToStdString());
+            success = false;
+            break;
+        }
+
+        flush = source.Eof() ? Z_FINISH : Z_NO_FLUSH;
+        stream.next_in = input.data();
+        stream.avail_in = static_cast<uInt>(bytesRead);
+
+        /* drain the deflate output until it stops filling the whole buffer */
+        do {
+            stream.next_out = output.data();
+            stream.avail_out = static_cast<uInt>(ChunkSize);
+            rc = deflate(&stream, flush);
+            if (rc == Z_STREAM_ERROR) {
+                pLogger->error("Failed to compress file {0}", sourceFilePath.ToStdString());
+                success = false;
+                break;
+            }
+
+            size_t bytesToWrite = ChunkSize - stream.avail_out;
+            if (destination.Write(output.data(), bytesToWrite) != bytesToWrite) {
+                pLogger->error("Failed to write file {0}", destinationFilePath.ToStdString());
+                success = false;
+                break;
+            }
+        } while (stream.avail_out == 0);
+    } while (success && flush != Z_FINISH);
+
+    deflateEnd(&stream);
+    destination.Close();
+
+    if (!success) {
+        wxRemoveFile(destinationFilePath);
+    }
+    return success;
+}
+
+bool BackupCompression::Decompress(const wxString& sourceFilePath, const wxString& destinationFilePath)
+{
+    wxFile source;
+    if (!source.Open(sourceFilePath, wxFile::read)) {
+        pLogger->error("Failed to open file {0}", sourceFilePath.ToStdString());
+        return false;
+    }
+
+    wxFile destination;
+    if (!destination.Create(destinationFilePath, true)) {
+        pLogger->error("Failed to create file {0}", destinationFilePath.ToStdString());
+        return false;
+    }
+
+    z_stream stream{};
+    int rc = inflateInit2(&stream, GzipWindowBits);
+    if (rc != Z_OK) {
+        pLogger->error("Failed to initialize decompression of {0} - {1:d}", sourceFilePath.ToStdString(), rc);
+        destination.Close();
+        wxRemoveFile(destinationFilePath);
+        return false;
+    }
+
+    std::vector<unsigned char> input(ChunkSize);
+    std::vector<unsigned char> output(ChunkSize);
+    bool success = true;
+    do {
+        ssize_t bytesRead = source.Read(input.data(), ChunkSize);
+        if (bytesRead == wxInvalidOffset) {
+            pLogger->error("Failed to read file {0}", sourceFilePath.ToStdString());
+            success = false;
+            break;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+
+        stream.next_in = input.data();
+        stream.avail_in = static_cast<uInt>(bytesRead);
+
+        do {
+            stream.next_out = output.data();
+            stream.avail_out = static_cast<uInt>(ChunkSize);
+            rc = inflate(&stream, Z_NO_FLUSH);
+            if (rc == Z_NEED_DICT || rc == Z_DATA_ERROR || rc == Z_MEM_ERROR || rc == Z_STREAM_ERROR) {
+                pLogger->error("Failed to decompress file {0} - {1:d}", sourceFilePath.ToStdString(), rc);
+                success = false;
+                break;
+            }
+
+            size_t bytesToWrite = ChunkSize - stream.avail_out;
+            if (destination.Write(output.data(), bytesToWrite) != bytesToWrite) {
+                pLogger->error("Failed to write file {0}", destinationFilePath.ToStdString());
+                success = false;
+                break;
+            }
+        } while (stream.avail_out == 0);
+    } while (success && rc != Z_STREAM_END);
+
+    inflateEnd(&stream);
+    destination.Close();
+
+    if (success && rc != Z_STREAM_END) {
+        pLogger->error("Compressed file {0} is truncated", sourceFilePath.ToStdString());
+        success = false;
+    }
+
+    if (!success) {
+        wxRemoveFile(destinationFilePath);
+    }
+    return success;
+}
+
+bool BackupCompression::IsCompressed(const wxString& fileName)
+{
+    return fileName.EndsWith(CompressedFileExtension);
+}
+
+wxString BackupCompression::GetCompressedFileName(const wxString& fileName)
+{
+    return fileName + CompressedFileExtension;
+}
+
+wxString BackupCompression::GetDecompressedFileName(const wxString& fileName)
+{
+    wxString decompressedFileName;
+    if (fileName.EndsWith(CompressedFileExtension, &decompressedFileName)) {
+        return decompressedFileName;
+    }
+    return fileName;
+}
+} // namespace app::svc
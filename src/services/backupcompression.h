@@ -0,0 +1,51 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+
+#include <spdlog/spdlog.h>
+#include <wx/string.h>
+
+namespace app::svc
+{
+/*
+ Streams database backups to and from gzip files (.db.gz) in fixed size chunks, so a backup of
+ any size never has to be held in memory. Output is always written to a new file; on failure the
+ partially written file is removed
+ */
+class BackupCompression final
+{
+public:
+    BackupCompression() = delete;
+    explicit BackupCompression(std::shared_ptr<spdlog::logger> logger);
+    ~BackupCompression() = default;
+
+    bool Compress(const wxString& sourceFilePath, const wxString& destinationFilePath);
+    bool Decompress(const wxString& sourceFilePath, const wxString& destinationFilePath);
+
+    static bool IsCompressed(const wxString& fileName);
+    static wxString GetCompressedFileName(const wxString& fileName);
+    static wxString GetDecompressedFileName(const wxString& fileName);
+
+private:
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+} // namespace app::svc
@@ -0,0 +1,240 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupretention.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include <wx/datetime.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/hashmap.h>
+
+#include "differentialbackup.h"
+
+namespace app::svc
+{
+static const std::int64_t BytesPerMegabyte = 1024 * 1024;
+
+static long DayKey(const wxDateTime& date)
+{
+    return static_cast<long>(date.GetYear()) * 10000 + (static_cast<long>(date.GetMonth()) + 1) * 100 + date.GetDay();
+}
+
+RetentionPlan PlanRetention(const std::vector<BackupCatalogueEntry>& entries, const RetentionPolicy& policy)
+{
+    std::unordered_map<wxString, size_t, wxStringHash, wxStringEqual> indexOfFile;
+    indexOfFile.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        indexOfFile[entries[i].mFileName] = i;
+    }
+
+    /* entries are newest first, so each day, week and month starts where its key changes */
+    std::vector<bool> selected(entries.size(), false);
+    long lastDay = -1;
+    long lastWeek = -1;
+    long lastMonth = -1;
+    int days = 0;
+    int weeks = 0;
+    int months = 0;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& date = entries[i].mDate;
+        long day = DayKey(date);
+        long week = DayKey(wxDateTime(date).SetToWeekDayInSameWeek(wxDateTime::Mon, wxDateTime::Monday_First));
+        long month = static_cast<long>(date.GetYear()) * 12 + static_cast<long>(date.GetMonth());
+
+        if (day != lastDay) {
+            lastDay = day;
+            if (days < policy.mKeepDaily) {
+                days++;
+                selected[i] = true;
+            }
+        }
+        if (week != lastWeek) {
+            lastWeek = week;
+            if (weeks < policy.mKeepWeekly) {
+                weeks++;
+                selected[i] = true;
+            }
+        }
+        if (month != lastMonth) {
+            lastMonth = month;
+            if (months < policy.mKeepMonthly) {
+                months++;
+                selected[i] = true;
+            }
+        }
+    }
+
+    std::vector<bool> kept(entries.size(), false);
+    std::int64_t keptSize = 0;
+    bool hasKept = false;
+
+    auto pinned = indexOfFile.find(policy.mPinnedFileName);
+    if (!policy.mPinnedFileName.empty() && pinned != indexOfFile.end()) {
+        kept[pinned->second] = true;
+        keptSize += entries[pinned->second].mSize;
+        hasKept = true;
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (!selected[i] || kept[i]) {
+            continue;
+        }
+
+        const auto& entry = entries[i];
+        std::int64_t size = entry.mSize;
+        size_t baseIndex = entries.size();
+        /* differential backups from before the catalogue have no known full backup and stand alone */
+        if (entry.mType == BackupType::Differential && !entry.mBaseFileName.empty()) {
+            auto base = indexOfFile.find(entry.mBaseFileName);
+            if (base == indexOfFile.end()) {
+                continue;
+            }
+            baseIndex = base->second;
+            if (!kept[baseIndex]) {
+                size += entries[baseIndex].mSize;
+            }
+        }
+
+        /* the newest backup is kept even when it alone is over the budget */
+        if (policy.mSizeBudget > 0 && hasKept && keptSize + size > policy.mSizeBudget) {
+            continue;
+        }
+
+        kept[i] = true;
+        if (baseIndex < entries.size()) {
+            kept[baseIndex] = true;
+        }
+        keptSize += size;
+        hasKept = true;
+    }
+
+    RetentionPlan plan{};
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (kept[i]) {
+            plan.mKeep.push_back(entries[i].mFileName);
+            plan.mKeptSize += entries[i].mSize;
+        } else {
+            plan.mDelete.push_back(entries[i].mFileName);
+            plan.mDeletedSize += entries[i].mSize;
+        }
+    }
+    return plan;
+}
+
+BackupRetention::BackupRetention(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+{
+}
+
+bool BackupRetention::Execute(bool dryRun, RetentionResult& result)
+{
+    result = RetentionResult{};
+
+    BackupCatalogue catalogue(pConfig, pLogger);
+    if (!catalogue.Load()) {
+        return false;
+    }
+
+    auto plan = PlanRetention(catalogue.GetEntries(), GetPolicy());
+    if (dryRun) {
+        for (const auto& fileName : plan.mDelete) {
+            pLogger->info("Backup retention would delete {0}", fileName.ToStdString());
+        }
+        result.mDeleted = plan.mDelete;
+        result.mFreedSize = plan.mDeletedSize;
+        return true;
+    }
+
+    for (const auto& fileName : plan.mDelete) {
+        auto filePath = wxFileName(pConfig->GetBackupPath(), fileName).GetFullPath();
+        if (wxFileExists(filePath) && !wxRemoveFile(filePath)) {
+            pLogger->error("Failed to remove backup {0}", filePath.ToStdString());
+            result.mFailed.push_back(fileName);
+            continue;
+        }
+
+        result.mDeleted.push_back(fileName);
+        result.mFreedSize += catalogue.Find(fileName)->mSize;
+    }
+
+    if (!result.mDeleted.empty()) {
+        RemoveArchiveCopies(catalogue, result);
+        catalogue.Remove(result.mDeleted);
+        pLogger->info("Backup retention deleted {0:d} backups ({1:d} bytes), {2:d} could not be deleted",
+            result.mDeleted.size(),
+            result.mFreedSize,
+            result.mFailed.size());
+    }
+
+    return result.mFailed.empty();
+}
+
+RetentionPolicy BackupRetention::GetPolicy()
+{
+    RetentionPolicy policy;
+    policy.mKeepDaily = pConfig->GetKeepDailyBackups();
+    policy.mKeepWeekly = pConfig->GetKeepWeeklyBackups();
+    policy.mKeepMonthly = pConfig->GetKeepMonthlyBackups();
+    policy.mSizeBudget = static_cast<std::int64_t>(pConfig->GetBackupSizeLimit()) * BytesPerMegabyte;
+
+    if (pConfig->IsDifferentialBackupEnabled()) {
+        DifferentialBackup differentialBackup(pConfig, pLogger);
+        policy.mPinnedFileName = differentialBackup.GetBaseFileName();
+    }
+    return policy;
+}
+
+/* a backup taken again on the same day shares the archive copy, so it is only deleted with the last backup
+   that refers to it */
+void BackupRetention::RemoveArchiveCopies(const BackupCatalogue& catalogue, RetentionResult& result)
+{
+    std::unordered_set<wxString, wxStringHash, wxStringEqual> deleted(
+        result.mDeleted.begin(), result.mDeleted.end());
+    std::unordered_set<wxString, wxStringHash, wxStringEqual> kept;
+    for (const auto& entry : catalogue.GetEntries()) {
+        if (deleted.count(entry.mFileName) == 0 && !entry.mArchiveFileName.empty()) {
+            kept.insert(entry.mArchiveFileName);
+        }
+    }
+
+    std::unordered_set<wxString, wxStringHash, wxStringEqual> removed;
+    for (const auto& fileName : result.mDeleted) {
+        auto archiveFileName = catalogue.Find(fileName)->mArchiveFileName;
+        if (archiveFileName.empty() || kept.count(archiveFileName) > 0 || removed.count(archiveFileName) > 0) {
+            continue;
+        }
+
+        auto archiveFilePath = wxFileName(pConfig->GetBackupPath(), archiveFileName).GetFullPath();
+        auto size = wxFileName(archiveFilePath).GetSize();
+        if (wxFileExists(archiveFilePath) && !wxRemoveFile(archiveFilePath)) {
+            pLogger->error("Failed to remove archive backup {0}", archiveFilePath.ToStdString());
+            continue;
+        }
+
+        removed.insert(archiveFileName);
+        if (size != wxInvalidSize) {
+            result.mFreedSize += static_cast<std::int64_t>(size.GetValue());
+        }
+    }
+}
+} // namespace app::svc
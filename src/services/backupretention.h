@@ -0,0 +1,88 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <wx/string.h>
+
+#include "../config/configuration.h"
+#include "backupcatalogue.h"
+
+namespace app::svc
+{
+/* grandfather-father-son retention: the newest backup of each of the last days, weeks and months is kept */
+struct RetentionPolicy {
+    int mKeepDaily;
+    int mKeepWeekly;
+    int mKeepMonthly;
+    /* bytes all kept backups together may take up, 0 for no limit */
+    std::int64_t mSizeBudget;
+    /* backup that is always kept, e.g. the full backup current differential backups depend on */
+    wxString mPinnedFileName;
+};
+
+struct RetentionPlan {
+    std::vector<wxString> mKeep;
+    std::vector<wxString> mDelete;
+    std::int64_t mKeptSize;
+    std::int64_t mDeletedSize;
+};
+
+struct RetentionResult {
+    std::vector<wxString> mDeleted;
+    std::vector<wxString> mFailed;
+    std::int64_t mFreedSize;
+};
+
+/*
+ Decides which backups to keep. Pure function over the catalogue entries (newest first, as the
+ catalogue keeps them) that runs in a single pass over the backups for the policy and one for the
+ size budget. A kept differential backup keeps its full backup; one whose full backup is gone cannot
+ be restored and is deleted
+ */
+RetentionPlan PlanRetention(const std::vector<BackupCatalogueEntry>& entries, const RetentionPolicy& policy);
+
+/*
+ Applies the configured retention policy to the backup directory. A dry run only logs and returns
+ what would be deleted. Deleting carries on past backups that cannot be removed and reports them,
+ the catalogue is updated once for the whole batch. Archive copies are deleted with their backups
+ */
+class BackupRetention final
+{
+public:
+    BackupRetention() = delete;
+    BackupRetention(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~BackupRetention() = default;
+
+    bool Execute(bool dryRun, RetentionResult& result);
+
+    RetentionPolicy GetPolicy();
+
+private:
+    void RemoveArchiveCopies(const BackupCatalogue& catalogue, RetentionResult& result);
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+} // namespace app::svc
@@ -0,0 +1,182 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "backupverifier.h"
+
+#include <string>
+
+#include <sqlite_modern_cpp.h>
+#include <wx/filename.h>
+
+#include "../common/constants.h"
+
+namespace app::svc
+{
+/* tables created by create-taskable.sql that every Taskable database has */
+static const char* RequiredTables[] = { "employers", "clients", "rate_types", "currencies", "projects",
+    "categories", "tasks", "task_item_types", "task_items" };
+
+BackupVerifier::BackupVerifier(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+    , mError(wxGetEmptyString())
+{
+}
+
+bool BackupVerifier::VerifyChecksums(const wxString& backupFileName)
+{
+    BackupCatalogue catalogue(pConfig, pLogger);
+    if (!catalogue.Load()) {
+        mError = wxT("The backup catalogue could not be read.");
+        return false;
+    }
+
+    if (!VerifyChecksum(catalogue, backupFileName)) {
+        return false;
+    }
+
+    auto entry = catalogue.Find(backupFileName);
+    if (!entry->mArchiveFileName.empty() && !VerifyFileChecksum(entry->mArchiveFileName, entry->mArchiveChecksum)) {
+        return false;
+    }
+
+    /* a differential backup is only as good as the full backup it was taken against */
+    if (entry->mType == BackupType::Differential && !entry->mBaseFileName.empty()) {
+        return VerifyChecksum(catalogue, entry->mBaseFileName);
+    }
+    return true;
+}
+
+bool BackupVerifier::VerifyDatabase(const wxString& databaseFilePath)
+{
+    try {
+        auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READONLY, nullptr, sqlite::Encoding::UTF8 };
+        sqlite::database database(databaseFilePath.ToStdString(), config);
+
+        std::string quickCheck;
+        database << "PRAGMA quick_check(1);" >> quickCheck;
+        if (quickCheck != "ok") {
+            pLogger->error(
+                "Restored database {0} failed quick_check - {1}", databaseFilePath.ToStdString(), quickCheck);
+            mError = wxT("The backup is corrupt.");
+            return false;
+        }
+
+        for (const auto table : RequiredTables) {
+            int count = 0;
+            database << "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = ?;" << table >> count;
+            if (count == 0) {
+                pLogger->error("Restored database {0} has no table {1}", databaseFilePath.ToStdString(), table);
+                mError = wxT("The backup is not a Taskable database.");
+                return false;
+            }
+        }
+
+        int schemaVersion = 0;
+        database << "PRAGMA user_version;" >> schemaVersion;
+
+        int currentSchemaVersion = static_cast<int>(constants::SchemaVersion::Current);
+        if (schemaVersion > currentSchemaVersion) {
+            pLogger->error("Restored database schema version {0:d} is newer than the current {1:d}",
+                schemaVersion,
+                currentSchemaVersion);
+            mError = wxT("The backup was made by a newer version of Taskable.");
+            return false;
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when verifying restored database {0} - {1:d} : {2}",
+            databaseFilePath.ToStdString(),
+            e.get_code(),
+            e.what());
+        mError = wxT("The backup is not a readable database.");
+        return false;
+    }
+    return true;
+}
+
+bool BackupVerifier::VerifyArchiveDatabase(const wxString& archiveFilePath)
+{
+    try {
+        auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READONLY, nullptr, sqlite::Encoding::UTF8 };
+        sqlite::database database(archiveFilePath.ToStdString(), config);
+
+        std::string quickCheck;
+        database << "PRAGMA quick_check(1);" >> quickCheck;
+        if (quickCheck != "ok") {
+            pLogger->error(
+                "Restored archive database {0} failed quick_check - {1}", archiveFilePath.ToStdString(), quickCheck);
+            mError = wxT("The archive of the backup is corrupt.");
+            return false;
+        }
+
+        int count = 0;
+        database << "SELECT COUNT(*) FROM sqlite_master WHERE type = 'table' AND name = 'task_items';" >> count;
+        if (count == 0) {
+            pLogger->error("Restored archive database {0} has no table task_items", archiveFilePath.ToStdString());
+            mError = wxT("The archive of the backup is not a Taskable archive.");
+            return false;
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when verifying restored archive database {0} - {1:d} : {2}",
+            archiveFilePath.ToStdString(),
+            e.get_code(),
+            e.what());
+        mError = wxT("The archive of the backup is not a readable database.");
+        return false;
+    }
+    return true;
+}
+
+const wxString& BackupVerifier::GetError() const
+{
+    return mError;
+}
+
+bool BackupVerifier::VerifyChecksum(const BackupCatalogue& catalogue, const wxString& fileName)
+{
+    auto entry = catalogue.Find(fileName);
+    if (entry == nullptr) {
+        pLogger->error("Backup {0} is not in the backup catalogue", fileName.ToStdString());
+        mError = wxString::Format(wxT("The backup %s is missing."), fileName);
+        return false;
+    }
+    return VerifyFileChecksum(fileName, entry->mChecksum);
+}
+
+bool BackupVerifier::VerifyFileChecksum(const wxString& fileName, std::uint32_t expectedChecksum)
+{
+    auto filePath = wxFileName(pConfig->GetBackupPath(), fileName).GetFullPath();
+    std::uint32_t checksum = 0;
+    if (!BackupCatalogue::CalculateChecksum(filePath, checksum)) {
+        pLogger->error("Failed to read backup {0}", filePath.ToStdString());
+        mError = wxString::Format(wxT("The backup %s could not be read."), fileName);
+        return false;
+    }
+
+    if (checksum != expectedChecksum) {
+        pLogger->error("Backup {0} checksum {1:x} does not match the catalogue {2:x}",
+            filePath.ToStdString(),
+            checksum,
+            expectedChecksum);
+        mError = wxString::Format(wxT("The backup %s is damaged."), fileName);
+        return false;
+    }
+    return true;
+}
+} // namespace app::svc
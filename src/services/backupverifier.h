@@ -0,0 +1,63 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include <spdlog/spdlog.h>
+#include <wx/string.h>
+
+#include "../config/configuration.h"
+#include "backupcatalogue.h"
+
+namespace app::svc
+{
+/*
+ Checks a backup before it is restored: the stored files against the checksums recorded in the
+ backup catalogue, and the database rebuilt from them with PRAGMA quick_check, the Taskable tables
+ and a schema version (user_version) that is not newer than the one this version of Taskable knows.
+ The archive database copy taken with the backup is checked the same way, short of the schema.
+ Opens its own read only connections and never touches the connection pool, so it can run on a
+ background thread. GetError() describes the first failed check for the user
+ */
+class BackupVerifier final
+{
+public:
+    BackupVerifier() = delete;
+    BackupVerifier(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~BackupVerifier() = default;
+
+    bool VerifyChecksums(const wxString& backupFileName);
+    bool VerifyDatabase(const wxString& databaseFilePath);
+    bool VerifyArchiveDatabase(const wxString& archiveFilePath);
+
+    const wxString& GetError() const;
+
+private:
+    bool VerifyChecksum(const BackupCatalogue& catalogue, const wxString& fileName);
+    bool VerifyFileChecksum(const wxString& fileName, std::uint32_t expectedChecksum);
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    wxString mError;
+};
+} // namespace app::svc
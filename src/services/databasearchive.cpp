@@ -0,0 +1,265 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "databasearchive.h"
+
+#include <cstdint>
+#include <limits>
+
+#include <wx/datetime.h>
+
+#include "../common/common.h"
+#include "../common/constants.h"
+
+namespace app::svc
+{
+/* a batch keeps both files locked only briefly, a month of task items is usually well under it */
+static const int ArchiveBatchSize = 500;
+
+DatabaseArchive::DatabaseArchive(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+{
+    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
+}
+
+DatabaseArchive::~DatabaseArchive()
+{
+    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+}
+
+bool DatabaseArchive::CreateArchiveDatabase(std::shared_ptr<cfg::Configuration> config,
+    std::shared_ptr<spdlog::logger> logger)
+{
+    return CreateArchiveDatabase(common::GetArchiveDatabaseFilePath(config->GetDatabasePath()),
+        common::GetDatabaseFilePath(config->GetDatabasePath()),
+        logger);
+}
+
+bool DatabaseArchive::CreateArchiveDatabase(const wxString& archiveFilePath,
+    const wxString& databaseFilePath,
+    std::shared_ptr<spdlog::logger> logger)
+{
+    try {
+        sqlite::database archive(archiveFilePath.ToStdString());
+        archive << DatabaseArchive::createArchiveTaskItems;
+        archive << DatabaseArchive::createArchiveTaskItemsIndex;
+
+        int searchIndexCount = 0;
+        archive << DatabaseArchive::archiveSearchIndexExists >> searchIndexCount;
+        if (searchIndexCount == 0) {
+            /* archives that predate the index are indexed once, the names live in the live database */
+            int archivedCount = 0;
+            archive << "SELECT COUNT(*) FROM task_items" >> archivedCount;
+            if (archivedCount > 0) {
+                archive << "ATTACH DATABASE ? AS live" << databaseFilePath.ToStdString();
+            }
+
+            archive << "BEGIN TRANSACTION";
+            try {
+                archive << DatabaseArchive::createArchiveSearchIndex;
+                if (archivedCount > 0) {
+                    archive << DatabaseArchive::fillArchiveSearchIndex;
+                }
+                archive << "COMMIT";
+            } catch (const sqlite::sqlite_exception&) {
+                archive << "ROLLBACK";
+                throw;
+            }
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        logger->error("Error occured when creating archive database {0} - {1:d} : {2}",
+            archiveFilePath.ToStdString(),
+            e.get_code(),
+            e.what());
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseArchive::Execute(std::chrono::steady_clock::time_point deadline)
+{
+    if (!pConnection->HasArchive()) {
+        return true;
+    }
+
+    auto database = pConnection->DatabaseExecutableHandle();
+    try {
+        /* an earlier copy can overlap the archive after a restore or an interrupted move */
+        *database << DatabaseArchive::deleteDuplicateTaskItems << std::numeric_limits<std::int64_t>::max();
+        int duplicateCount = sqlite3_changes(database->connection().get());
+        if (duplicateCount > 0) {
+            pLogger->info("Removed {0:d} live task items that were already archived", duplicateCount);
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when removing archived task items - {0:d} : {1}", e.get_code(), e.what());
+        return false;
+    }
+
+    auto cutOffDate = GetCutOffDate(pConfig).ToStdString();
+    int archivedCount = 0;
+    bool success = true;
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        int batchCount = 0;
+        success = ArchiveBatch(cutOffDate, batchCount);
+        archivedCount += batchCount;
+        if (!success || batchCount == 0) {
+            break;
+        }
+    }
+
+    if (archivedCount > 0) {
+        pLogger->info("Archived {0:d} task items", archivedCount);
+    }
+    return success;
+}
+
+bool DatabaseArchive::ArchiveBatch(const std::string& cutOffDate, int& archivedCount)
+{
+    auto database = pConnection->DatabaseExecutableHandle();
+
+    try {
+        std::unique_ptr<std::int64_t> batchEnd = nullptr;
+        *database << DatabaseArchive::getArchiveBatchEnd << cutOffDate << ArchiveBatchSize >>
+            [&](std::unique_ptr<std::int64_t> lastTaskItemId) { batchEnd = std::move(lastTaskItemId); };
+        if (batchEnd == nullptr) {
+            return true;
+        }
+
+        *database << "BEGIN TRANSACTION";
+        try {
+            /* indexed first, the statements select the task items not yet in the archive */
+            *database << DatabaseArchive::indexArchivedTaskItems << cutOffDate << *batchEnd;
+            *database << DatabaseArchive::archiveTaskItems << cutOffDate << *batchEnd;
+            archivedCount = sqlite3_changes(database->connection().get());
+            *database << DatabaseArchive::deleteDuplicateTaskItems << *batchEnd;
+
+            /* from now on the live database alone no longer holds every task item */
+            if (archivedCount > 0) {
+                pConnection->RaiseSchemaVersion(static_cast<int>(constants::SchemaVersion::Archive));
+            }
+            *database << "COMMIT";
+        } catch (const sqlite::sqlite_exception&) {
+            *database << "ROLLBACK";
+            throw;
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        archivedCount = 0;
+        pLogger->error("Error occured when archiving task items - {0:d} : {1}", e.get_code(), e.what());
+        return false;
+    }
+    return true;
+}
+
+wxString DatabaseArchive::GetCutOffDate(std::shared_ptr<cfg::Configuration> config)
+{
+    /* no task date is earlier than an empty string, so only soft deleted task items are archived */
+    int archiveAfterMonths = config->GetArchiveAfterMonths();
+    if (archiveAfterMonths <= 0) {
+        return wxGetEmptyString();
+    }
+
+    /* whole months only, a month is either entirely live or entirely archived */
+    auto cutOff = wxDateTime::Today();
+    cutOff.SetDay(1);
+    cutOff -= wxDateSpan::Months(archiveAfterMonths);
+    return cutOff.FormatISODate();
+}
+
+const std::string DatabaseArchive::createArchiveTaskItems = "CREATE TABLE IF NOT EXISTS task_items "
+                                                            "("
+                                                            "task_item_id INTEGER PRIMARY KEY NOT NULL, "
+                                                            "start_time TEXT NULL, "
+                                                            "end_time TEXT NULL, "
+                                                            "duration TEXT NOT NULL, "
+                                                            "description TEXT NOT NULL, "
+                                                            "billable INTEGER NOT NULL, "
+                                                            "calculated_rate REAL NULL, "
+                                                            "date_created INTEGER NOT NULL, "
+                                                            "date_modified INTEGER NOT NULL, "
+                                                            "is_active INTEGER NOT NULL, "
+                                                            "task_item_type_id INTEGER NOT NULL, "
+                                                            "project_id INTEGER NOT NULL, "
+                                                            "task_id INTEGER NOT NULL, "
+                                                            "category_id INTEGER NOT NULL"
+                                                            ")";
+
+const std::string DatabaseArchive::createArchiveTaskItemsIndex = "CREATE INDEX IF NOT EXISTS task_items_task_id "
+                                                                 "ON task_items(task_id)";
+
+/* a contentful index as the archive has no projects or categories to join, see SqliteConnection for renames.
+   Named apart from the live index so the TEMP triggers can update it by its unqualified name */
+const std::string DatabaseArchive::createArchiveSearchIndex =
+    "CREATE VIRTUAL TABLE archived_task_items_search USING fts5("
+    "description, project, category, "
+    "tokenize='unicode61 remove_diacritics 2', prefix='2 3')";
+
+const std::string DatabaseArchive::archiveSearchIndexExists =
+    "SELECT COUNT(*) "
+    "FROM sqlite_master "
+    "WHERE type = 'table' AND name = 'archived_task_items_search'";
+
+const std::string DatabaseArchive::fillArchiveSearchIndex =
+    "INSERT INTO archived_task_items_search(rowid, description, project, category) "
+    "SELECT task_items.task_item_id, task_items.description, projects.display_name, categories.name "
+    "FROM main.task_items AS task_items "
+    "INNER JOIN live.projects AS projects ON task_items.project_id = projects.project_id "
+    "INNER JOIN live.categories AS categories ON task_items.category_id = categories.category_id";
+
+/* the newest task item always stays live, task_item_id is not AUTOINCREMENT and would be handed out again.
+   A live task item whose id is taken by a different archived one is never moved, so the move can be rerun */
+static const std::string ArchivedTaskItemsCondition =
+    "WHERE (main.task_items.is_active = 0 "
+    "OR main.task_items.task_id IN (SELECT task_id FROM main.tasks WHERE task_date < ?)) "
+    "AND main.task_items.task_item_id < (SELECT MAX(task_item_id) FROM main.task_items) "
+    "AND main.task_items.task_item_id NOT IN (SELECT task_item_id FROM archive.task_items)";
+
+/* the id of the last task item of the next batch, NULL when there is nothing left to archive */
+const std::string DatabaseArchive::getArchiveBatchEnd = "SELECT MAX(task_item_id) FROM "
+                                                        "(SELECT task_item_id FROM main.task_items " +
+                                                        ArchivedTaskItemsCondition +
+                                                        " ORDER BY task_item_id LIMIT ?)";
+
+const std::string DatabaseArchive::indexArchivedTaskItems =
+    "INSERT INTO archive.archived_task_items_search(rowid, description, project, category) "
+    "SELECT main.task_items.task_item_id, main.task_items.description, projects.display_name, categories.name "
+    "FROM main.task_items "
+    "INNER JOIN main.projects AS projects ON main.task_items.project_id = projects.project_id "
+    "INNER JOIN main.categories AS categories ON main.task_items.category_id = categories.category_id " +
+    ArchivedTaskItemsCondition + " AND main.task_items.task_item_id <= ?";
+
+const std::string DatabaseArchive::archiveTaskItems =
+    "INSERT INTO archive.task_items "
+    "(task_item_id, start_time, end_time, duration, description, billable, calculated_rate, "
+    "date_created, date_modified, is_active, task_item_type_id, project_id, task_id, category_id) "
+    "SELECT task_item_id, start_time, end_time, duration, description, billable, calculated_rate, "
+    "date_created, date_modified, is_active, task_item_type_id, project_id, task_id, category_id "
+    "FROM main.task_items " +
+    ArchivedTaskItemsCondition + " AND main.task_items.task_item_id <= ?";
+
+/* the same task item is one with the same id created at the same time, deleting it from the live database
+   also takes it out of the live search index */
+const std::string DatabaseArchive::deleteDuplicateTaskItems =
+    "DELETE FROM main.task_items "
+    "WHERE main.task_items.task_item_id <= ? "
+    "AND EXISTS (SELECT 1 FROM archive.task_items "
+    "WHERE archive.task_items.task_item_id = main.task_items.task_item_id "
+    "AND archive.task_items.date_created = main.task_items.date_created)";
+} // namespace app::svc
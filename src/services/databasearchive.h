@@ -0,0 +1,84 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+#include <sqlite_modern_cpp.h>
+#include <wx/string.h>
+
+#include "../config/configuration.h"
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+
+namespace app::svc
+{
+/*
+ Moves cold task items out of the live database into the archive database (taskable-archive.db) that
+ every pooled connection attaches as "archive". Soft deleted task items are always archived, task items
+ of closed months older than the configured number of months only when that is set.
+ Task items are moved in batches, each a transaction over both files, until none are left or the
+ deadline passes, the rest is moved next run. Task items already in the archive are skipped and their
+ live copies removed, so a rerun after a restore or a failure moves nothing twice.
+ Historical reports and the period view read the all_task_items view that unions both, search reads
+ the index in each file. Day and week views read the live task_items table, and the view for dates
+ before the cut-off date, where task items can no longer be edited
+ */
+class DatabaseArchive final
+{
+public:
+    DatabaseArchive() = delete;
+    DatabaseArchive(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~DatabaseArchive();
+
+    /* has to run before the connection pool is created, ATTACH does not create a missing file */
+    static bool CreateArchiveDatabase(std::shared_ptr<cfg::Configuration> config,
+        std::shared_ptr<spdlog::logger> logger);
+    /* the live database is only read when an archive that predates its search index has to be indexed */
+    static bool CreateArchiveDatabase(const wxString& archiveFilePath,
+        const wxString& databaseFilePath,
+        std::shared_ptr<spdlog::logger> logger);
+
+    /* task items dated before the returned ISO date are archived, empty when archiving by age is off */
+    static wxString GetCutOffDate(std::shared_ptr<cfg::Configuration> config);
+
+    bool Execute(std::chrono::steady_clock::time_point deadline);
+
+private:
+    bool ArchiveBatch(const std::string& cutOffDate, int& archivedCount);
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::shared_ptr<db::SqliteConnection> pConnection;
+
+    static const std::string createArchiveTaskItems;
+    static const std::string createArchiveTaskItemsIndex;
+    static const std::string createArchiveSearchIndex;
+    static const std::string archiveSearchIndexExists;
+    static const std::string fillArchiveSearchIndex;
+    static const std::string getArchiveBatchEnd;
+    static const std::string indexArchivedTaskItems;
+    static const std::string archiveTaskItems;
+    static const std::string deleteDuplicateTaskItems;
+};
+} // namespace app::svc
@@ -19,19 +19,38 @@
 
 #include "databasebackup.h"
 
+#include <algorithm>
 #include <string>
 
 #include <wx/datetime.h>
 #include <wx/file.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
 #include <wx/stdpaths.h>
+#include <wx/utils.h>
 
 #include "../common/common.h"
+#include "backupcatalogue.h"
+#include "backupcompression.h"
+
+wxDEFINE_EVENT(DATABASE_BACKUP_PROGRESS, wxThreadEvent);
+wxDEFINE_EVENT(DATABASE_BACKUP_COMPLETED, wxThreadEvent);
 
 namespace app::svc
 {
+static const int PagesPerStep = 256;
+static const int StepYieldMilliseconds = 2;
+static const int BusyBackoffMinimumMilliseconds = 10;
+static const int BusyBackoffMaximumMilliseconds = 500;
+static const std::string MainSchemaName = "main";
+static const std::string ArchiveSchemaName = "archive";
+
 DatabaseBackup::DatabaseBackup(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger)
     : pConfig(config)
     , pLogger(logger)
+    , mProgressCallback()
+    , mPageCount(0)
+    , bCancelled(false)
 {
     pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
 }
@@ -43,7 +62,18 @@ DatabaseBackup::~DatabaseBackup()
 
 bool DatabaseBackup::Execute()
 {
-    wxString fileName = CreateBackupFileName();
+    if (pConfig->IsDifferentialBackupEnabled()) {
+        DifferentialBackup differentialBackup(pConfig, pLogger);
+        if (!differentialBackup.IsFullBackupDue()) {
+            return ExecuteDifferentialBackup(differentialBackup);
+        }
+    }
+    return ExecuteFullBackup();
+}
+
+bool DatabaseBackup::ExecuteFullBackup()
+{
+    wxString fileName = CreateBackupFileName(common::GetDatabaseFileName(), wxT("db"));
     wxString filePath = CreateBackupPath(fileName);
     if (fileName.empty() || filePath.empty()) {
         return false;
@@ -52,25 +82,131 @@ bool DatabaseBackup::Execute()
     if (!CreateBackupFile(filePath)) {
         return false;
     }
-    if (!ExecuteBackup(filePath)) {
+    wxString archiveFilePath;
+    if (!ExecuteBackup(filePath, MainSchemaName) || !ExecuteArchiveBackup(archiveFilePath)) {
+        wxRemoveFile(filePath);
+        return false;
+    }
+
+    /* page hashes are taken before compression replaces the copy */
+    DifferentialBackup differentialBackup(pConfig, pLogger);
+    PageManifest manifest;
+    bool hasManifest = pConfig->IsDifferentialBackupEnabled() && differentialBackup.HashPages(filePath, manifest);
+
+    if (pConfig->IsBackupCompressionEnabled()) {
+        filePath = CompressBackupFile(filePath);
+    }
+
+    if (hasManifest) {
+        manifest.mBaseFileName = wxFileName(filePath).GetFullName();
+        manifest.mCreated = static_cast<std::int64_t>(wxDateTime::Now().GetTicks());
+        differentialBackup.SaveManifest(manifest);
+    }
+
+    AddToCatalogue(filePath, BackupType::Full, wxGetEmptyString(), archiveFilePath);
+    return true;
+}
+
+bool DatabaseBackup::ExecuteDifferentialBackup(DifferentialBackup& differentialBackup)
+{
+    wxString fileName = CreateBackupFileName(common::GetDatabaseFileName(), wxT("delta"));
+    wxString filePath = CreateBackupPath(fileName);
+    if (fileName.empty() || filePath.empty()) {
+        return false;
+    }
+
+    /* pages are compared on a local snapshot so the live database can keep changing meanwhile */
+    wxString snapshotFilePath = wxFileName::CreateTempFileName(wxT("taskable"));
+    if (snapshotFilePath.empty()) {
+        pLogger->error("Failed to create a temporary file for the database snapshot");
+        return false;
+    }
+
+    bool success =
+        ExecuteBackup(snapshotFilePath, MainSchemaName) && differentialBackup.WriteDelta(snapshotFilePath, filePath);
+    wxRemoveFile(snapshotFilePath);
+
+    if (!success) {
+        /* a manifest that no longer fits the database has been dropped, take a full backup instead */
+        if (!bCancelled && differentialBackup.IsFullBackupDue()) {
+            return ExecuteFullBackup();
+        }
+        return false;
+    }
+
+    wxString archiveFilePath;
+    if (!ExecuteArchiveBackup(archiveFilePath)) {
+        wxRemoveFile(filePath);
         return false;
     }
+
+    if (pConfig->IsBackupCompressionEnabled()) {
+        filePath = CompressBackupFile(filePath);
+    }
+
+    AddToCatalogue(filePath, BackupType::Differential, differentialBackup.GetBaseFileName(), archiveFilePath);
     return true;
 }
 
-wxString DatabaseBackup::CreateBackupFileName()
+/* taken after the database, a task item archived in between is then in both copies rather than in neither,
+   and the next archive run drops the live copy of it */
+bool DatabaseBackup::ExecuteArchiveBackup(wxString& archiveFilePath)
+{
+    archiveFilePath = wxGetEmptyString();
+    if (!pConnection->HasArchive()) {
+        return true;
+    }
+
+    wxString fileName = CreateBackupFileName(common::GetArchiveDatabaseFileName(), wxT("db"));
+    wxString filePath = CreateBackupPath(fileName);
+    if (fileName.empty() || filePath.empty()) {
+        return false;
+    }
+
+    if (!CreateBackupFile(filePath)) {
+        return false;
+    }
+    if (!ExecuteBackup(filePath, ArchiveSchemaName)) {
+        wxRemoveFile(filePath);
+        return false;
+    }
+
+    if (pConfig->IsBackupCompressionEnabled()) {
+        filePath = CompressBackupFile(filePath);
+    }
+
+    archiveFilePath = filePath;
+    return true;
+}
+
+void DatabaseBackup::Cancel()
+{
+    bCancelled = true;
+}
+
+bool DatabaseBackup::IsCancelled() const
+{
+    return bCancelled;
+}
+
+void DatabaseBackup::SetProgressCallback(ProgressCallback callback)
+{
+    mProgressCallback = std::move(callback);
+}
+
+wxString DatabaseBackup::CreateBackupFileName(const wxString& databaseFileName, const wxString& extension)
 {
     auto dateTime = wxDateTime::Now();
     auto dateTimeString = dateTime.FormatISODate();
-    auto indexOfPeriod = common::GetDatabaseFileName().find(wxT("."), 0);
-    wxString databaseFileName = "";
+    auto indexOfPeriod = databaseFileName.find(wxT("."), 0);
+    wxString databaseBaseName = "";
     if (indexOfPeriod != wxString::npos) {
-        databaseFileName = common::GetDatabaseFileName().substr(0, indexOfPeriod);
+        databaseBaseName = databaseFileName.substr(0, indexOfPeriod);
     } else {
         return wxGetEmptyString();
     }
 
-    auto backupFileName = wxString::Format(wxT("%s.%s.db"), databaseFileName, dateTimeString);
+    auto backupFileName = wxString::Format(wxT("%s.%s.%s"), databaseBaseName, dateTimeString, extension);
 
     return backupFileName;
 }
@@ -78,7 +214,7 @@ wxString DatabaseBackup::CreateBackupFileName()
 wxString DatabaseBackup::CreateBackupPath(const wxString& filename)
 {
     auto backupDirectory = pConfig->GetBackupPath();
-    auto backupFilePath = wxString::Format(wxT("%s\\%s"), backupDirectory, filename);
+    auto backupFilePath = wxFileName(backupDirectory, filename).GetFullPath();
     return backupFilePath;
 }
 
@@ -93,22 +229,57 @@ bool DatabaseBackup::CreateBackupFile(const wxString& fileName)
     return success;
 }
 
-bool DatabaseBackup::ExecuteBackup(const wxString& fileName)
+bool DatabaseBackup::ExecuteBackup(const wxString& fileName, const std::string& schemaName)
 {
+    /* the archive copy reports no progress and leaves the page count of the backup alone */
+    bool isMain = schemaName == MainSchemaName;
+
     try {
         auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READWRITE, nullptr, sqlite::Encoding::UTF8 };
         sqlite::database backupConnection(fileName.ToStdString(), config);
         auto existingConnection = pConnection->DatabaseExecutableHandle()->connection();
 
         auto state = std::unique_ptr<sqlite3_backup, decltype(&sqlite3_backup_finish)>(
-            sqlite3_backup_init(backupConnection.connection().get(), "main", existingConnection.get(), "main"),
+            sqlite3_backup_init(
+                backupConnection.connection().get(), "main", existingConnection.get(), schemaName.c_str()),
             sqlite3_backup_finish);
 
-        if (state) {
-            int rc = -1;
-            do {
-                rc = sqlite3_backup_step(state.get(), -1);
-            } while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+        if (!state) {
+            pLogger->error("Failed to initialize database backup - {0}",
+                sqlite3_errmsg(backupConnection.connection().get()));
+            return false;
+        }
+
+        int rc = SQLITE_OK;
+        int busyBackoff = BusyBackoffMinimumMilliseconds;
+        do {
+            if (bCancelled) {
+                pLogger->info("Database backup cancelled");
+                return false;
+            }
+
+            rc = sqlite3_backup_step(state.get(), PagesPerStep);
+            if (rc == SQLITE_OK || rc == SQLITE_DONE) {
+                if (isMain) {
+                    mPageCount = sqlite3_backup_pagecount(state.get());
+                    if (mProgressCallback) {
+                        mProgressCallback(mPageCount - sqlite3_backup_remaining(state.get()), mPageCount);
+                    }
+                }
+                busyBackoff = BusyBackoffMinimumMilliseconds;
+                if (rc == SQLITE_OK) {
+                    /* let writers on the other connections in */
+                    wxMilliSleep(StepYieldMilliseconds);
+                }
+            } else if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED) {
+                wxMilliSleep(busyBackoff);
+                busyBackoff = std::min(busyBackoff * 2, BusyBackoffMaximumMilliseconds);
+            }
+        } while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+
+        if (rc != SQLITE_DONE) {
+            pLogger->error("Error occured when running database backup - {0:d} : {1}", rc, sqlite3_errstr(rc));
+            return false;
         }
     } catch (const sqlite::sqlite_exception& e) {
         pLogger->error("Error occured when running database backup - {0:d} : {1}", e.get_code(), e.what());
@@ -116,4 +287,68 @@ bool DatabaseBackup::ExecuteBackup(const wxString& fileName)
     }
     return true;
 }
+
+wxString DatabaseBackup::CompressBackupFile(const wxString& filePath)
+{
+    /* the backup API needs a real database file, so the finished copy is compressed afterwards */
+    auto compressedFilePath = BackupCompression::GetCompressedFileName(filePath);
+    BackupCompression compression(pLogger);
+    if (bCancelled || !compression.Compress(filePath, compressedFilePath)) {
+        pLogger->warn("Keeping uncompressed database backup {0}", filePath.ToStdString());
+        return filePath;
+    }
+
+    if (!wxRemoveFile(filePath)) {
+        pLogger->error("Failed to remove file {0}", filePath.ToStdString());
+    }
+    return compressedFilePath;
+}
+
+void DatabaseBackup::AddToCatalogue(const wxString& filePath,
+    BackupType type,
+    const wxString& baseFileName,
+    const wxString& archiveFilePath)
+{
+    /* the backup itself is fine without its catalogue entry, the failure is logged by the catalogue */
+    BackupCatalogue catalogue(pConfig, pLogger);
+    catalogue.Add(filePath, type, static_cast<std::uint32_t>(mPageCount), baseFileName, archiveFilePath);
+}
+
+DatabaseBackupThread::DatabaseBackupThread(wxEvtHandler* handler,
+    std::shared_ptr<cfg::Configuration> config,
+    std::shared_ptr<spdlog::logger> logger)
+    : wxThread(wxTHREAD_JOINABLE)
+    , pHandler(handler)
+    , pBackup(nullptr)
+{
+    /* the backup only reads settings, which are safe to read from the thread */
+    pBackup = std::make_unique<DatabaseBackup>(config, logger);
+}
+
+void DatabaseBackupThread::Cancel()
+{
+    pBackup->Cancel();
+}
+
+wxThread::ExitCode DatabaseBackupThread::Entry()
+{
+    int lastPercentage = -1;
+    pBackup->SetProgressCallback([&](int copied, int total) {
+        int percentage = total > 0 ? (copied * 100) / total : 100;
+        if (percentage != lastPercentage) {
+            lastPercentage = percentage;
+            auto event = new wxThreadEvent(DATABASE_BACKUP_PROGRESS);
+            event->SetInt(percentage);
+            wxQueueEvent(pHandler, event);
+        }
+    });
+
+    bool success = pBackup->Execute();
+
+    auto event = new wxThreadEvent(DATABASE_BACKUP_COMPLETED);
+    event->SetInt(success ? 1 : 0);
+    wxQueueEvent(pHandler, event);
+
+    return (wxThread::ExitCode) 0;
+}
 } // namespace app::svc
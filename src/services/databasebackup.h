@@ -19,35 +19,99 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <string>
 
 #include <spdlog/spdlog.h>
 #include <sqlite_modern_cpp.h>
 #include <wx/string.h>
+#include <wx/thread.h>
 
 #include "../config/configuration.h"
 #include "../database/connectionprovider.h"
 #include "../database/sqliteconnection.h"
+#include "backupcatalogue.h"
+#include "differentialbackup.h"
+
+wxDECLARE_EVENT(DATABASE_BACKUP_PROGRESS, wxThreadEvent);
+wxDECLARE_EVENT(DATABASE_BACKUP_COMPLETED, wxThreadEvent);
 
 namespace app::svc
 {
+/*
+ Online backup of the database into the backup directory. The copy is made a few pages at a time
+ on its own pooled connection, yielding between steps and backing off while the database is busy,
+ so it can run next to the UI (see DatabaseBackupThread). A cancelled or failed backup removes its file.
+ With compression enabled the finished copy is streamed into a .db.gz file that replaces it.
+ With differential backups enabled only a periodic full backup is a copy, see DifferentialBackup.
+ The archive database is copied in full right after every backup, a backup without its archive copy
+ is discarded. Every backup taken is recorded in the BackupCatalogue
+ */
 class DatabaseBackup final
 {
 public:
+    /* pages copied so far and total pages in the database */
+    using ProgressCallback = std::function<void(int copied, int total)>;
+
     DatabaseBackup() = delete;
     DatabaseBackup(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
     ~DatabaseBackup();
 
     bool Execute();
+    void Cancel();
+    bool IsCancelled() const;
+
+    void SetProgressCallback(ProgressCallback callback);
 
 private:
-    wxString CreateBackupFileName();
+    bool ExecuteFullBackup();
+    bool ExecuteDifferentialBackup(DifferentialBackup& differentialBackup);
+
+    /* empty path when there is no archive attached */
+    bool ExecuteArchiveBackup(wxString& archiveFilePath);
+
+    wxString CreateBackupFileName(const wxString& databaseFileName, const wxString& extension);
     wxString CreateBackupPath(const wxString& fileName);
     bool CreateBackupFile(const wxString& fileName);
-    bool ExecuteBackup(const wxString& fileName);
+    bool ExecuteBackup(const wxString& fileName, const std::string& schemaName);
+    wxString CompressBackupFile(const wxString& filePath);
+    void AddToCatalogue(const wxString& filePath,
+        BackupType type,
+        const wxString& baseFileName,
+        const wxString& archiveFilePath);
 
     std::shared_ptr<cfg::Configuration> pConfig;
     std::shared_ptr<spdlog::logger> pLogger;
     std::shared_ptr<db::SqliteConnection> pConnection;
+
+    ProgressCallback mProgressCallback;
+    int mPageCount;
+    std::atomic<bool> bCancelled;
+};
+
+/*
+ Runs a DatabaseBackup off the UI thread. Progress (percentage) and completion (1 on success) are
+ queued to the handler as thread events. The thread is joinable: the owner has to Wait() for it
+ and delete it on the UI thread so the pooled connection is released there
+ */
+class DatabaseBackupThread final : public wxThread
+{
+public:
+    DatabaseBackupThread() = delete;
+    DatabaseBackupThread(wxEvtHandler* handler,
+        std::shared_ptr<cfg::Configuration> config,
+        std::shared_ptr<spdlog::logger> logger);
+    virtual ~DatabaseBackupThread() = default;
+
+    void Cancel();
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    wxEvtHandler* pHandler;
+    std::unique_ptr<DatabaseBackup> pBackup;
 };
 } // namespace app::svc
@@ -0,0 +1,254 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "databasemaintenance.h"
+
+#include <algorithm>
+
+#include "../common/util.h"
+#include "databasearchive.h"
+
+namespace app::svc
+{
+static const std::chrono::milliseconds IdleBudget = std::chrono::milliseconds(2000);
+static const std::chrono::milliseconds ExitBudget = std::chrono::milliseconds(5000);
+static const std::chrono::milliseconds OptimizeBudget = std::chrono::milliseconds(500);
+static const std::chrono::milliseconds AnalyzeBudget = std::chrono::milliseconds(2000);
+static const std::chrono::milliseconds IncrementalVacuumBudget = std::chrono::milliseconds(1000);
+static const int MaintenanceIntervalSeconds = 24 * 60 * 60;
+static const int AnalyzeIntervalSeconds = 7 * 24 * 60 * 60;
+static const int AnalysisLimit = 1000;
+static const int VacuumPagesPerStep = 1024;
+static const int ProgressHandlerInstructions = 1000;
+static const int MigrationProgressInstructions = 100000;
+static const int AutoVacuumNone = 0;
+static const int AutoVacuumIncremental = 2;
+
+static int InterruptAfterDeadline(void* context)
+{
+    auto deadline = static_cast<const DatabaseMaintenance::Clock::time_point*>(context);
+    return DatabaseMaintenance::Clock::now() >= *deadline ? 1 : 0;
+}
+
+static int InterruptOnRequest(void* context)
+{
+    auto progress = static_cast<const std::function<bool()>*>(context);
+    return (*progress)() ? 0 : 1;
+}
+
+DatabaseMaintenance::DatabaseMaintenance(std::shared_ptr<cfg::Configuration> config,
+    std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+    , mDeadline()
+{
+    pConnection = db::ConnectionProvider::Get().Handle()->Acquire();
+}
+
+DatabaseMaintenance::~DatabaseMaintenance()
+{
+    db::ConnectionProvider::Get().Handle()->Release(pConnection);
+}
+
+bool DatabaseMaintenance::IsDue(std::shared_ptr<cfg::Configuration> config)
+{
+    return util::UnixTimestamp() - config->GetLastDatabaseMaintenance() >= MaintenanceIntervalSeconds;
+}
+
+bool DatabaseMaintenance::Execute(MaintenanceMode mode)
+{
+    auto start = Clock::now();
+    mDeadline = start + (mode == MaintenanceMode::Exit ? ExitBudget : IdleBudget);
+
+    bool success = RunStep("optimize", "PRAGMA optimize;", OptimizeBudget);
+    success = Archive() && success;
+
+    if (IsAnalyzeDue()) {
+        success = Analyze() && success;
+    }
+
+    if (ReadPragma("auto_vacuum") == AutoVacuumIncremental) {
+        success = IncrementalVacuum() && success;
+    }
+
+    pConfig->SetLastDatabaseMaintenance(util::UnixTimestamp());
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    pLogger->info("Database maintenance finished in {0:d}ms", elapsed.count());
+    return success;
+}
+
+bool DatabaseMaintenance::RunStep(const std::string& name,
+    const std::string& statement,
+    std::chrono::milliseconds budget)
+{
+    auto start = Clock::now();
+    if (start >= mDeadline) {
+        pLogger->info("Database maintenance step {0} skipped, out of time", name);
+        return false;
+    }
+
+    bool success = Run(statement, std::min(start + budget, mDeadline));
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    pLogger->info("Database maintenance step {0} took {1:d}ms", name, elapsed.count());
+    return success;
+}
+
+bool DatabaseMaintenance::Run(const std::string& statement, Clock::time_point deadline)
+{
+    auto database = pConnection->DatabaseExecutableHandle();
+    auto handle = database->connection().get();
+
+    sqlite3_progress_handler(handle, ProgressHandlerInstructions, InterruptAfterDeadline, &deadline);
+
+    bool success = true;
+    try {
+        *database << statement;
+    } catch (const sqlite::sqlite_exception& e) {
+        if (e.get_code() == SQLITE_INTERRUPT) {
+            pLogger->warn("Database maintenance \"{0}\" ran out of time and was interrupted", statement);
+        } else {
+            pLogger->error("Error occured when running database maintenance \"{0}\" - {1:d} : {2}",
+                statement,
+                e.get_code(),
+                e.what());
+        }
+        success = false;
+    }
+
+    sqlite3_progress_handler(handle, 0, nullptr, nullptr);
+    return success;
+}
+
+bool DatabaseMaintenance::Archive()
+{
+    /* the pages freed by the archived task items are reclaimed by the vacuum step that follows */
+    auto start = Clock::now();
+    if (start >= mDeadline) {
+        pLogger->info("Database maintenance step archive skipped, out of time");
+        return false;
+    }
+
+    DatabaseArchive archive(pConfig, pLogger);
+    bool success = archive.Execute(mDeadline);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    pLogger->info("Database maintenance step archive took {0:d}ms", elapsed.count());
+    return success;
+}
+
+bool DatabaseMaintenance::IsAnalyzeDue() const
+{
+    return util::UnixTimestamp() - pConfig->GetLastDatabaseAnalyze() >= AnalyzeIntervalSeconds;
+}
+
+bool DatabaseMaintenance::Analyze()
+{
+    /* sampled statistics are good enough for the planner and keep ANALYZE cheap on large tables */
+    if (!Run("PRAGMA analysis_limit=" + std::to_string(AnalysisLimit) + ";", mDeadline)) {
+        return false;
+    }
+
+    if (!RunStep("analyze", "ANALYZE;", AnalyzeBudget)) {
+        return false;
+    }
+
+    pConfig->SetLastDatabaseAnalyze(util::UnixTimestamp());
+    return true;
+}
+
+bool DatabaseMaintenance::IsVacuumMigrationPending()
+{
+    return ReadPragma("auto_vacuum") == AutoVacuumNone;
+}
+
+bool DatabaseMaintenance::MigrateToIncrementalVacuum(std::function<bool()> progress)
+{
+    auto database = pConnection->DatabaseExecutableHandle();
+    auto handle = database->connection().get();
+    auto start = Clock::now();
+
+    /* auto_vacuum only takes effect after a VACUUM, an interrupted VACUUM leaves the database untouched */
+    pLogger->info("Migrating database to auto_vacuum=INCREMENTAL");
+    sqlite3_progress_handler(handle, MigrationProgressInstructions, InterruptOnRequest, &progress);
+
+    bool success = true;
+    try {
+        *database << "PRAGMA auto_vacuum=INCREMENTAL;";
+        *database << "VACUUM;";
+    } catch (const sqlite::sqlite_exception& e) {
+        if (e.get_code() == SQLITE_INTERRUPT) {
+            pLogger->warn("Database migration to auto_vacuum=INCREMENTAL was abandoned");
+        } else {
+            pLogger->error("Error occured when migrating database to auto_vacuum=INCREMENTAL - {0:d} : {1}",
+                e.get_code(),
+                e.what());
+        }
+        success = false;
+    }
+
+    sqlite3_progress_handler(handle, 0, nullptr, nullptr);
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    pLogger->info("Database migration to auto_vacuum=INCREMENTAL took {0:d}ms", elapsed.count());
+    return success;
+}
+
+bool DatabaseMaintenance::IncrementalVacuum()
+{
+    int freePages = ReadPragma("freelist_count");
+    if (freePages <= 0) {
+        return freePages == 0;
+    }
+
+    /* released in chunks so pages freed before the budget runs out stay committed */
+    auto start = Clock::now();
+    auto deadline = std::min(start + IncrementalVacuumBudget, mDeadline);
+    auto statement = "PRAGMA incremental_vacuum(" + std::to_string(VacuumPagesPerStep) + ");";
+
+    bool success = true;
+    int remainingPages = freePages;
+    while (remainingPages > 0 && Clock::now() < deadline) {
+        success = Run(statement, deadline);
+        if (!success) {
+            break;
+        }
+        remainingPages = ReadPragma("freelist_count");
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+    pLogger->info("Database maintenance step incremental_vacuum released {0:d} of {1:d} free pages in {2:d}ms",
+        freePages - std::max(remainingPages, 0),
+        freePages,
+        elapsed.count());
+    return success;
+}
+
+int DatabaseMaintenance::ReadPragma(const std::string& pragma)
+{
+    int value = -1;
+    try {
+        *pConnection->DatabaseExecutableHandle() << "PRAGMA " + pragma + ";" >> value;
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when reading PRAGMA {0} - {1:d} : {2}", pragma, e.get_code(), e.what());
+    }
+    return value;
+}
+} // namespace app::svc
@@ -0,0 +1,78 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <spdlog/spdlog.h>
+#include <sqlite_modern_cpp.h>
+
+#include "../config/configuration.h"
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+
+namespace app::svc
+{
+enum class MaintenanceMode { Idle, Exit };
+
+/*
+ Keeps query plans and the file size of a long lived database healthy. Every run does a PRAGMA optimize,
+ moves cold task items into the archive (see DatabaseArchive), an ANALYZE once a week and reclaims free
+ pages with incremental_vacuum. Each step is time boxed, through the sqlite progress handler or by
+ working in batches, an interrupted step is picked up next run.
+ A database created without auto_vacuum has to be migrated to auto_vacuum=INCREMENTAL with a full VACUUM
+ first. That cannot be split up, so it is not part of a run and is left to MigrateToIncrementalVacuum
+ */
+class DatabaseMaintenance final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    DatabaseMaintenance() = delete;
+    DatabaseMaintenance(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~DatabaseMaintenance();
+
+    static bool IsDue(std::shared_ptr<cfg::Configuration> config);
+
+    bool Execute(MaintenanceMode mode);
+
+    bool IsVacuumMigrationPending();
+    /* not time boxed, progress is called now and then and abandons the migration when it returns false */
+    bool MigrateToIncrementalVacuum(std::function<bool()> progress);
+
+private:
+    bool RunStep(const std::string& name, const std::string& statement, std::chrono::milliseconds budget);
+    bool Run(const std::string& statement, Clock::time_point deadline);
+    bool Archive();
+    bool IsAnalyzeDue() const;
+    bool Analyze();
+    bool IncrementalVacuum();
+    int ReadPragma(const std::string& pragma);
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+    std::shared_ptr<db::SqliteConnection> pConnection;
+
+    Clock::time_point mDeadline;
+};
+} // namespace app::svc
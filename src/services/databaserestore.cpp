@@ -0,0 +1,307 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "databaserestore.h"
+
+#include <sqlite_modern_cpp.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#ifdef __WXMSW__
+#include <wx/msw/wrapwin.h>
+#endif // __WXMSW__
+
+#include "../common/common.h"
+#include "../common/constants.h"
+#include "../database/connectionprovider.h"
+#include "backupcatalogue.h"
+#include "backupcompression.h"
+#include "backupverifier.h"
+#include "databasearchive.h"
+#include "differentialbackup.h"
+#include "searchindex.h"
+
+wxDEFINE_EVENT(DATABASE_RESTORE_COMPLETED, wxThreadEvent);
+
+namespace app::svc
+{
+DatabaseRestore::DatabaseRestore(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+    , mRestoredFilePath(wxGetEmptyString())
+    , mRestoredArchiveFilePath(wxGetEmptyString())
+    , mError(wxGetEmptyString())
+{
+}
+
+DatabaseRestore::~DatabaseRestore()
+{
+    /* prepared files that never got swapped in */
+    if (!mRestoredFilePath.empty() && wxFileExists(mRestoredFilePath)) {
+        wxRemoveFile(mRestoredFilePath);
+    }
+    if (!mRestoredArchiveFilePath.empty() && wxFileExists(mRestoredArchiveFilePath)) {
+        wxRemoveFile(mRestoredArchiveFilePath);
+    }
+}
+
+bool DatabaseRestore::Prepare(const wxString& backupFileName)
+{
+    BackupVerifier verifier(pConfig, pLogger);
+    if (!verifier.VerifyChecksums(backupFileName)) {
+        mError = verifier.GetError();
+        return false;
+    }
+
+    /* next to the database file, so the swap is a rename within the same directory */
+    mRestoredFilePath =
+        wxString::Format(wxT("%s.restoring"), common::GetDatabaseFilePath(pConfig->GetDatabasePath()));
+    if (!CreateRestoredFile(backupFileName)) {
+        mError = wxT("The backup could not be copied next to the database.");
+        return false;
+    }
+
+    if (!verifier.VerifyDatabase(mRestoredFilePath)) {
+        mError = verifier.GetError();
+        wxRemoveFile(mRestoredFilePath);
+        return false;
+    }
+
+    /* the checksums were verified against it, so the entry is there */
+    BackupCatalogue catalogue(pConfig, pLogger);
+    catalogue.Load();
+    auto entry = catalogue.Find(backupFileName);
+    if (entry == nullptr || !CreateRestoredArchiveFile(entry->mArchiveFileName)) {
+        mError = wxT("The archive of the backup could not be copied next to the database.");
+        wxRemoveFile(mRestoredFilePath);
+        return false;
+    }
+
+    if (!mRestoredArchiveFilePath.empty() && !verifier.VerifyArchiveDatabase(mRestoredArchiveFilePath)) {
+        mError = verifier.GetError();
+        wxRemoveFile(mRestoredFilePath);
+        wxRemoveFile(mRestoredArchiveFilePath);
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseRestore::Swap(bool reinitializeConnectionPool)
+{
+    auto databaseFilePath = common::GetDatabaseFilePath(pConfig->GetDatabasePath());
+    auto previousDatabaseFilePath = wxString::Format(wxT("%s.tmp"), databaseFilePath);
+    auto archiveFilePath = common::GetArchiveDatabaseFilePath(pConfig->GetDatabasePath());
+    auto previousArchiveFilePath = wxString::Format(wxT("%s.tmp"), archiveFilePath);
+
+    /* Terminate connections to the database being replaced */
+    if (reinitializeConnectionPool) {
+        db::ConnectionProvider::Get().PurgeConnectionPool();
+    }
+
+    bool replaced = ReplaceDatabaseFile(databaseFilePath, mRestoredFilePath, previousDatabaseFilePath);
+    if (replaced && !mRestoredArchiveFilePath.empty()) {
+        replaced = ReplaceDatabaseFile(archiveFilePath, mRestoredArchiveFilePath, previousArchiveFilePath);
+
+        /* the current archive is still in place and only goes with the current database */
+        if (!replaced && wxFileExists(previousDatabaseFilePath) &&
+            !wxRenameFile(previousDatabaseFilePath, databaseFilePath, true)) {
+            pLogger->error("Failed to put back {0}", databaseFilePath.ToStdString());
+        }
+    }
+
+    /* Restore connections, to the restored database or to the untouched current one */
+    if (reinitializeConnectionPool) {
+        InitializeConnectionPool();
+    }
+
+    /* a backup taken before the search index existed is restored without it */
+    if (replaced && reinitializeConnectionPool) {
+        SearchIndex searchIndex(pLogger);
+        searchIndex.Initialize();
+    }
+
+    if (!replaced) {
+        mError = wxT("The database file could not be replaced.");
+        return false;
+    }
+
+    mRestoredFilePath = wxGetEmptyString();
+    mRestoredArchiveFilePath = wxGetEmptyString();
+    if (wxFileExists(previousDatabaseFilePath) && !wxRemoveFile(previousDatabaseFilePath)) {
+        pLogger->error("Failed to remove file {0}", previousDatabaseFilePath.ToStdString());
+    }
+    if (wxFileExists(previousArchiveFilePath) && !wxRemoveFile(previousArchiveFilePath)) {
+        pLogger->error("Failed to remove file {0}", previousArchiveFilePath.ToStdString());
+    }
+    return true;
+}
+
+const wxString& DatabaseRestore::GetError() const
+{
+    return mError;
+}
+
+bool DatabaseRestore::CreateRestoredFile(const wxString& backupFileName)
+{
+    auto backupFilePath = wxFileName(pConfig->GetBackupPath(), backupFileName).GetFullPath();
+
+    if (DifferentialBackup::IsDelta(backupFileName)) {
+        DifferentialBackup differentialBackup(pConfig, pLogger);
+        return differentialBackup.Restore(backupFilePath, mRestoredFilePath);
+    }
+
+    if (BackupCompression::IsCompressed(backupFileName)) {
+        BackupCompression compression(pLogger);
+        return compression.Decompress(backupFilePath, mRestoredFilePath);
+    }
+
+    if (!wxCopyFile(backupFilePath, mRestoredFilePath, true)) {
+        pLogger->error(
+            "Failed to copy {0} to destination {1}", backupFilePath.ToStdString(), mRestoredFilePath.ToStdString());
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseRestore::CreateRestoredArchiveFile(const wxString& archiveFileName)
+{
+    mRestoredArchiveFilePath =
+        wxString::Format(wxT("%s.restoring"), common::GetArchiveDatabaseFilePath(pConfig->GetDatabasePath()));
+
+    if (!archiveFileName.empty()) {
+        auto archiveBackupFilePath = wxFileName(pConfig->GetBackupPath(), archiveFileName).GetFullPath();
+        if (BackupCompression::IsCompressed(archiveFileName)) {
+            BackupCompression compression(pLogger);
+            return compression.Decompress(archiveBackupFilePath, mRestoredArchiveFilePath);
+        }
+
+        if (!wxCopyFile(archiveBackupFilePath, mRestoredArchiveFilePath, true)) {
+            pLogger->error("Failed to copy {0} to destination {1}",
+                archiveBackupFilePath.ToStdString(),
+                mRestoredArchiveFilePath.ToStdString());
+            return false;
+        }
+        return true;
+    }
+
+    /* backups taken before archive copies were kept, the current archive is the best there is once
+       task items have been archived, before that every task item is in the backup itself */
+    int schemaVersion = 0;
+    try {
+        auto config = sqlite::sqlite_config{ sqlite::OpenFlags::READONLY, nullptr, sqlite::Encoding::UTF8 };
+        sqlite::database database(mRestoredFilePath.ToStdString(), config);
+        database << "PRAGMA user_version;" >> schemaVersion;
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when reading the schema version of {0} - {1:d} : {2}",
+            mRestoredFilePath.ToStdString(),
+            e.get_code(),
+            e.what());
+        return false;
+    }
+
+    if (schemaVersion >= static_cast<int>(constants::SchemaVersion::Archive)) {
+        pLogger->warn("Backup has no archive copy, keeping the current archive");
+        mRestoredArchiveFilePath = wxGetEmptyString();
+        return true;
+    }
+
+    if (wxFileExists(mRestoredArchiveFilePath)) {
+        wxRemoveFile(mRestoredArchiveFilePath);
+    }
+    return DatabaseArchive::CreateArchiveDatabase(mRestoredArchiveFilePath, mRestoredFilePath, pLogger);
+}
+
+bool DatabaseRestore::ReplaceDatabaseFile(const wxString& databaseFilePath,
+    const wxString& restoredFilePath,
+    const wxString& previousDatabaseFilePath)
+{
+#ifdef __WXMSW__
+    BOOL replaced = FALSE;
+    if (wxFileExists(databaseFilePath)) {
+        /* the current database is kept as the previous file until the restored one is in place */
+        replaced = ::ReplaceFileW(databaseFilePath.wc_str(),
+            restoredFilePath.wc_str(),
+            previousDatabaseFilePath.wc_str(),
+            REPLACEFILE_IGNORE_MERGE_ERRORS,
+            nullptr,
+            nullptr);
+    } else {
+        replaced = ::MoveFileExW(restoredFilePath.wc_str(), databaseFilePath.wc_str(), MOVEFILE_WRITE_THROUGH);
+    }
+
+    if (!replaced) {
+        pLogger->error("Failed to replace {0} with {1} - {2:d}",
+            databaseFilePath.ToStdString(),
+            restoredFilePath.ToStdString(),
+            static_cast<int>(::GetLastError()));
+        return false;
+    }
+    return true;
+#else
+    /* rename() replaces the destination atomically but keeps nothing, so the previous file is copied first
+       for the database to be put back if the archive cannot be swapped in */
+    if (wxFileExists(databaseFilePath) && !wxCopyFile(databaseFilePath, previousDatabaseFilePath, true)) {
+        pLogger->error(
+            "Failed to copy {0} to {1}", databaseFilePath.ToStdString(), previousDatabaseFilePath.ToStdString());
+        return false;
+    }
+
+    if (!wxRenameFile(restoredFilePath, databaseFilePath, true)) {
+        pLogger->error(
+            "Failed to replace {0} with {1}", databaseFilePath.ToStdString(), restoredFilePath.ToStdString());
+        return false;
+    }
+    return true;
+#endif // __WXMSW__
+}
+
+void DatabaseRestore::InitializeConnectionPool()
+{
+    /* an archive restored from a copy that predates its search index is indexed here */
+    wxString archiveFilePath;
+    if (DatabaseArchive::CreateArchiveDatabase(pConfig, pLogger)) {
+        archiveFilePath = common::GetArchiveDatabaseFilePath(pConfig->GetDatabasePath());
+    }
+
+    /* sized and opened like the pool created at startup, the connections the restore does not need open on demand */
+    auto connectionPool = db::ConnectionProvider::CreateConnectionPool(
+        common::GetDatabaseFilePath(pConfig->GetDatabasePath()).ToStdString(), archiveFilePath.ToStdString());
+    db::ConnectionProvider::Get().ReInitializeConnectionPool(std::move(connectionPool));
+}
+
+DatabaseRestoreThread::DatabaseRestoreThread(wxEvtHandler* handler,
+    std::shared_ptr<DatabaseRestore> restore,
+    const wxString& backupFileName)
+    : wxThread(wxTHREAD_JOINABLE)
+    , pHandler(handler)
+    , pRestore(restore)
+    , mBackupFileName(backupFileName)
+{
+}
+
+wxThread::ExitCode DatabaseRestoreThread::Entry()
+{
+    bool success = pRestore->Prepare(mBackupFileName);
+
+    auto event = new wxThreadEvent(DATABASE_RESTORE_COMPLETED);
+    event->SetInt(success ? 1 : 0);
+    wxQueueEvent(pHandler, event);
+
+    return (wxThread::ExitCode) 0;
+}
+} // namespace app::svc
@@ -0,0 +1,94 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+
+#include <spdlog/spdlog.h>
+#include <wx/event.h>
+#include <wx/string.h>
+#include <wx/thread.h>
+
+#include "../config/configuration.h"
+
+wxDECLARE_EVENT(DATABASE_RESTORE_COMPLETED, wxThreadEvent);
+
+namespace app::svc
+{
+/*
+ Restores the database from a backup in two steps. Prepare() rebuilds the backup next to the
+ database file (copy, decompression or differential merge) and verifies it, which is the slow part
+ and touches neither the database nor the connection pool. Swap() then has to run on the UI thread:
+ it closes the pool, swaps the verified file in with a single atomic rename and opens a new pool.
+ The archive database is restored from the copy taken with the backup and swapped in right after,
+ if that fails the current database is put back. A backup from before any task item was archived
+ comes with an empty archive. If anything fails before the swap the current database is left as it was
+ */
+class DatabaseRestore final
+{
+public:
+    DatabaseRestore() = delete;
+    DatabaseRestore(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~DatabaseRestore();
+
+    bool Prepare(const wxString& backupFileName);
+    bool Swap(bool reinitializeConnectionPool);
+
+    const wxString& GetError() const;
+
+private:
+    bool CreateRestoredFile(const wxString& backupFileName);
+    bool CreateRestoredArchiveFile(const wxString& archiveFileName);
+    bool ReplaceDatabaseFile(const wxString& databaseFilePath,
+        const wxString& restoredFilePath,
+        const wxString& previousDatabaseFilePath);
+    void InitializeConnectionPool();
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    wxString mRestoredFilePath;
+    /* empty when the current archive is kept */
+    wxString mRestoredArchiveFilePath;
+    wxString mError;
+};
+
+/*
+ Runs DatabaseRestore::Prepare off the UI thread and queues DATABASE_RESTORE_COMPLETED (1 when the
+ backup is ready to be swapped in) to the handler. Joinable, the owner Wait()s for it and deletes it
+ */
+class DatabaseRestoreThread final : public wxThread
+{
+public:
+    DatabaseRestoreThread() = delete;
+    DatabaseRestoreThread(wxEvtHandler* handler,
+        std::shared_ptr<DatabaseRestore> restore,
+        const wxString& backupFileName);
+    virtual ~DatabaseRestoreThread() = default;
+
+protected:
+    ExitCode Entry() override;
+
+private:
+    wxEvtHandler* pHandler;
+    std::shared_ptr<DatabaseRestore> pRestore;
+    wxString mBackupFileName;
+};
+} // namespace app::svc
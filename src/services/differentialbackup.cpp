@@ -0,0 +1,473 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "differentialbackup.h"
+
+#include <cstring>
+#include <string>
+
+#include <wx/datetime.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <zlib.h>
+
+#include "../common/common.h"
+#include "backupcompression.h"
+
+namespace app::svc
+{
+static const char ManifestMagic[8] = { 'T', 'K', 'M', 'A', 'N', 'I', 'F', '1' };
+static const char DeltaMagic[8] = { 'T', 'K', 'D', 'E', 'L', 'T', 'A', '1' };
+static const wxString DeltaFileExtension = wxT(".delta");
+static const wxString ManifestFileExtension = wxT(".manifest");
+/* offset of the big-endian page size in the sqlite database header */
+static const wxFileOffset PageSizeHeaderOffset = 16;
+static const std::uint32_t MinimumPageSize = 512;
+static const std::uint32_t MaximumPageSize = 65536;
+
+/* manifests and deltas are only ever read back on the machine that wrote them, so values are stored as-is */
+template<typename T>
+static bool WriteValue(wxFile& file, T value)
+{
+    return file.Write(&value, sizeof(T)) == sizeof(T);
+}
+
+template<typename T>
+static bool ReadValue(wxFile& file, T& value)
+{
+    return file.Read(&value, sizeof(T)) == static_cast<ssize_t>(sizeof(T));
+}
+
+static bool WriteString(wxFile& file, const wxString& value)
+{
+    auto utf8 = value.ToUTF8();
+    auto length = static_cast<std::uint32_t>(utf8.length());
+    return WriteValue(file, length) && file.Write(utf8.data(), length) == length;
+}
+
+static bool ReadString(wxFile& file, wxString& value)
+{
+    std::uint32_t length = 0;
+    if (!ReadValue(file, length)) {
+        return false;
+    }
+
+    std::string buffer(length, '\0');
+    if (file.Read(&buffer[0], length) != static_cast<ssize_t>(length)) {
+        return false;
+    }
+    value = wxString::FromUTF8(buffer.data(), length);
+    return true;
+}
+
+static bool IsValidPageSize(std::uint32_t pageSize)
+{
+    return pageSize >= MinimumPageSize && pageSize <= MaximumPageSize && (pageSize & (pageSize - 1)) == 0;
+}
+
+static bool ReadDeltaHeader(wxFile& delta,
+    std::uint32_t& pageSize,
+    std::uint32_t& pageCount,
+    wxString& baseFileName,
+    std::uint32_t& changedPageCount)
+{
+    char magic[sizeof(DeltaMagic)];
+    return delta.Read(magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic)) &&
+           std::memcmp(magic, DeltaMagic, sizeof(magic)) == 0 && ReadValue(delta, pageSize) &&
+           IsValidPageSize(pageSize) && ReadValue(delta, pageCount) && ReadString(delta, baseFileName) &&
+           ReadValue(delta, changedPageCount);
+}
+
+DifferentialBackup::DifferentialBackup(std::shared_ptr<cfg::Configuration> config,
+    std::shared_ptr<spdlog::logger> logger)
+    : pConfig(config)
+    , pLogger(logger)
+{
+}
+
+bool DifferentialBackup::IsFullBackupDue()
+{
+    PageManifest manifest;
+    if (!LoadManifest(manifest)) {
+        return true;
+    }
+
+    if (!wxFileExists(GetBackupFilePath(manifest.mBaseFileName))) {
+        return true;
+    }
+
+    const std::int64_t OneDay = 24 * 60 * 60;
+    auto age = static_cast<std::int64_t>(wxDateTime::Now().GetTicks()) - manifest.mCreated;
+    return age >= OneDay * pConfig->GetFullBackupInterval();
+}
+
+wxString DifferentialBackup::GetBaseFileName()
+{
+    PageManifest manifest;
+    if (!LoadManifest(manifest)) {
+        return wxGetEmptyString();
+    }
+    return manifest.mBaseFileName;
+}
+
+bool DifferentialBackup::HashPages(const wxString& databaseFilePath, PageManifest& manifest)
+{
+    wxFile file;
+    if (!file.Open(databaseFilePath, wxFile::read)) {
+        pLogger->error("Failed to open file {0}", databaseFilePath.ToStdString());
+        return false;
+    }
+
+    std::uint32_t pageSize = 0;
+    if (!ReadPageSize(file, databaseFilePath, pageSize)) {
+        return false;
+    }
+
+    manifest.mPageSize = pageSize;
+    manifest.mPageHashes.clear();
+    manifest.mPageHashes.reserve(static_cast<size_t>(file.Length() / pageSize));
+
+    std::vector<unsigned char> page(pageSize);
+    ssize_t bytesRead = 0;
+    while ((bytesRead = file.Read(page.data(), pageSize)) > 0) {
+        manifest.mPageHashes.push_back(HashPage(page.data(), static_cast<std::uint32_t>(bytesRead)));
+    }
+
+    if (bytesRead == wxInvalidOffset) {
+        pLogger->error("Failed to read file {0}", databaseFilePath.ToStdString());
+        return false;
+    }
+    return true;
+}
+
+bool DifferentialBackup::SaveManifest(const PageManifest& manifest)
+{
+    auto manifestFilePath = GetManifestFilePath();
+    wxFile file;
+    if (!file.Create(manifestFilePath, true)) {
+        pLogger->error("Failed to create file {0}", manifestFilePath.ToStdString());
+        return false;
+    }
+
+    bool success = file.Write(ManifestMagic, sizeof(ManifestMagic)) == sizeof(ManifestMagic) &&
+                   WriteValue(file, manifest.mPageSize) && WriteValue(file, manifest.mCreated) &&
+                   WriteString(file, manifest.mBaseFileName) &&
+                   WriteValue(file, static_cast<std::uint32_t>(manifest.mPageHashes.size()));
+
+    size_t hashesSize = manifest.mPageHashes.size() * sizeof(std::uint64_t);
+    success = success && file.Write(manifest.mPageHashes.data(), hashesSize) == hashesSize;
+    success = success && file.Flush();
+    file.Close();
+
+    if (!success) {
+        pLogger->error("Failed to write file {0}", manifestFilePath.ToStdString());
+        wxRemoveFile(manifestFilePath);
+    }
+    return success;
+}
+
+bool DifferentialBackup::WriteDelta(const wxString& snapshotFilePath, const wxString& deltaFilePath)
+{
+    PageManifest manifest;
+    if (!LoadManifest(manifest)) {
+        pLogger->error("No page manifest of a full backup to take a differential backup against");
+        return false;
+    }
+
+    wxFile snapshot;
+    if (!snapshot.Open(snapshotFilePath, wxFile::read)) {
+        pLogger->error("Failed to open file {0}", snapshotFilePath.ToStdString());
+        return false;
+    }
+
+    std::uint32_t pageSize = 0;
+    if (!ReadPageSize(snapshot, snapshotFilePath, pageSize)) {
+        return false;
+    }
+
+    if (pageSize != manifest.mPageSize) {
+        /* pages no longer line up with the full backup, so force a new one */
+        pLogger->warn("Database page size changed from {0:d} to {1:d}, a full backup is needed",
+            manifest.mPageSize,
+            pageSize);
+        wxRemoveFile(GetManifestFilePath());
+        return false;
+    }
+
+    wxFile delta;
+    if (!delta.Create(deltaFilePath, true)) {
+        pLogger->error("Failed to create file {0}", deltaFilePath.ToStdString());
+        return false;
+    }
+
+    auto pageCount = static_cast<std::uint32_t>(snapshot.Length() / pageSize);
+    bool success = delta.Write(DeltaMagic, sizeof(DeltaMagic)) == sizeof(DeltaMagic) &&
+                   WriteValue(delta, pageSize) && WriteValue(delta, pageCount) &&
+                   WriteString(delta, manifest.mBaseFileName);
+
+    /* the number of changed pages is only known at the end, it is patched in afterwards */
+    wxFileOffset changedPageCountOffset = delta.Tell();
+    std::uint32_t changedPageCount = 0;
+    success = success && WriteValue(delta, changedPageCount);
+
+    std::vector<unsigned char> page(pageSize);
+    for (std::uint32_t index = 0; success && index < pageCount; index++) {
+        if (snapshot.Read(page.data(), pageSize) != static_cast<ssize_t>(pageSize)) {
+            success = false;
+            break;
+        }
+
+        if (index < manifest.mPageHashes.size() && manifest.mPageHashes[index] == HashPage(page.data(), pageSize)) {
+            continue;
+        }
+
+        success = WriteValue(delta, index) && delta.Write(page.data(), pageSize) == pageSize;
+        changedPageCount++;
+    }
+
+    success = success && delta.Seek(changedPageCountOffset) != wxInvalidOffset &&
+              WriteValue(delta, changedPageCount) && delta.Flush();
+    delta.Close();
+
+    if (!success) {
+        pLogger->error("Failed to write differential backup {0}", deltaFilePath.ToStdString());
+        wxRemoveFile(deltaFilePath);
+        return false;
+    }
+
+    pLogger->info("Differential backup {0} holds {1:d} of {2:d} pages",
+        deltaFilePath.ToStdString(),
+        changedPageCount,
+        pageCount);
+    return true;
+}
+
+bool DifferentialBackup::Restore(const wxString& deltaFilePath, const wxString& destinationFilePath)
+{
+    if (!BackupCompression::IsCompressed(deltaFilePath)) {
+        return RestorePages(deltaFilePath, destinationFilePath);
+    }
+
+    auto decompressedDeltaFilePath = wxFileName::CreateTempFileName(wxT("taskable"));
+    if (decompressedDeltaFilePath.empty()) {
+        pLogger->error("Failed to create a temporary file");
+        return false;
+    }
+
+    BackupCompression compression(pLogger);
+    bool success = compression.Decompress(deltaFilePath, decompressedDeltaFilePath) &&
+                   RestorePages(decompressedDeltaFilePath, destinationFilePath);
+    wxRemoveFile(decompressedDeltaFilePath);
+    return success;
+}
+
+/* The full backup a delta was taken against is named in its header, e.g. to rebuild the catalogue */
+bool DifferentialBackup::ReadBaseFileName(const wxString& deltaFilePath, wxString& baseFileName)
+{
+    auto headerFilePath = deltaFilePath;
+    if (BackupCompression::IsCompressed(deltaFilePath)) {
+        headerFilePath = wxFileName::CreateTempFileName(wxT("taskable"));
+        BackupCompression compression(pLogger);
+        if (headerFilePath.empty() || !compression.Decompress(deltaFilePath, headerFilePath)) {
+            pLogger->error("Failed to decompress differential backup {0}", deltaFilePath.ToStdString());
+            if (!headerFilePath.empty()) {
+                wxRemoveFile(headerFilePath);
+            }
+            return false;
+        }
+    }
+
+    wxFile delta;
+    std::uint32_t pageSize = 0;
+    std::uint32_t pageCount = 0;
+    std::uint32_t changedPageCount = 0;
+    bool success = delta.Open(headerFilePath, wxFile::read) &&
+                   ReadDeltaHeader(delta, pageSize, pageCount, baseFileName, changedPageCount);
+    delta.Close();
+
+    if (headerFilePath != deltaFilePath) {
+        wxRemoveFile(headerFilePath);
+    }
+
+    if (!success) {
+        pLogger->error("File {0} is not a differential backup", deltaFilePath.ToStdString());
+    }
+    return success;
+}
+
+bool DifferentialBackup::IsDelta(const wxString& fileName)
+{
+    return BackupCompression::GetDecompressedFileName(fileName).EndsWith(DeltaFileExtension);
+}
+
+bool DifferentialBackup::LoadManifest(PageManifest& manifest)
+{
+    auto manifestFilePath = GetManifestFilePath();
+    if (!wxFileExists(manifestFilePath)) {
+        return false;
+    }
+
+    wxFile file;
+    if (!file.Open(manifestFilePath, wxFile::read)) {
+        pLogger->error("Failed to open file {0}", manifestFilePath.ToStdString());
+        return false;
+    }
+
+    char magic[sizeof(ManifestMagic)];
+    std::uint32_t pageCount = 0;
+    bool success = file.Read(magic, sizeof(magic)) == static_cast<ssize_t>(sizeof(magic)) &&
+                   std::memcmp(magic, ManifestMagic, sizeof(magic)) == 0 &&
+                   ReadValue(file, manifest.mPageSize) && IsValidPageSize(manifest.mPageSize) &&
+                   ReadValue(file, manifest.mCreated) && ReadString(file, manifest.mBaseFileName) &&
+                   ReadValue(file, pageCount);
+
+    if (success) {
+        manifest.mPageHashes.resize(pageCount);
+        size_t hashesSize = manifest.mPageHashes.size() * sizeof(std::uint64_t);
+        success = file.Read(manifest.mPageHashes.data(), hashesSize) == static_cast<ssize_t>(hashesSize);
+    }
+
+    if (!success) {
+        pLogger->warn("Ignoring unreadable page manifest {0}", manifestFilePath.ToStdString());
+    }
+    return success;
+}
+
+bool DifferentialBackup::ReadPageSize(wxFile& file, const wxString& filePath, std::uint32_t& pageSize)
+{
+    unsigned char header[2];
+    if (file.Seek(PageSizeHeaderOffset) == wxInvalidOffset ||
+        file.Read(header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        pLogger->error("Failed to read database header of {0}", filePath.ToStdString());
+        return false;
+    }
+
+    pageSize = (static_cast<std::uint32_t>(header[0]) << 8) | header[1];
+    /* the largest page size does not fit in two bytes and is stored as 1 */
+    if (pageSize == 1) {
+        pageSize = MaximumPageSize;
+    }
+
+    if (!IsValidPageSize(pageSize)) {
+        pLogger->error("File {0} is not a database", filePath.ToStdString());
+        return false;
+    }
+    return file.Seek(0) != wxInvalidOffset;
+}
+
+bool DifferentialBackup::RestorePages(const wxString& deltaFilePath, const wxString& destinationFilePath)
+{
+    wxFile delta;
+    if (!delta.Open(deltaFilePath, wxFile::read)) {
+        pLogger->error("Failed to open file {0}", deltaFilePath.ToStdString());
+        return false;
+    }
+
+    std::uint32_t pageSize = 0;
+    std::uint32_t pageCount = 0;
+    std::uint32_t changedPageCount = 0;
+    wxString baseFileName;
+    bool success = ReadDeltaHeader(delta, pageSize, pageCount, baseFileName, changedPageCount);
+    if (!success) {
+        pLogger->error("File {0} is not a differential backup", deltaFilePath.ToStdString());
+        return false;
+    }
+
+    /* offset of each page held by the delta, the rest come from the full backup */
+    std::vector<wxFileOffset> deltaPageOffsets(pageCount, wxInvalidOffset);
+    for (std::uint32_t i = 0; i < changedPageCount; i++) {
+        std::uint32_t index = 0;
+        if (!ReadValue(delta, index) || index >= pageCount) {
+            pLogger->error("Differential backup {0} is corrupt", deltaFilePath.ToStdString());
+            return false;
+        }
+        deltaPageOffsets[index] = delta.Tell();
+        delta.Seek(pageSize, wxFromCurrent);
+    }
+
+    auto baseFilePath = GetBackupFilePath(baseFileName);
+    if (!wxFileExists(baseFilePath)) {
+        pLogger->error(
+            "Full backup {0} needed by {1} is missing", baseFileName.ToStdString(), deltaFilePath.ToStdString());
+        return false;
+    }
+
+    wxString decompressedBaseFilePath = wxGetEmptyString();
+    if (BackupCompression::IsCompressed(baseFileName)) {
+        decompressedBaseFilePath = wxFileName::CreateTempFileName(wxT("taskable"));
+        BackupCompression compression(pLogger);
+        if (decompressedBaseFilePath.empty() || !compression.Decompress(baseFilePath, decompressedBaseFilePath)) {
+            pLogger->error("Failed to decompress full backup {0}", baseFilePath.ToStdString());
+            if (!decompressedBaseFilePath.empty()) {
+                wxRemoveFile(decompressedBaseFilePath);
+            }
+            return false;
+        }
+        baseFilePath = decompressedBaseFilePath;
+    }
+
+    wxFile base;
+    wxFile destination;
+    success = base.Open(baseFilePath, wxFile::read) && destination.Create(destinationFilePath, true);
+
+    std::vector<unsigned char> page(pageSize);
+    for (std::uint32_t index = 0; success && index < pageCount; index++) {
+        bool isDeltaPage = deltaPageOffsets[index] != wxInvalidOffset;
+        wxFile& source = isDeltaPage ? delta : base;
+        wxFileOffset offset = isDeltaPage ? deltaPageOffsets[index] : static_cast<wxFileOffset>(index) * pageSize;
+
+        success = source.Seek(offset) != wxInvalidOffset &&
+                  source.Read(page.data(), pageSize) == static_cast<ssize_t>(pageSize) &&
+                  destination.Write(page.data(), pageSize) == pageSize;
+    }
+
+    base.Close();
+    destination.Close();
+    if (!decompressedBaseFilePath.empty()) {
+        wxRemoveFile(decompressedBaseFilePath);
+    }
+
+    if (!success) {
+        pLogger->error("Failed to restore {0} from {1} and {2}",
+            destinationFilePath.ToStdString(),
+            baseFileName.ToStdString(),
+            deltaFilePath.ToStdString());
+        wxRemoveFile(destinationFilePath);
+    }
+    return success;
+}
+
+wxString DifferentialBackup::GetManifestFilePath() const
+{
+    wxFileName databaseFileName(common::GetDatabaseFileName());
+    return GetBackupFilePath(databaseFileName.GetName() + ManifestFileExtension);
+}
+
+wxString DifferentialBackup::GetBackupFilePath(const wxString& fileName) const
+{
+    return wxFileName(pConfig->GetBackupPath(), fileName).GetFullPath();
+}
+
+std::uint64_t DifferentialBackup::HashPage(const unsigned char* page, std::uint32_t pageSize)
+{
+    auto crc = crc32(0L, page, pageSize);
+    auto adler = adler32(1L, page, pageSize);
+    return (static_cast<std::uint64_t>(crc) << 32) | static_cast<std::uint64_t>(adler & 0xffffffff);
+}
+} // namespace app::svc
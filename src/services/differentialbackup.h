@@ -0,0 +1,82 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <wx/file.h>
+#include <wx/string.h>
+
+#include "../config/configuration.h"
+
+namespace app::svc
+{
+struct PageManifest {
+    /* file name of the full backup in the backup directory the hashes were taken from */
+    wxString mBaseFileName;
+    /* when the full backup was taken, seconds since the epoch */
+    std::int64_t mCreated;
+    std::uint32_t mPageSize;
+    /* crc32 and adler32 of every database page, in page order */
+    std::vector<std::uint64_t> mPageHashes;
+};
+
+/*
+ Differential backups against the last full backup. A full backup leaves a manifest of page hashes
+ in the backup directory; later backups only write the pages whose hash differs into a .delta file.
+ Restoring a delta merges its pages over the full backup it names, so a full backup plus any one of
+ the deltas taken after it gives the database as it was on the day of that delta
+ */
+class DifferentialBackup final
+{
+public:
+    DifferentialBackup() = delete;
+    DifferentialBackup(std::shared_ptr<cfg::Configuration> config, std::shared_ptr<spdlog::logger> logger);
+    ~DifferentialBackup() = default;
+
+    bool IsFullBackupDue();
+    wxString GetBaseFileName();
+
+    bool HashPages(const wxString& databaseFilePath, PageManifest& manifest);
+    bool SaveManifest(const PageManifest& manifest);
+
+    bool WriteDelta(const wxString& snapshotFilePath, const wxString& deltaFilePath);
+    bool Restore(const wxString& deltaFilePath, const wxString& destinationFilePath);
+    bool ReadBaseFileName(const wxString& deltaFilePath, wxString& baseFileName);
+
+    static bool IsDelta(const wxString& fileName);
+
+private:
+    bool LoadManifest(PageManifest& manifest);
+    bool ReadPageSize(wxFile& file, const wxString& filePath, std::uint32_t& pageSize);
+    bool RestorePages(const wxString& deltaFilePath, const wxString& destinationFilePath);
+
+    wxString GetManifestFilePath() const;
+    wxString GetBackupFilePath(const wxString& fileName) const;
+
+    static std::uint64_t HashPage(const unsigned char* page, std::uint32_t pageSize);
+
+    std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
+};
+} // namespace app::svc
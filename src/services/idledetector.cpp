@@ -0,0 +1,170 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "idledetector.h"
+
+#include <vector>
+
+#ifdef __WXMSW__
+#include <wx/msw/wrapwin.h>
+#endif // __WXMSW__
+
+namespace app::services
+{
+static const auto SampleInterval = std::chrono::seconds(10);
+static const auto SampleLeeway = std::chrono::seconds(5);
+
+std::chrono::milliseconds SystemIdleTimeProvider::GetIdleTime()
+{
+#ifdef __WXMSW__
+    LASTINPUTINFO lastInputInfo;
+    lastInputInfo.cbSize = sizeof(LASTINPUTINFO);
+    if (!::GetLastInputInfo(&lastInputInfo)) {
+        return std::chrono::milliseconds(0);
+    }
+
+    /* both tick counts wrap around after ~49 days, the unsigned subtraction still gives the difference */
+    return std::chrono::milliseconds(::GetTickCount() - lastInputInfo.dwTime);
+#else
+    /* headless builds have no input to watch, the user is never idle */
+    return std::chrono::milliseconds(0);
+#endif // __WXMSW__
+}
+
+std::chrono::milliseconds FakeIdleTimeProvider::GetIdleTime()
+{
+    return mIdleTime;
+}
+
+void FakeIdleTimeProvider::SetIdleTime(std::chrono::milliseconds idleTime)
+{
+    mIdleTime = idleTime;
+}
+
+IdleDetector::IdleDetector(std::unique_ptr<IdleTimeProvider> provider,
+    std::shared_ptr<TickScheduler> scheduler,
+    std::shared_ptr<cfg::Configuration> config)
+    : pProvider(std::move(provider))
+    , pScheduler(scheduler)
+    , pConfig(config)
+    , mSubscriptions()
+    , mNextSubscriptionId(1)
+    , mSampleTaskId(-1)
+    , mThreshold(GetThreshold(*config->GetSettings()))
+    , mIdleDetectionSubscriptionId(-1)
+    , mIdleThresholdSubscriptionId(-1)
+    , bIdle(false)
+    , mLastIdleTime(0)
+    , mLastActivity()
+{
+    auto onChange = [this](const cfg::Settings& settings) { mThreshold = GetThreshold(settings); };
+    mIdleDetectionSubscriptionId = pConfig->Subscribe(cfg::Setting::IdleDetection, onChange);
+    mIdleThresholdSubscriptionId = pConfig->Subscribe(cfg::Setting::IdleThreshold, onChange);
+}
+
+IdleDetector::~IdleDetector()
+{
+    pConfig->Unsubscribe(mIdleDetectionSubscriptionId);
+    pConfig->Unsubscribe(mIdleThresholdSubscriptionId);
+    pScheduler->Cancel(mSampleTaskId);
+}
+
+int IdleDetector::Subscribe(Listener onIdle, Listener onActive)
+{
+    int subscriptionId = mNextSubscriptionId++;
+    mSubscriptions[subscriptionId] = Subscription{ std::move(onIdle), std::move(onActive) };
+
+    if (!pScheduler->IsScheduled(mSampleTaskId)) {
+        mSampleTaskId = pScheduler->Schedule(SampleInterval, [this]() { Sample(); }, SampleLeeway);
+    }
+
+    return subscriptionId;
+}
+
+void IdleDetector::Unsubscribe(int subscriptionId)
+{
+    mSubscriptions.erase(subscriptionId);
+
+    /* nobody to tell, so stop waking up to sample */
+    if (mSubscriptions.empty()) {
+        pScheduler->Cancel(mSampleTaskId);
+        bIdle = false;
+    }
+}
+
+void IdleDetector::Sample()
+{
+    auto threshold = mThreshold;
+    if (threshold.count() <= 0) {
+        bIdle = false;
+        return;
+    }
+
+    auto idleTime = pProvider->GetIdleTime();
+
+    if (!bIdle && idleTime >= threshold) {
+        bIdle = true;
+        mLastActivity = Clock::now() - idleTime;
+        Notify(true);
+    } else if (bIdle && idleTime < mLastIdleTime) {
+        /* the idle time went back down, so there has been input since the last sample */
+        bIdle = false;
+        Notify(false);
+    }
+
+    mLastIdleTime = idleTime;
+}
+
+bool IdleDetector::IsIdle() const
+{
+    return bIdle;
+}
+
+std::chrono::milliseconds IdleDetector::GetThreshold(const cfg::Settings& settings)
+{
+    if (!settings.bIdleDetection) {
+        return std::chrono::milliseconds(0);
+    }
+
+    int threshold = settings.mIdleThreshold;
+    if (threshold < 1) {
+        return std::chrono::milliseconds(0);
+    }
+
+    return std::chrono::minutes(threshold);
+}
+
+void IdleDetector::Notify(bool idle)
+{
+    /* a listener may unsubscribe itself, so walk a copy */
+    std::vector<Subscription> subscriptions;
+    subscriptions.reserve(mSubscriptions.size());
+    for (const auto& [subscriptionId, subscription] : mSubscriptions) {
+        subscriptions.push_back(subscription);
+    }
+
+    for (const auto& subscription : subscriptions) {
+        if (idle) {
+            subscription.mOnIdle(mLastActivity);
+        } else {
+            subscription.mOnActive(mLastActivity);
+        }
+    }
+}
+} // namespace app::services
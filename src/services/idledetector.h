@@ -0,0 +1,114 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+
+#include "../config/configuration.h"
+#include "tickscheduler.h"
+
+namespace app::services
+{
+/* Source of the time since the last keyboard or mouse input */
+class IdleTimeProvider
+{
+public:
+    virtual ~IdleTimeProvider() = default;
+
+    virtual std::chrono::milliseconds GetIdleTime() = 0;
+};
+
+/* Reads the time since the last input event of the session (GetLastInputInfo) */
+class SystemIdleTimeProvider final : public IdleTimeProvider
+{
+public:
+    SystemIdleTimeProvider() = default;
+    virtual ~SystemIdleTimeProvider() = default;
+
+    std::chrono::milliseconds GetIdleTime() override;
+};
+
+/* Returns whatever idle time it was last given, for exercising the detector without real input */
+class FakeIdleTimeProvider final : public IdleTimeProvider
+{
+public:
+    FakeIdleTimeProvider() = default;
+    virtual ~FakeIdleTimeProvider() = default;
+
+    std::chrono::milliseconds GetIdleTime() override;
+    void SetIdleTime(std::chrono::milliseconds idleTime);
+
+private:
+    std::chrono::milliseconds mIdleTime{ 0 };
+};
+
+/*
+ Samples the idle time while anybody is listening. Once it passes the configured threshold the idle
+ listeners are told when the user was last active; the first sample that shows new input afterwards
+ tells the active listeners, again with the last activity time so they can work out the gap
+ */
+class IdleDetector final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Listener = std::function<void(Clock::time_point lastActivity)>;
+
+    IdleDetector() = delete;
+    IdleDetector(std::unique_ptr<IdleTimeProvider> provider,
+        std::shared_ptr<TickScheduler> scheduler,
+        std::shared_ptr<cfg::Configuration> config);
+    ~IdleDetector();
+
+    int Subscribe(Listener onIdle, Listener onActive);
+    void Unsubscribe(int subscriptionId);
+
+    void Sample();
+    bool IsIdle() const;
+
+private:
+    struct Subscription {
+        Listener mOnIdle;
+        Listener mOnActive;
+    };
+
+    static std::chrono::milliseconds GetThreshold(const cfg::Settings& settings);
+    void Notify(bool idle);
+
+    std::unique_ptr<IdleTimeProvider> pProvider;
+    std::shared_ptr<TickScheduler> pScheduler;
+    std::shared_ptr<cfg::Configuration> pConfig;
+
+    std::map<int, Subscription> mSubscriptions;
+    int mNextSubscriptionId;
+    int mSampleTaskId;
+
+    /* kept up to date by the configuration subscriptions instead of being read on every sample */
+    std::chrono::milliseconds mThreshold;
+    int mIdleDetectionSubscriptionId;
+    int mIdleThresholdSubscriptionId;
+
+    bool bIdle;
+    std::chrono::milliseconds mLastIdleTime;
+    Clock::time_point mLastActivity;
+};
+} // namespace app::services
@@ -0,0 +1,166 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "searchindex.h"
+
+#include "../common/constants.h"
+
+namespace app::svc
+{
+SearchIndex::SearchIndex(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+{
+}
+
+bool SearchIndex::Initialize()
+{
+    auto connection = db::ConnectionProvider::Get().Handle()->Acquire();
+    bool success = true;
+
+    try {
+        if (!Exists(connection)) {
+            auto database = connection->DatabaseExecutableHandle();
+            *database << "BEGIN TRANSACTION";
+            try {
+                for (const auto& statement : SearchIndex::createSearchIndex) {
+                    *database << statement;
+                }
+                *database << SearchIndex::rebuildSearchIndex;
+                connection->RaiseSchemaVersion(static_cast<int>(constants::SchemaVersion::SearchIndex));
+                *database << "COMMIT";
+            } catch (const sqlite::sqlite_exception&) {
+                *database << "ROLLBACK";
+                throw;
+            }
+            pLogger->info("Created search index over task items");
+        } else {
+            /* the index may predate the schema version */
+            connection->RaiseSchemaVersion(static_cast<int>(constants::SchemaVersion::SearchIndex));
+        }
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when creating search index - {0:d} : {1}", e.get_code(), e.what());
+        success = false;
+    }
+
+    db::ConnectionProvider::Get().Handle()->Release(connection);
+    return success;
+}
+
+bool SearchIndex::Rebuild()
+{
+    auto connection = db::ConnectionProvider::Get().Handle()->Acquire();
+    bool success = true;
+
+    try {
+        *connection->DatabaseExecutableHandle() << SearchIndex::rebuildSearchIndex;
+    } catch (const sqlite::sqlite_exception& e) {
+        pLogger->error("Error occured when rebuilding search index - {0:d} : {1}", e.get_code(), e.what());
+        success = false;
+    }
+
+    db::ConnectionProvider::Get().Handle()->Release(connection);
+    return success;
+}
+
+bool SearchIndex::Exists(std::shared_ptr<db::SqliteConnection> connection)
+{
+    int count = 0;
+    *connection->DatabaseExecutableHandle() << SearchIndex::searchIndexExists >> count;
+    return count > 0;
+}
+
+/* databases created before the index need it as well, so the schema lives here rather than in
+   create-taskable.sql */
+const std::vector<std::string> SearchIndex::createSearchIndex = {
+    "CREATE VIEW task_items_search_content AS "
+    "SELECT task_items.task_item_id AS task_item_id, "
+    "task_items.description AS description, "
+    "projects.display_name AS project, "
+    "categories.name AS category "
+    "FROM task_items "
+    "INNER JOIN projects ON task_items.project_id = projects.project_id "
+    "INNER JOIN categories ON task_items.category_id = categories.category_id",
+
+    "CREATE VIRTUAL TABLE task_items_search USING fts5("
+    "description, project, category, "
+    "content='task_items_search_content', content_rowid='task_item_id', "
+    "tokenize='unicode61 remove_diacritics 2', prefix='2 3')",
+
+    "CREATE TRIGGER task_items_search_insert AFTER INSERT ON task_items BEGIN "
+    "INSERT INTO task_items_search(rowid, description, project, category) "
+    "SELECT new.task_item_id, new.description, projects.display_name, categories.name "
+    "FROM projects, categories "
+    "WHERE projects.project_id = new.project_id AND categories.category_id = new.category_id; "
+    "END",
+
+    "CREATE TRIGGER task_items_search_delete AFTER DELETE ON task_items BEGIN "
+    "INSERT INTO task_items_search(task_items_search, rowid, description, project, category) "
+    "SELECT 'delete', old.task_item_id, old.description, projects.display_name, categories.name "
+    "FROM projects, categories "
+    "WHERE projects.project_id = old.project_id AND categories.category_id = old.category_id; "
+    "END",
+
+    "CREATE TRIGGER task_items_search_update AFTER UPDATE OF description, project_id, category_id ON task_items "
+    "BEGIN "
+    "INSERT INTO task_items_search(task_items_search, rowid, description, project, category) "
+    "SELECT 'delete', old.task_item_id, old.description, projects.display_name, categories.name "
+    "FROM projects, categories "
+    "WHERE projects.project_id = old.project_id AND categories.category_id = old.category_id; "
+    "INSERT INTO task_items_search(rowid, description, project, category) "
+    "SELECT new.task_item_id, new.description, projects.display_name, categories.name "
+    "FROM projects, categories "
+    "WHERE projects.project_id = new.project_id AND categories.category_id = new.category_id; "
+    "END",
+
+    "CREATE TRIGGER task_items_search_project_update AFTER UPDATE OF display_name ON projects "
+    "WHEN old.display_name <> new.display_name BEGIN "
+    "INSERT INTO task_items_search(task_items_search, rowid, description, project, category) "
+    "SELECT 'delete', task_items.task_item_id, task_items.description, old.display_name, categories.name "
+    "FROM task_items "
+    "INNER JOIN categories ON task_items.category_id = categories.category_id "
+    "WHERE task_items.project_id = old.project_id; "
+    "INSERT INTO task_items_search(rowid, description, project, category) "
+    "SELECT task_items.task_item_id, task_items.description, new.display_name, categories.name "
+    "FROM task_items "
+    "INNER JOIN categories ON task_items.category_id = categories.category_id "
+    "WHERE task_items.project_id = new.project_id; "
+    "END",
+
+    "CREATE TRIGGER task_items_search_category_update AFTER UPDATE OF name ON categories "
+    "WHEN old.name <> new.name BEGIN "
+    "INSERT INTO task_items_search(task_items_search, rowid, description, project, category) "
+    "SELECT 'delete', task_items.task_item_id, task_items.description, projects.display_name, old.name "
+    "FROM task_items "
+    "INNER JOIN projects ON task_items.project_id = projects.project_id "
+    "WHERE task_items.category_id = old.category_id; "
+    "INSERT INTO task_items_search(rowid, description, project, category) "
+    "SELECT task_items.task_item_id, task_items.description, projects.display_name, new.name "
+    "FROM task_items "
+    "INNER JOIN projects ON task_items.project_id = projects.project_id "
+    "WHERE task_items.category_id = new.category_id; "
+    "END"
+};
+
+const std::string SearchIndex::rebuildSearchIndex = "INSERT INTO task_items_search(task_items_search) "
+                                                    "VALUES('rebuild')";
+
+const std::string SearchIndex::searchIndexExists = "SELECT COUNT(*) "
+                                                   "FROM sqlite_master "
+                                                   "WHERE type = 'table' AND name = 'task_items_search'";
+} // namespace app::svc
@@ -0,0 +1,60 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+#include <sqlite_modern_cpp.h>
+
+#include "../database/connectionprovider.h"
+#include "../database/sqliteconnection.h"
+
+namespace app::svc
+{
+/*
+ FTS5 full-text index over task item descriptions, project display names and category names.
+ The index is external-content over the task_items_search_content view, so the text is not stored twice,
+ and triggers on task_items, projects and categories keep it in sync with every write.
+ Initialize() creates the index on databases that predate it and fills it once, see TaskItemSearchData
+ for querying it
+ */
+class SearchIndex final
+{
+public:
+    SearchIndex() = delete;
+    SearchIndex(std::shared_ptr<spdlog::logger> logger);
+    ~SearchIndex() = default;
+
+    bool Initialize();
+    bool Rebuild();
+
+private:
+    bool Exists(std::shared_ptr<db::SqliteConnection> connection);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    static const std::vector<std::string> createSearchIndex;
+    static const std::string rebuildSearchIndex;
+    static const std::string searchIndexExists;
+};
+} // namespace app::svc
@@ -19,16 +19,29 @@
 
 #include "setupdatabase.h"
 
-#include <wx/textfile.h>
+#include <wx/ffile.h>
+#include <wx/filename.h>
 #include <wx/stdpaths.h>
 
-#include "../common/util.h"
+#include "../database/connectionprovider.h"
+
+#ifdef TASKABLE_EMBED_SETUP_SCRIPTS
+#include "setupscripts.h"
+#endif // TASKABLE_EMBED_SETUP_SCRIPTS
 
 namespace app::svc
 {
 const wxString SetupTables::CreateDatabaseFile = wxT("create-taskable.sql");
 const wxString SetupTables::SeedDatabaseFile = wxT("seed-taskable.sql");
 
+#ifdef TASKABLE_EMBED_SETUP_SCRIPTS
+static const unsigned char* EmbeddedCreateScript = scripts::CreateTaskable;
+static const unsigned char* EmbeddedSeedScript = scripts::SeedTaskable;
+#else
+static const unsigned char* EmbeddedCreateScript = nullptr;
+static const unsigned char* EmbeddedSeedScript = nullptr;
+#endif // TASKABLE_EMBED_SETUP_SCRIPTS
+
 SetupTables::SetupTables(std::shared_ptr<spdlog::logger> logger)
     : pLogger(logger)
 {
@@ -36,74 +49,75 @@ SetupTables::SetupTables(std::shared_ptr<spdlog::logger> logger)
 
 bool SetupTables::CreateTables()
 {
-    return Create() && Seed();
-}
-
-std::vector<std::string> SetupTables::ReadFile(wxString fileToRead)
-{
-    auto scriptPath =
-        wxString::Format(wxT("%s\\%s"), wxPathOnly(wxStandardPaths::Get().GetExecutablePath()), fileToRead);
-    wxTextFile file;
-    if (!file.Open(scriptPath)) {
-        pLogger->error("Error occured: Unable to open file: {0}", scriptPath.ToStdString());
-        return std::vector<std::string>();
-    }
-
-    wxString fileData;
-    fileData = file.GetFirstLine();
-    while (!file.Eof()) {
-        fileData += file.GetNextLine();
+    std::string createScript;
+    std::string seedScript;
+    if (!ReadScript(CreateDatabaseFile, EmbeddedCreateScript, createScript) ||
+        !ReadScript(SeedDatabaseFile, EmbeddedSeedScript, seedScript)) {
+        return false;
     }
 
-    /* Since some currencies symbols are UTF8 specific characters
-       we cannot use ToStdString() as that (tries) to convert to regular
-       ASCII and the conversion results in an error.
-       The solution is to first convert to UTF8 explicitly and then
-       initialize a std::string from that. This way std::string will handle
-       the symbol character encodings correctly
-    */
-    /* TODO: Internationalization of Taskable might require using this approach everywhere */
-    // Note that in the debugger, the encodings do not look correct
-    auto fileDataString = fileData.ToUTF8();
-    return util::lib::split(std::string(fileDataString), ';');
+    return ExecuteScripts({ createScript, seedScript });
 }
 
-bool SetupTables::ExecuteDatabaseAction(std::vector<std::string> sqlTokens)
+bool SetupTables::ReadScript(const wxString& fileName, const unsigned char* embeddedScript, std::string& script)
 {
-    auto connectionHandle = db::ConnectionProvider::Get().Handle()->Acquire();
+    if (embeddedScript) {
+        script = reinterpret_cast<const char*>(embeddedScript);
+        return true;
+    }
 
-    try {
-        auto databaseHandle = connectionHandle->DatabaseExecutableHandle();
-        for (const auto& token : sqlTokens) {
-            *databaseHandle << token;
-        }
+    auto scriptPath = wxFileName(wxPathOnly(wxStandardPaths::Get().GetExecutablePath()), fileName).GetFullPath();
+    wxFFile file(scriptPath, wxT("rb"));
+    if (!file.IsOpened()) {
+        pLogger->error("Error occured: Unable to open file: {0}", scriptPath.ToStdString());
+        return false;
+    }
 
-    } catch (const sqlite::sqlite_exception& e) {
-        pLogger->error("Error occured: Database Create Table Procedure - {0:d} : {1}", e.get_code(), e.what());
+    /* the seed script has currency symbols outside of ASCII, so the script is kept as the UTF-8 it is stored in */
+    wxString content;
+    if (!file.ReadAll(&content, wxConvUTF8)) {
+        pLogger->error("Error occured: Unable to read file: {0}", scriptPath.ToStdString());
         return false;
     }
 
-    db::ConnectionProvider::Get().Handle()->Release(connectionHandle);
+    script = std::string(content.ToUTF8());
     return true;
 }
 
-bool SetupTables::Create()
+bool SetupTables::ExecuteScripts(const std::vector<std::string>& scripts)
 {
-    auto sqlTokens = ReadFile(SetupTables::CreateDatabaseFile);
-    if (sqlTokens.empty()) {
-        return false;
+    auto connectionHandle = db::ConnectionProvider::Get().Handle()->Acquire();
+    auto database = connectionHandle->DatabaseExecutableHandle()->connection();
+
+    /* sqlite3_exec runs every statement of a script, semicolons inside string literals included.
+       The transaction is deferred, an immediate one would write the database header before the
+       PRAGMA auto_vacuum at the top of the create script gets to change it */
+    bool success = Execute(database.get(), "BEGIN;");
+    for (const auto& script : scripts) {
+        success = success && Execute(database.get(), script.c_str());
+    }
+    success = success && Execute(database.get(), "COMMIT;");
+
+    if (!success && !sqlite3_get_autocommit(database.get())) {
+        Execute(database.get(), "ROLLBACK;");
     }
 
-    return ExecuteDatabaseAction(sqlTokens);
+    db::ConnectionProvider::Get().Handle()->Release(connectionHandle);
+    return success;
 }
 
-bool SetupTables::Seed()
+bool SetupTables::Execute(sqlite3* database, const char* sql)
 {
-    auto sqlTokens = ReadFile(SetupTables::SeedDatabaseFile);
-    if (sqlTokens.empty()) {
+    char* errorMessage = nullptr;
+    int rc = sqlite3_exec(database, sql, nullptr, nullptr, &errorMessage);
+    if (rc != SQLITE_OK) {
+        pLogger->error("Error occured: Database Create Table Procedure - {0:d} : {1}",
+            rc,
+            errorMessage ? errorMessage : sqlite3_errstr(rc));
+        sqlite3_free(errorMessage);
         return false;
     }
 
-    return ExecuteDatabaseAction(sqlTokens);
+    return true;
 }
 } // namespace app::svc
@@ -32,6 +32,11 @@
 
 namespace app::svc
 {
+/*
+ Creates and seeds the tables of a new database. Both scripts run in a single transaction, so a failure
+ anywhere leaves the database as empty as it was. The scripts are compiled in when the application is built
+ with TASKABLE_EMBED_SETUP_SCRIPTS, otherwise they are read from next to the executable
+ */
 class SetupTables final
 {
 public:
@@ -43,11 +48,9 @@ class SetupTables final
 private:
     std::shared_ptr<spdlog::logger> pLogger;
 
-    std::vector<std::string> ReadFile(wxString fileToRead);
-    bool ExecuteDatabaseAction(std::vector<std::string> sqlTokens);
-
-    bool Create();
-    bool Seed();
+    bool ReadScript(const wxString& fileName, const unsigned char* embeddedScript, std::string& script);
+    bool ExecuteScripts(const std::vector<std::string>& scripts);
+    bool Execute(sqlite3* database, const char* sql);
 
     static const wxString CreateDatabaseFile;
     static const wxString SeedDatabaseFile;
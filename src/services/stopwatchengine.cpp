@@ -0,0 +1,308 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "stopwatchengine.h"
+
+#include <algorithm>
+
+namespace app::services
+{
+StopwatchEngine::StopwatchEngine(std::shared_ptr<TaskStateService> taskState,
+    std::unique_ptr<StopwatchJournal> journal)
+    : pTaskState(taskState)
+    , pJournal(std::move(journal))
+    , mStartedAt()
+    , mStartTime(wxDefaultDateTime)
+    , mLastRecordTime(wxDefaultDateTime)
+    , bRunning(false)
+    , bJournalIntact(true)
+{
+}
+
+/*
+ Rebuilds the stopwatch state from the journal. An interval that was still running when the journal
+ was last written keeps running from its recorded wall clock start time, that includes the time the
+ program was not running, so the owner asks the user whether to keep it (see PauseAtLastRecord)
+ */
+bool StopwatchEngine::Replay()
+{
+    if (!pJournal) {
+        return false;
+    }
+
+    for (const auto& entry : pJournal->Read()) {
+        mLastRecordTime = FromTimestamp(entry.mTimestamp);
+
+        switch (entry.mEvent) {
+        case StopwatchEvent::Start:
+            mStartTime = FromTimestamp(entry.mTimestamp);
+            bRunning = true;
+            break;
+        case StopwatchEvent::Pause:
+        case StopwatchEvent::Stop:
+            if (bRunning && entry.mDuration > 0) {
+                pTaskState->PushTimes(mStartTime, mStartTime + wxTimeSpan::Milliseconds(entry.mDuration));
+            }
+            bRunning = false;
+            break;
+        case StopwatchEvent::Reset:
+            pTaskState->ClearTimes();
+            pTaskState->StoreDescription(wxGetEmptyString());
+            bRunning = false;
+            break;
+        case StopwatchEvent::Describe:
+            pTaskState->StoreDescription(entry.mDescription);
+            break;
+        case StopwatchEvent::Checkpoint:
+            /* only moves the last record time forward */
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (bRunning) {
+        auto elapsed = std::max<std::int64_t>(0, ToTimestamp(wxDateTime::UNow()) - ToTimestamp(mStartTime));
+        mStartedAt = Clock::now() - std::chrono::milliseconds(elapsed);
+    }
+
+    return HasPendingTask();
+}
+
+void StopwatchEngine::Start()
+{
+    StartFrom(Clock::now());
+}
+
+/* Opens an interval that started at the given (past) point in time, e.g. to keep time spent away */
+void StopwatchEngine::StartFrom(Clock::time_point startedAt)
+{
+    if (bRunning) {
+        return;
+    }
+
+    auto now = Clock::now();
+    startedAt = std::min(startedAt, now);
+    auto sinceStart = std::chrono::duration_cast<std::chrono::milliseconds>(now - startedAt).count();
+    auto startTime = wxDateTime::UNow() - wxTimeSpan::Milliseconds(sinceStart);
+
+    Record(StopwatchEvent::Start, startTime, 0);
+
+    mStartTime = startTime;
+    mStartedAt = startedAt;
+    bRunning = true;
+}
+
+void StopwatchEngine::Pause()
+{
+    PauseAt(Clock::now());
+}
+
+/* Closes the running interval at the given point in time, e.g. the last user activity before going idle */
+void StopwatchEngine::PauseAt(Clock::time_point endedAt)
+{
+    if (!bRunning) {
+        return;
+    }
+
+    CloseInterval(StopwatchEvent::Pause, endedAt);
+}
+
+/*
+ Closes an interval restored from the journal at the last event that was recorded for it (usually a
+ checkpoint), which drops the time between the program going away and it being restored
+ */
+void StopwatchEngine::PauseAtLastRecord()
+{
+    if (!bRunning) {
+        return;
+    }
+
+    auto duration = std::max<std::int64_t>(0, ToTimestamp(mLastRecordTime) - ToTimestamp(mStartTime));
+    auto now = Clock::now();
+    mStartedAt = now - std::chrono::milliseconds(duration);
+
+    CloseInterval(StopwatchEvent::Pause, now);
+}
+
+/* Journals that the running interval is still running, so a crash loses at most the time since */
+void StopwatchEngine::Checkpoint()
+{
+    if (!bRunning) {
+        return;
+    }
+
+    Record(StopwatchEvent::Checkpoint, wxDateTime::UNow(), GetElapsedMilliseconds());
+}
+
+void StopwatchEngine::Stop()
+{
+    if (!bRunning) {
+        return;
+    }
+
+    CloseInterval(StopwatchEvent::Stop, Clock::now());
+}
+
+void StopwatchEngine::Reset()
+{
+    pTaskState->ClearTimes();
+    pTaskState->StoreDescription(wxGetEmptyString());
+    mStartTime = wxDefaultDateTime;
+    mLastRecordTime = wxDefaultDateTime;
+    bRunning = false;
+
+    if (pJournal) {
+        bJournalIntact = pJournal->Truncate();
+    }
+}
+
+void StopwatchEngine::SetDescription(const wxString& description)
+{
+    if (description == pTaskState->GetStoredDescription()) {
+        return;
+    }
+
+    Record(StopwatchEvent::Describe, wxDateTime::UNow(), 0, description);
+    pTaskState->StoreDescription(description);
+}
+
+bool StopwatchEngine::IsRunning() const
+{
+    return bRunning;
+}
+
+bool StopwatchEngine::HasPendingTask() const
+{
+    return bRunning || pTaskState->GetIntervalCount() > 0;
+}
+
+std::size_t StopwatchEngine::GetIntervalCount() const
+{
+    return pTaskState->GetIntervalCount();
+}
+
+const std::vector<std::tuple<wxDateTime, wxDateTime>>& StopwatchEngine::GetIntervals() const
+{
+    return pTaskState->GetTimes();
+}
+
+bool StopwatchEngine::IsJournalIntact() const
+{
+    return bJournalIntact;
+}
+
+wxTimeSpan StopwatchEngine::GetElapsedTime() const
+{
+    if (!bRunning) {
+        return wxTimeSpan();
+    }
+
+    return wxTimeSpan::Milliseconds(GetElapsedMilliseconds());
+}
+
+wxTimeSpan StopwatchEngine::GetAccumulatedTime() const
+{
+    return pTaskState->GetAccumulatedTime();
+}
+
+wxDateTime StopwatchEngine::GetStartTime() const
+{
+    const auto& times = pTaskState->GetTimes();
+    if (times.empty()) {
+        return mStartTime;
+    }
+
+    return std::get<0>(times.front());
+}
+
+wxDateTime StopwatchEngine::GetEndTime() const
+{
+    const auto& times = pTaskState->GetTimes();
+    if (times.empty()) {
+        return wxDefaultDateTime;
+    }
+
+    return std::get<1>(times.back());
+}
+
+wxDateTime StopwatchEngine::GetLastRecordTime() const
+{
+    return mLastRecordTime;
+}
+
+wxString StopwatchEngine::GetDescription() const
+{
+    return pTaskState->GetStoredDescription();
+}
+
+std::shared_ptr<TaskStateService> StopwatchEngine::GetTaskState() const
+{
+    return pTaskState;
+}
+
+/* the state change is still applied when the write fails, losing tracked time is worse than losing the journal */
+void StopwatchEngine::Record(StopwatchEvent event,
+    const wxDateTime& timestamp,
+    std::int64_t duration,
+    const wxString& description)
+{
+    mLastRecordTime = timestamp;
+
+    if (!pJournal) {
+        return;
+    }
+
+    StopwatchJournalEntry entry{ event, ToTimestamp(timestamp), duration, description };
+    if (!pJournal->Append(entry)) {
+        bJournalIntact = false;
+    }
+}
+
+void StopwatchEngine::CloseInterval(StopwatchEvent event, Clock::time_point endedAt)
+{
+    auto duration = std::clamp<std::int64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(endedAt - mStartedAt).count(),
+        0,
+        GetElapsedMilliseconds());
+
+    Record(event, wxDateTime::UNow(), duration);
+
+    /* an empty interval has no time to save */
+    if (duration > 0) {
+        pTaskState->PushTimes(mStartTime, mStartTime + wxTimeSpan::Milliseconds(duration));
+    }
+    bRunning = false;
+}
+
+std::int64_t StopwatchEngine::GetElapsedMilliseconds() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - mStartedAt).count();
+}
+
+std::int64_t StopwatchEngine::ToTimestamp(const wxDateTime& dateTime)
+{
+    return dateTime.GetValue().GetValue();
+}
+
+wxDateTime StopwatchEngine::FromTimestamp(std::int64_t timestamp)
+{
+    return wxDateTime(wxLongLong(timestamp));
+}
+} // namespace app::services
@@ -0,0 +1,99 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include <wx/datetime.h>
+#include <wx/string.h>
+
+#include "stopwatchjournal.h"
+#include "taskstateservice.h"
+
+namespace app::services
+{
+/*
+ Headless stopwatch state machine. Interval lengths are measured with std::chrono::steady_clock so
+ wall clock changes do not skew durations, the wall clock is only used to label interval start and
+ end times. Every state change is appended to the journal (when one is given) before it is applied,
+ along with periodic checkpoints of a running interval. A failed write is remembered so the owner can
+ warn that the task will not survive a crash
+ */
+class StopwatchEngine final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    StopwatchEngine() = delete;
+    StopwatchEngine(std::shared_ptr<TaskStateService> taskState, std::unique_ptr<StopwatchJournal> journal);
+    ~StopwatchEngine() = default;
+
+    bool Replay();
+
+    void Start();
+    void StartFrom(Clock::time_point startedAt);
+    void Pause();
+    void PauseAt(Clock::time_point endedAt);
+    void PauseAtLastRecord();
+    void Checkpoint();
+    void Stop();
+    void Reset();
+    void SetDescription(const wxString& description);
+
+    bool IsRunning() const;
+    bool HasPendingTask() const;
+    std::size_t GetIntervalCount() const;
+    const std::vector<std::tuple<wxDateTime, wxDateTime>>& GetIntervals() const;
+    bool IsJournalIntact() const;
+
+    wxTimeSpan GetElapsedTime() const;
+    wxTimeSpan GetAccumulatedTime() const;
+    wxDateTime GetStartTime() const;
+    wxDateTime GetEndTime() const;
+    wxDateTime GetLastRecordTime() const;
+    wxString GetDescription() const;
+
+    std::shared_ptr<TaskStateService> GetTaskState() const;
+
+private:
+    void Record(StopwatchEvent event,
+        const wxDateTime& timestamp,
+        std::int64_t duration,
+        const wxString& description = wxGetEmptyString());
+    void CloseInterval(StopwatchEvent event, Clock::time_point endedAt);
+    std::int64_t GetElapsedMilliseconds() const;
+
+    static std::int64_t ToTimestamp(const wxDateTime& dateTime);
+    static wxDateTime FromTimestamp(std::int64_t timestamp);
+
+    std::shared_ptr<TaskStateService> pTaskState;
+    std::unique_ptr<StopwatchJournal> pJournal;
+
+    Clock::time_point mStartedAt;
+    wxDateTime mStartTime;
+    wxDateTime mLastRecordTime;
+    bool bRunning;
+    bool bJournalIntact;
+};
+} // namespace app::services
@@ -0,0 +1,176 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "stopwatchjournal.h"
+
+#include <wx/ffile.h>
+#include <wx/tokenzr.h>
+
+#ifdef __WXMSW__
+#include <io.h>
+#endif
+
+namespace app::services
+{
+StopwatchJournal::StopwatchJournal(const wxString& journalFilePath, std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+    , mJournalFilePath(journalFilePath)
+    , mFile()
+{
+}
+
+StopwatchJournal::~StopwatchJournal()
+{
+    if (mFile.IsOpened()) {
+        mFile.Close();
+    }
+}
+
+bool StopwatchJournal::Append(const StopwatchJournalEntry& entry)
+{
+    if (!mFile.IsOpened()) {
+        if (!mFile.Open(mJournalFilePath, wxFile::write_append)) {
+            pLogger->error("Unable to open stopwatch journal {0}", mJournalFilePath.ToStdString());
+            return false;
+        }
+    }
+
+    auto line = wxString::Format(wxT("%d;%lld;%lld;%s\n"),
+        static_cast<int>(entry.mEvent),
+        static_cast<long long>(entry.mTimestamp),
+        static_cast<long long>(entry.mDuration),
+        Escape(entry.mDescription));
+
+    if (!mFile.Write(line, wxConvUTF8) || !mFile.Flush()) {
+        pLogger->error("Unable to write to stopwatch journal {0}", mJournalFilePath.ToStdString());
+        return false;
+    }
+
+#ifdef __WXMSW__
+    /* wxFile::Flush only calls fsync where it is available, the MSVC runtime needs _commit to reach the disk */
+    if (_commit(mFile.fd()) != 0) {
+        pLogger->error("Unable to commit stopwatch journal {0} to disk", mJournalFilePath.ToStdString());
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+std::vector<StopwatchJournalEntry> StopwatchJournal::Read()
+{
+    std::vector<StopwatchJournalEntry> entries;
+    if (!wxFileExists(mJournalFilePath)) {
+        return entries;
+    }
+
+    wxFFile file(mJournalFilePath, wxT("rb"));
+    wxString contents;
+    if (!file.IsOpened() || !file.ReadAll(&contents, wxConvUTF8)) {
+        pLogger->error("Unable to read stopwatch journal {0}", mJournalFilePath.ToStdString());
+        return entries;
+    }
+
+    wxStringTokenizer lines(contents, wxT("\n"), wxTOKEN_STRTOK);
+    while (lines.HasMoreTokens()) {
+        wxString line = lines.GetNextToken();
+        wxStringTokenizer fields(line, wxT(";"), wxTOKEN_RET_EMPTY_ALL);
+        if (fields.CountTokens() != 4) {
+            pLogger->warn("Skipping malformed stopwatch journal entry: {0}", line.ToStdString());
+            continue;
+        }
+
+        long event = 0;
+        long long timestamp = 0;
+        long long duration = 0;
+        if (!fields.GetNextToken().ToLong(&event) || !fields.GetNextToken().ToLongLong(&timestamp) ||
+            !fields.GetNextToken().ToLongLong(&duration) || event < static_cast<long>(StopwatchEvent::Start) ||
+            event > static_cast<long>(StopwatchEvent::Checkpoint)) {
+            pLogger->warn("Skipping malformed stopwatch journal entry: {0}", line.ToStdString());
+            continue;
+        }
+
+        StopwatchJournalEntry entry;
+        entry.mEvent = static_cast<StopwatchEvent>(event);
+        entry.mTimestamp = timestamp;
+        entry.mDuration = duration;
+        entry.mDescription = Unescape(fields.GetNextToken());
+        entries.push_back(entry);
+    }
+
+    return entries;
+}
+
+bool StopwatchJournal::Truncate()
+{
+    if (mFile.IsOpened()) {
+        mFile.Close();
+    }
+
+    if (wxFileExists(mJournalFilePath) && !wxRemoveFile(mJournalFilePath)) {
+        pLogger->error("Unable to remove stopwatch journal {0}", mJournalFilePath.ToStdString());
+        return false;
+    }
+
+    return true;
+}
+
+wxString StopwatchJournal::Escape(const wxString& value)
+{
+    wxString escaped;
+    escaped.reserve(value.length());
+    for (auto c : value) {
+        if (c == wxT('\\')) {
+            escaped += wxT("\\\\");
+        } else if (c == wxT('\n')) {
+            escaped += wxT("\\n");
+        } else if (c == wxT('\r')) {
+            escaped += wxT("\\r");
+        } else if (c == wxT(';')) {
+            escaped += wxT("\\s");
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+wxString StopwatchJournal::Unescape(const wxString& value)
+{
+    wxString unescaped;
+    unescaped.reserve(value.length());
+    for (auto it = value.begin(); it != value.end(); ++it) {
+        if (*it == wxT('\\') && it + 1 != value.end()) {
+            ++it;
+            if (*it == wxT('n')) {
+                unescaped += wxT('\n');
+            } else if (*it == wxT('r')) {
+                unescaped += wxT('\r');
+            } else if (*it == wxT('s')) {
+                unescaped += wxT(';');
+            } else {
+                unescaped += *it;
+            }
+        } else {
+            unescaped += *it;
+        }
+    }
+    return unescaped;
+}
+} // namespace app::services
@@ -0,0 +1,69 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <wx/file.h>
+#include <wx/string.h>
+
+#include <spdlog/spdlog.h>
+
+namespace app::services
+{
+/* Checkpoint marks a running interval as still running, it bounds the time lost to a crash */
+enum class StopwatchEvent : int { Start = 1, Pause, Stop, Reset, Describe, Checkpoint };
+
+struct StopwatchJournalEntry {
+    StopwatchEvent mEvent;
+    /* wall clock time of the event in milliseconds since the epoch */
+    std::int64_t mTimestamp;
+    /* monotonic length in milliseconds of the interval closed by a pause or stop event, or so far at a checkpoint */
+    std::int64_t mDuration;
+    wxString mDescription;
+};
+
+/*
+ Append only write-ahead journal of stopwatch events. Every entry is flushed to disk before the
+ stopwatch state changes, so the running task can be replayed after a crash or power loss.
+ A torn last line (partial write) is skipped on read
+ */
+class StopwatchJournal final
+{
+public:
+    StopwatchJournal() = delete;
+    StopwatchJournal(const wxString& journalFilePath, std::shared_ptr<spdlog::logger> logger);
+    ~StopwatchJournal();
+
+    bool Append(const StopwatchJournalEntry& entry);
+    std::vector<StopwatchJournalEntry> Read();
+    bool Truncate();
+
+private:
+    static wxString Escape(const wxString& value);
+    static wxString Unescape(const wxString& value);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+    wxString mJournalFilePath;
+    wxFile mFile;
+};
+} // namespace app::services
@@ -0,0 +1,121 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "stopwatchregistry.h"
+
+#include <algorithm>
+
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/stdpaths.h>
+
+#include "../common/common.h"
+
+namespace app::services
+{
+StopwatchRegistry::StopwatchRegistry(std::shared_ptr<spdlog::logger> logger)
+    : pLogger(logger)
+    , mStopwatches()
+    , mNextStopwatchId(1)
+{
+}
+
+/*
+ Replays every journal left behind by the last session and keeps the stopwatches that still have
+ a pending task. Returns their ids
+ */
+std::vector<int> StopwatchRegistry::Restore()
+{
+    std::vector<int> restored;
+
+    wxArrayString journalFiles;
+    wxDir::GetAllFiles(
+        wxStandardPaths::Get().GetUserDataDir(), &journalFiles, common::GetStopwatchJournalFileSpec(), wxDIR_FILES);
+
+    for (const auto& journalFile : journalFiles) {
+        long journalId = 0;
+        auto name = wxFileName(journalFile).GetName();
+        if (!name.AfterLast(wxT('-')).ToLong(&journalId) || journalId < 1) {
+            pLogger->warn("Skipping unrecognized stopwatch journal \"{0}\"", journalFile.ToStdString());
+            continue;
+        }
+
+        int stopwatchId = static_cast<int>(journalId);
+        auto stopwatch = CreateStopwatch(stopwatchId);
+        if (!stopwatch->Replay()) {
+            stopwatch->Reset();
+            continue;
+        }
+
+        mStopwatches[stopwatchId] = stopwatch;
+        mNextStopwatchId = std::max(mNextStopwatchId, stopwatchId + 1);
+        restored.push_back(stopwatchId);
+    }
+
+    std::sort(restored.begin(), restored.end());
+    return restored;
+}
+
+int StopwatchRegistry::Create()
+{
+    int stopwatchId = mNextStopwatchId++;
+    mStopwatches[stopwatchId] = CreateStopwatch(stopwatchId);
+
+    return stopwatchId;
+}
+
+std::shared_ptr<StopwatchEngine> StopwatchRegistry::Get(int stopwatchId) const
+{
+    auto it = mStopwatches.find(stopwatchId);
+    if (it == mStopwatches.end()) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+void StopwatchRegistry::Remove(int stopwatchId)
+{
+    mStopwatches.erase(stopwatchId);
+}
+
+std::vector<int> StopwatchRegistry::GetStopwatchIds() const
+{
+    std::vector<int> stopwatchIds;
+    stopwatchIds.reserve(mStopwatches.size());
+    for (const auto& [stopwatchId, stopwatch] : mStopwatches) {
+        stopwatchIds.push_back(stopwatchId);
+    }
+
+    return stopwatchIds;
+}
+
+std::size_t StopwatchRegistry::GetRunningCount() const
+{
+    return std::count_if(mStopwatches.begin(), mStopwatches.end(), [](const auto& entry) {
+        return entry.second->IsRunning();
+    });
+}
+
+std::shared_ptr<StopwatchEngine> StopwatchRegistry::CreateStopwatch(int stopwatchId)
+{
+    return std::make_shared<StopwatchEngine>(std::make_shared<TaskStateService>(),
+        std::make_unique<StopwatchJournal>(common::GetStopwatchJournalFilePath(stopwatchId), pLogger));
+}
+} // namespace app::services
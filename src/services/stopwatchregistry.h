@@ -0,0 +1,61 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "stopwatchengine.h"
+
+namespace app::services
+{
+/*
+ Owns every stopwatch the user has open. Each stopwatch has its own task state and journal so any
+ number of them can run side by side
+ */
+class StopwatchRegistry final
+{
+public:
+    StopwatchRegistry() = delete;
+    StopwatchRegistry(std::shared_ptr<spdlog::logger> logger);
+    ~StopwatchRegistry() = default;
+
+    std::vector<int> Restore();
+
+    int Create();
+    std::shared_ptr<StopwatchEngine> Get(int stopwatchId) const;
+    void Remove(int stopwatchId);
+
+    std::vector<int> GetStopwatchIds() const;
+    std::size_t GetRunningCount() const;
+
+private:
+    std::shared_ptr<StopwatchEngine> CreateStopwatch(int stopwatchId);
+
+    std::shared_ptr<spdlog::logger> pLogger;
+
+    std::map<int, std::shared_ptr<StopwatchEngine>> mStopwatches;
+
+    int mNextStopwatchId;
+};
+} // namespace app::services
@@ -19,17 +19,39 @@
 
 #include "taskstateservice.h"
 
+#include <algorithm>
+
 namespace app::services
 {
 TaskStateService::TaskStateService()
     : mTimes()
+    , mDescription(wxGetEmptyString())
+    , mAccumulatedMilliseconds(0)
+    , mLongestIntervalMilliseconds(0)
+    , mPausedMilliseconds(0)
 {
 }
 
 void TaskStateService::PushTimes(wxDateTime startTime, wxDateTime endTime)
 {
-    auto tuple = std::make_tuple(startTime, endTime);
-    mTimes.push_back(tuple);
+    std::int64_t interval = (endTime - startTime).GetMilliseconds().GetValue();
+    mAccumulatedMilliseconds += interval;
+    mLongestIntervalMilliseconds = std::max(mLongestIntervalMilliseconds, interval);
+
+    if (!mTimes.empty()) {
+        std::int64_t paused = (startTime - std::get<1>(mTimes.back())).GetMilliseconds().GetValue();
+        mPausedMilliseconds += std::max<std::int64_t>(0, paused);
+    }
+
+    mTimes.emplace_back(startTime, endTime);
+}
+
+void TaskStateService::ClearTimes()
+{
+    mTimes.clear();
+    mAccumulatedMilliseconds = 0;
+    mLongestIntervalMilliseconds = 0;
+    mPausedMilliseconds = 0;
 }
 
 void TaskStateService::StoreDescription(const wxString& description)
@@ -37,20 +59,33 @@ void TaskStateService::StoreDescription(const wxString& description)
     mDescription = description;
 }
 
-wxTimeSpan TaskStateService::GetAccumulatedTime()
+wxString TaskStateService::GetStoredDescription() const
 {
-    wxTimeSpan accumulated;
-    for (size_t i = 0; i < mTimes.size(); i++) {
-        auto [startTime, endTime] = mTimes[i];
-        auto difference = endTime - startTime;
-        accumulated += difference;
-    }
+    return mDescription;
+}
 
-    return accumulated;
+const std::vector<std::tuple<wxDateTime, wxDateTime>>& TaskStateService::GetTimes() const
+{
+    return mTimes;
 }
 
-wxString TaskStateService::GetStoredDescription() const
+std::size_t TaskStateService::GetIntervalCount() const
 {
-    return mDescription;
+    return mTimes.size();
+}
+
+wxTimeSpan TaskStateService::GetAccumulatedTime() const
+{
+    return wxTimeSpan::Milliseconds(mAccumulatedMilliseconds);
+}
+
+wxTimeSpan TaskStateService::GetLongestInterval() const
+{
+    return wxTimeSpan::Milliseconds(mLongestIntervalMilliseconds);
+}
+
+wxTimeSpan TaskStateService::GetTotalPausedTime() const
+{
+    return wxTimeSpan::Milliseconds(mPausedMilliseconds);
 }
 } // namespace app::services
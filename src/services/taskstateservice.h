@@ -19,26 +19,48 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <tuple>
 #include <vector>
 
-#include <wx/wx.h>
+#include <wx/datetime.h>
+#include <wx/string.h>
 
 namespace app::services
 {
+/*
+ Keeps the intervals of a stopwatch task. The accumulated time and the interval statistics are
+ maintained as running totals (in milliseconds) when an interval is pushed so every query is constant time
+ */
 struct TaskStateService
 {
 public:
     TaskStateService();
+    TaskStateService(const TaskStateService&) = delete;
+    TaskStateService(TaskStateService&&) = default;
     ~TaskStateService() = default;
 
+    TaskStateService& operator=(const TaskStateService&) = delete;
+    TaskStateService& operator=(TaskStateService&&) = default;
+
     void PushTimes(wxDateTime startTime, wxDateTime endTime);
+    void ClearTimes();
     void StoreDescription(const wxString& description);
-    wxTimeSpan GetAccumulatedTime();
     wxString GetStoredDescription() const;
 
+    const std::vector<std::tuple<wxDateTime, wxDateTime>>& GetTimes() const;
+    std::size_t GetIntervalCount() const;
+    wxTimeSpan GetAccumulatedTime() const;
+    wxTimeSpan GetLongestInterval() const;
+    wxTimeSpan GetTotalPausedTime() const;
+
+private:
     std::vector<std::tuple<wxDateTime, wxDateTime>> mTimes;
     wxString mDescription;
+
+    std::int64_t mAccumulatedMilliseconds;
+    std::int64_t mLongestIntervalMilliseconds;
+    std::int64_t mPausedMilliseconds;
 };
 } // namespace app::services
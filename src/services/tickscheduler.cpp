@@ -0,0 +1,159 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#include "tickscheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace app::services
+{
+/* while it cannot be seen a refresh task runs this many times less often (and does nothing) */
+static const int HiddenThrottleFactor = 15;
+
+TickScheduler::TickScheduler()
+    : mTasks()
+    , mTimer(this)
+    , mNextTaskId(1)
+{
+    Bind(wxEVT_TIMER, &TickScheduler::OnWakeup, this);
+}
+
+TickScheduler::~TickScheduler()
+{
+    mTimer.Stop();
+}
+
+int TickScheduler::Schedule(std::chrono::milliseconds interval, Callback callback, std::chrono::milliseconds leeway)
+{
+    ScheduledTask task{ Clock::now() + interval, interval, leeway, std::move(callback), VisibilityCallback(), true };
+    return Add(std::move(task));
+}
+
+int TickScheduler::ScheduleOnce(std::chrono::milliseconds delay, Callback callback, std::chrono::milliseconds leeway)
+{
+    ScheduledTask task{ Clock::now() + delay, delay, leeway, std::move(callback), VisibilityCallback(), false };
+    return Add(std::move(task));
+}
+
+/*
+ A refresh only matters while it can be seen, so it may run a quarter interval late to share a
+ wakeup with other tasks and it is skipped (and throttled) while it is not visible
+ */
+int TickScheduler::ScheduleRefresh(VisibilityCallback isVisible, std::chrono::milliseconds interval, Callback callback)
+{
+    ScheduledTask task{
+        Clock::now() + interval, interval, interval / 4, std::move(callback), std::move(isVisible), true
+    };
+    return Add(std::move(task));
+}
+
+/* Moves the next deadline of a task a full interval away from now */
+void TickScheduler::Restart(int taskId)
+{
+    auto it = mTasks.find(taskId);
+    if (it == mTasks.end()) {
+        return;
+    }
+
+    it->second.mDeadline = Clock::now() + it->second.mInterval;
+    Arm();
+}
+
+void TickScheduler::Cancel(int taskId)
+{
+    if (mTasks.erase(taskId) > 0) {
+        Arm();
+    }
+}
+
+bool TickScheduler::IsScheduled(int taskId) const
+{
+    return mTasks.find(taskId) != mTasks.end();
+}
+
+int TickScheduler::Add(ScheduledTask task)
+{
+    int taskId = mNextTaskId++;
+    mTasks.emplace(taskId, std::move(task));
+
+    Arm();
+
+    return taskId;
+}
+
+void TickScheduler::Arm()
+{
+    if (mTasks.empty()) {
+        mTimer.Stop();
+        return;
+    }
+
+    auto wakeup = Clock::time_point::max();
+    for (const auto& [taskId, task] : mTasks) {
+        wakeup = std::min(wakeup, task.mDeadline + task.mLeeway);
+    }
+
+    auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(wakeup - Clock::now()).count();
+    mTimer.StartOnce(static_cast<int>(std::max<long long>(1, delay)));
+}
+
+void TickScheduler::OnWakeup(wxTimerEvent& WXUNUSED(event))
+{
+    auto now = Clock::now();
+
+    std::vector<int> dueTaskIds;
+    for (const auto& [taskId, task] : mTasks) {
+        if (task.mDeadline <= now) {
+            dueTaskIds.push_back(taskId);
+        }
+    }
+
+    for (int taskId : dueTaskIds) {
+        /* an earlier callback may have cancelled this task */
+        auto it = mTasks.find(taskId);
+        if (it == mTasks.end()) {
+            continue;
+        }
+
+        auto& task = it->second;
+        auto callback = task.mCallback;
+        bool skip = task.mIsVisible && !task.mIsVisible();
+
+        /* reschedule before running the callback so the callback is free to cancel its own task */
+        if (!task.bRepeating) {
+            mTasks.erase(it);
+        } else if (skip) {
+            task.mDeadline = now + task.mInterval * HiddenThrottleFactor;
+        } else {
+            /* keep to the original cadence unless the deadline fell behind (e.g. after a sleep) */
+            task.mDeadline += task.mInterval;
+            if (task.mDeadline <= now) {
+                task.mDeadline = now + task.mInterval;
+            }
+        }
+
+        if (!skip) {
+            callback();
+        }
+    }
+
+    Arm();
+}
+} // namespace app::services
@@ -0,0 +1,78 @@
+// Productivity tool to help you track the time you spend on tasks
+// Copyright (C) 2020  Szymon Welgus
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+//
+//  Contact:
+//    szymonwelgus at gmail dot com
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+#include <wx/event.h>
+#include <wx/timer.h>
+
+namespace app::services
+{
+/*
+ Runs every periodic and delayed callback of the application off a single one-shot wxTimer.
+ Each task has a deadline and a leeway (how late it may run); the timer is armed for the earliest
+ deadline plus its leeway and, when it fires, every task that is due runs in the same wakeup.
+ Refresh tasks carry a visibility check (e.g. common::IsWindowVisible for their window) and are
+ throttled while it fails
+ */
+class TickScheduler final : public wxEvtHandler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+    using VisibilityCallback = std::function<bool()>;
+
+    TickScheduler();
+    virtual ~TickScheduler();
+
+    int Schedule(std::chrono::milliseconds interval,
+        Callback callback,
+        std::chrono::milliseconds leeway = std::chrono::milliseconds(0));
+    int ScheduleOnce(std::chrono::milliseconds delay,
+        Callback callback,
+        std::chrono::milliseconds leeway = std::chrono::milliseconds(0));
+    int ScheduleRefresh(VisibilityCallback isVisible, std::chrono::milliseconds interval, Callback callback);
+
+    void Restart(int taskId);
+    void Cancel(int taskId);
+    bool IsScheduled(int taskId) const;
+
+private:
+    struct ScheduledTask {
+        Clock::time_point mDeadline;
+        std::chrono::milliseconds mInterval;
+        std::chrono::milliseconds mLeeway;
+        Callback mCallback;
+        VisibilityCallback mIsVisible;
+        bool bRepeating;
+    };
+
+    int Add(ScheduledTask task);
+    void Arm();
+    void OnWakeup(wxTimerEvent& event);
+
+    std::map<int, ScheduledTask> mTasks;
+    wxTimer mTimer;
+    int mNextTaskId;
+};
+} // namespace app::services
@@ -24,12 +24,9 @@
 #include <wx/file.h>
 #include <wx/filefn.h>
 #include <wx/filename.h>
-#include <wx/regex.h>
 #include <wx/stdpaths.h>
 
-#include "../database/sqliteconnectionfactory.h"
-#include "../database/sqliteconnection.h"
-#include "../database/connectionprovider.h"
+#include "../services/backupcatalogue.h"
 
 namespace app::wizard
 {
@@ -51,7 +48,7 @@ DatabaseRestoreWizard::DatabaseRestoreWizard(frm::MainFrame* frame,
     , bRestoreWithNoPreviousFileExisting(restoreWithNoPreviousFileExisting)
 {
     pPage1 = new DatabaseRestoreWelcomePage(this);
-    auto page2 = new SelectDatabaseVersionPage(this, pConfig);
+    auto page2 = new SelectDatabaseVersionPage(this, pConfig, pLogger);
     auto page3 = new DatabaseRestoredPage(this, pConfig, pLogger);
 
     wxWizardPageSimple::Chain(pPage1, page2);
@@ -116,10 +113,12 @@ void DatabaseRestoreWelcomePage::CreateControls()
 }
 
 SelectDatabaseVersionPage::SelectDatabaseVersionPage(DatabaseRestoreWizard* parent,
-    std::shared_ptr<cfg::Configuration> config)
+    std::shared_ptr<cfg::Configuration> config,
+    std::shared_ptr<spdlog::logger> logger)
     : wxWizardPageSimple(parent)
     , pParent(parent)
     , pConfig(config)
+    , pLogger(logger)
     , pListCtrl(nullptr)
     , mSelectedIndex(-1)
 {
@@ -207,22 +206,16 @@ void SelectDatabaseVersionPage::ConfigureEventBindings()
 
 void SelectDatabaseVersionPage::FillControls()
 {
-    const wxString& backupPath = pConfig->GetBackupPath();
-    wxArrayString files;
-    wxDir::GetAllFiles(backupPath, &files, wxEmptyString, wxDIR_FILES);
+    svc::BackupCatalogue catalogue(pConfig, pLogger);
+    if (!catalogue.Load()) {
+        return;
+    }
 
     int listIndex = 0;
     int columnIndex = 0;
-    for (const auto& file : files) {
-        wxRegEx dateRegex(wxT("([0-9]{4}-[0-9]{2}-[0-9]{2})"));
-        if (dateRegex.IsValid()) {
-            if (dateRegex.Matches(file)) {
-                wxFileName filename(file);
-                auto dateComponent = dateRegex.GetMatch(file, 0);
-                listIndex = pListCtrl->InsertItem(columnIndex++, filename.GetFullName());
-                pListCtrl->SetItem(listIndex, columnIndex++, dateComponent);
-            }
-        }
+    for (const auto& entry : catalogue.GetEntries()) {
+        listIndex = pListCtrl->InsertItem(columnIndex++, entry.mFileName);
+        pListCtrl->SetItem(listIndex, columnIndex++, entry.mDate.FormatISODate());
         columnIndex = 0;
     }
 }
@@ -256,11 +249,20 @@ DatabaseRestoredPage::DatabaseRestoredPage(DatabaseRestoreWizard* parent,
     , pStatusInOperationLabel(nullptr)
     , pGaugeCtrl(nullptr)
     , pStatusCompleteLabel(nullptr)
+    , pRestore(nullptr)
+    , pRestoreThread(nullptr)
 {
     CreateControls();
     ConfigureEventBindings();
 }
 
+DatabaseRestoredPage::~DatabaseRestoredPage()
+{
+    if (pRestoreThread) {
+        pRestoreThread->Wait();
+    }
+}
+
 void DatabaseRestoredPage::CreateControls()
 {
     auto mainSizer = new wxBoxSizer(wxVERTICAL);
@@ -297,81 +299,53 @@ void DatabaseRestoredPage::ConfigureEventBindings()
         &DatabaseRestoredPage::OnWizardCancel,
         this
     );
+
+    Bind(
+        DATABASE_RESTORE_COMPLETED,
+        &DatabaseRestoredPage::OnDatabaseRestorePrepared,
+        this
+    );
 }
 // clang-format on
 
 void DatabaseRestoredPage::OnWizardPageShown(wxWizardEvent& event)
 {
-    pGaugeCtrl->Pulse();
-
-    const wxString fileToRestore = pParent->GetDatabaseFileVersionToRestore();
-
-    const wxString backupPath = pConfig->GetBackupPath();
-    const wxString dataPath = pConfig->GetDatabasePath();
-
-    auto fullBackupDatabaseFilePath = wxString::Format(wxT("%s\\%s"), backupPath, fileToRestore);
-    auto toCopyDatabaseFilePath = wxString::Format(wxT("%s\\%s"), dataPath, fileToRestore);
-
-    /* Check if the backups are in the same place as main database */
-    if (backupPath != dataPath) {
-        /* Copy selected database file to correct path */
-        bool copySuccessful = wxCopyFile(fullBackupDatabaseFilePath, toCopyDatabaseFilePath);
-        if (!copySuccessful) {
-            FileOperationErrorFeedback();
-            pLogger->error("Failed to copy {0} to destination {1}",
-                fullBackupDatabaseFilePath.ToStdString(),
-                toCopyDatabaseFilePath.ToStdString());
-            return;
-        }
+    if (pRestoreThread) {
+        return;
     }
 
-    auto existingDatabaseFile = common::GetDatabaseFilePath(pConfig->GetDatabasePath());
-
-    /* If there is a existing 'db' file */
-    if (!pParent->IsRestoreWithNoPreviousFileExisting()) {
-        /* Terminate connection to database */
-        db::ConnectionProvider::Get().PurgeConnectionPool();
-
-        /* Rename existing file temporarily (in case any of the next steps fail) */
-        bool tmpRenameOfCurrentDatabaseFileSuccessful =
-            wxRenameFile(existingDatabaseFile, wxString::Format(wxT("%s.tmp"), existingDatabaseFile));
-        if (!tmpRenameOfCurrentDatabaseFileSuccessful) {
-            FileOperationErrorFeedback();
-            pLogger->error("Failed to rename file {0} to {1}",
-                existingDatabaseFile.ToStdString(),
-                wxString::Format(wxT("%s.tmp"), existingDatabaseFile).ToStdString());
-            return;
-        }
+    pGaugeCtrl->Pulse();
+    EnableNavigation(false);
+
+    /* rebuilding and verifying the backup runs in the background, only the swap happens here */
+    pRestore = std::make_shared<svc::DatabaseRestore>(pConfig, pLogger);
+    pRestoreThread = std::make_unique<svc::DatabaseRestoreThread>(
+        this, pRestore, pParent->GetDatabaseFileVersionToRestore());
+    if (pRestoreThread->Run() != wxTHREAD_NO_ERROR) {
+        pLogger->error("Failed to start the database restore thread");
+        pRestoreThread.reset();
+        pRestore.reset();
+        FileOperationErrorFeedback(wxT("The operation encountered an error."));
     }
+}
 
-    /* Rename the selected database file to the plain name */
-    bool renameToNewNameSuccessful = wxRenameFile(toCopyDatabaseFilePath, existingDatabaseFile);
-    if (!renameToNewNameSuccessful) {
-        FileOperationErrorFeedback();
-        pLogger->error("Failed to rename file {0} to {1}",
-            toCopyDatabaseFilePath.ToStdString(),
-            existingDatabaseFile.ToStdString());
+void DatabaseRestoredPage::OnDatabaseRestorePrepared(wxThreadEvent& event)
+{
+    pRestoreThread->Wait();
+    pRestoreThread.reset();
+
+    if (event.GetInt() != 1) {
+        FileOperationErrorFeedback(pRestore->GetError());
+        pRestore.reset();
         return;
     }
 
-    /* If there is a existing 'db' file */
-    if (!pParent->IsRestoreWithNoPreviousFileExisting()) {
-        /* Remove the temporary file */
-        bool removeTmpDatabaseFile = wxRemoveFile(wxString::Format(wxT("%s.tmp"), existingDatabaseFile));
-        if (!removeTmpDatabaseFile) {
-            FileOperationErrorFeedback();
-            pLogger->error(
-                "Failed to remove file {0}", wxString::Format(wxT("%s.tmp"), existingDatabaseFile).ToStdString());
-            return;
-        }
-
-        /* Restore connection to database */
-        if (!InitializeDatabaseConnectionProvider()) {
-            FileOperationErrorFeedback();
-            pLogger->error("Failed to re-initialize database connection provider");
-            return;
-        }
+    if (!pRestore->Swap(!pParent->IsRestoreWithNoPreviousFileExisting())) {
+        FileOperationErrorFeedback(pRestore->GetError());
+        pRestore.reset();
+        return;
     }
+    pRestore.reset();
 
     /* Complete operation */
     pStatusInOperationLabel->SetLabel(wxT("Complete."));
@@ -379,10 +353,17 @@ void DatabaseRestoredPage::OnWizardPageShown(wxWizardEvent& event)
                               "\n\n\nClick 'Finish' to exit the wizard.");
     pStatusCompleteLabel->SetLabel(statusComplete);
     pGaugeCtrl->SetValue(100);
+    EnableNavigation(true);
 }
 
 void DatabaseRestoredPage::OnWizardCancel(wxWizardEvent& event)
 {
+    if (pRestoreThread) {
+        wxMessageBox(wxT("Please wait for the restore to finish."), common::GetProgramName(), wxICON_INFORMATION);
+        event.Veto();
+        return;
+    }
+
     auto userResponse = wxMessageBox(
         wxT("Are you sure want to cancel and exit?"), common::GetProgramName(), wxICON_QUESTION | wxYES_NO);
     if (userResponse == wxNO) {
@@ -390,23 +371,27 @@ void DatabaseRestoredPage::OnWizardCancel(wxWizardEvent& event)
     }
 }
 
-void DatabaseRestoredPage::FileOperationErrorFeedback()
+void DatabaseRestoredPage::FileOperationErrorFeedback(const wxString& error)
 {
-    pStatusInOperationLabel->SetLabel(wxT("The operation encountered an error."));
+    pStatusInOperationLabel->SetLabel(error);
     auto statusError = wxT("The wizard has encountered an error.\n"
                            "Any operations executed have been rolled back."
                            "\n\n\nClick 'Finish' to exit the wizard.");
     pStatusCompleteLabel->SetLabel(statusError);
     pGaugeCtrl->SetValue(100);
+    EnableNavigation(true);
 }
 
-bool DatabaseRestoredPage::InitializeDatabaseConnectionProvider()
+void DatabaseRestoredPage::EnableNavigation(bool enable)
 {
-    auto sqliteConnectionFactory = std::make_shared<db::SqliteConnectionFactory>(
-        common::GetDatabaseFilePath(pConfig->GetDatabasePath()).ToStdString());
-    auto connectionPool = std::make_unique<db::ConnectionPool<db::SqliteConnection>>(sqliteConnectionFactory, 14);
-    db::ConnectionProvider::Get().ReInitializeConnectionPool(std::move(connectionPool));
+    auto forwardButton = pParent->FindWindow(wxID_FORWARD);
+    if (forwardButton) {
+        forwardButton->Enable(enable);
+    }
 
-    return true;
+    auto backwardButton = pParent->FindWindow(wxID_BACKWARD);
+    if (backwardButton) {
+        backwardButton->Enable(enable);
+    }
 }
 } // namespace app::wizard
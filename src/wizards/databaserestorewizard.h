@@ -32,6 +32,7 @@
 #include "../common/common.h"
 #include "../config/configuration.h"
 #include "../frame/mainframe.h"
+#include "../services/databaserestore.h"
 #include "../../res/database-restore-wizard.xpm"
 
 namespace app::wizard
@@ -81,7 +82,9 @@ class SelectDatabaseVersionPage final : public wxWizardPageSimple
 {
 public:
     SelectDatabaseVersionPage() = delete;
-    SelectDatabaseVersionPage(DatabaseRestoreWizard* parent, std::shared_ptr<cfg::Configuration> config);
+    SelectDatabaseVersionPage(DatabaseRestoreWizard* parent,
+        std::shared_ptr<cfg::Configuration> config,
+        std::shared_ptr<spdlog::logger> logger);
     virtual ~SelectDatabaseVersionPage() = default;
 
     bool TransferDataFromWindow() override;
@@ -97,6 +100,7 @@ class SelectDatabaseVersionPage final : public wxWizardPageSimple
 
     DatabaseRestoreWizard* pParent;
     std::shared_ptr<cfg::Configuration> pConfig;
+    std::shared_ptr<spdlog::logger> pLogger;
     wxListCtrl* pListCtrl;
 
     int mSelectedIndex;
@@ -109,7 +113,7 @@ class DatabaseRestoredPage final : public wxWizardPageSimple
     DatabaseRestoredPage(DatabaseRestoreWizard* parent,
         std::shared_ptr<cfg::Configuration> config,
         std::shared_ptr<spdlog::logger> logger);
-    virtual ~DatabaseRestoredPage() = default;
+    virtual ~DatabaseRestoredPage();
 
 private:
     void CreateControls();
@@ -117,10 +121,10 @@ class DatabaseRestoredPage final : public wxWizardPageSimple
 
     void OnWizardPageShown(wxWizardEvent& event);
     void OnWizardCancel(wxWizardEvent& event);
+    void OnDatabaseRestorePrepared(wxThreadEvent& event);
 
-    void FileOperationErrorFeedback();
-
-    bool InitializeDatabaseConnectionProvider();
+    void FileOperationErrorFeedback(const wxString& error);
+    void EnableNavigation(bool enable);
 
     DatabaseRestoreWizard* pParent;
     std::shared_ptr<cfg::Configuration> pConfig;
@@ -129,5 +133,8 @@ class DatabaseRestoredPage final : public wxWizardPageSimple
     wxStaticText* pStatusInOperationLabel;
     wxGauge* pGaugeCtrl;
     wxStaticText* pStatusCompleteLabel;
+
+    std::shared_ptr<svc::DatabaseRestore> pRestore;
+    std::unique_ptr<svc::DatabaseRestoreThread> pRestoreThread;
 };
 } // namespace app::wizard